@@ -0,0 +1,162 @@
+// Audio path from OBS's callback to the wire: downmix, silence check,
+// resampling, chunking and protobuf serialisation of the chunk.
+
+#include "audio_pipeline.h"
+#include "bench_support.h"
+#include "harness/allocation_counter.h"
+#include "server_gRPC/sayo.pb.h"
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr double INPUT_RATE = 48000.0;
+constexpr double TARGET_RATE = 16000.0;
+constexpr size_t CHUNK_BYTES = (16000 / 1000 * 96) * sizeof(float); // as the plugin sends
+
+// Planar float input, a different tone per channel
+struct Planes {
+	Planes(const size_t channels, const size_t frames) : samples(channels, std::vector<float>(frames))
+	{
+		for (size_t c = 0; c < channels; ++c) {
+			for (size_t i = 0; i < frames; ++i)
+				samples[c][i] = 0.25f * static_cast<float>(std::sin(0.01 * static_cast<double>((c + 1) * i)));
+			pointers.push_back(samples[c].data());
+		}
+	}
+
+	std::vector<std::vector<float>> samples;
+	std::vector<const float *> pointers;
+};
+
+void BM_Downmix(benchmark::State &state)
+{
+	const auto frames = static_cast<size_t>(state.range(0));
+	const auto channels = static_cast<size_t>(state.range(1));
+	const Planes input(channels, frames);
+	std::vector<float> mono;
+	for (auto _ : state) {
+		audio_pipeline::downmix(input.pointers.data(), channels, frames, mono);
+		benchmark::DoNotOptimize(mono.data());
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(frames));
+	state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(frames * channels * sizeof(float)));
+}
+BENCHMARK(BM_Downmix)->ArgNames({"frames", "channels"})->ArgsProduct({{480, 1024, 1200, 4800}, {1, 2, 6}});
+
+void BM_IsEmptyChunk(benchmark::State &state)
+{
+	const auto frames = static_cast<size_t>(state.range(0));
+	// Silence is the worst case: every sample has to be looked at
+	std::vector<float> buffer(frames, 0.0f);
+	if (state.range(1) == 0)
+		buffer.back() = 1e-6f;
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(buffer.data());
+		benchmark::DoNotOptimize(audio_pipeline::is_empty_chunk(buffer.data(), frames));
+	}
+	state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(frames * sizeof(float)));
+}
+BENCHMARK(BM_IsEmptyChunk)->ArgNames({"frames", "silent"})->ArgsProduct({{480, 1024, 4800}, {0, 1}});
+
+void BM_Resample(benchmark::State &state)
+{
+	const auto frames = static_cast<size_t>(state.range(0));
+	const double ratio = TARGET_RATE / static_cast<double>(state.range(1));
+	const Planes input(1, frames);
+	int error = 0;
+	SRC_STATE *resampler = src_new(SRC_SINC_FASTEST, 1, &error);
+	if (!resampler) {
+		state.SkipWithError(src_strerror(error));
+		return;
+	}
+	std::vector<float> out;
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(
+			audio_pipeline::resample_audio(resampler, ratio, input.pointers[0], frames, out, error));
+		benchmark::ClobberMemory();
+	}
+	src_delete(resampler);
+	state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(frames));
+}
+BENCHMARK(BM_Resample)->ArgNames({"frames", "input_rate"})->ArgsProduct({{480, 1024, 1200, 4800}, {44100, 48000}});
+
+void BM_CutChunks(benchmark::State &state)
+{
+	// frames of 16 kHz output per callback
+	const auto frames = static_cast<size_t>(state.range(0));
+	const std::vector<float> samples(frames, 0.5f);
+	const auto *data = reinterpret_cast<const char *>(samples.data());
+	std::vector<char> pending;
+	pending.reserve(CHUNK_BYTES + frames * sizeof(float));
+	int64_t chunks = 0;
+	for (auto _ : state) {
+		audio_pipeline::cut_chunks(pending, data, frames * sizeof(float), CHUNK_BYTES,
+					   [&](const std::vector<char> &chunk) {
+						   benchmark::DoNotOptimize(chunk.data());
+						   ++chunks;
+					   });
+	}
+	state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(frames * sizeof(float)));
+	state.counters["chunks"] = benchmark::Counter(static_cast<double>(chunks), benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_CutChunks)->ArgName("frames")->Arg(160)->Arg(400)->Arg(1600);
+
+// Everything audio_callback does short of sending
+void BM_AudioPath(benchmark::State &state)
+{
+	const auto frames = static_cast<size_t>(state.range(0));
+	const auto channels = static_cast<size_t>(state.range(1));
+	const Planes input(channels, frames);
+	int error = 0;
+	SRC_STATE *resampler = src_new(SRC_SINC_FASTEST, 1, &error);
+	if (!resampler) {
+		state.SkipWithError(src_strerror(error));
+		return;
+	}
+	std::vector<float> mono;
+	std::vector<float> resampled;
+	std::vector<char> pending;
+	int64_t chunks = 0;
+	const uint64_t allocations_before = allocation_counter::total();
+	for (auto _ : state) {
+		if (audio_pipeline::is_empty_chunk(input.pointers[0], frames))
+			continue;
+		audio_pipeline::downmix(input.pointers.data(), channels, frames, mono);
+		const size_t out_frames = audio_pipeline::resample_audio(resampler, TARGET_RATE / INPUT_RATE, mono.data(),
+									 frames, resampled, error);
+		audio_pipeline::cut_chunks(pending, reinterpret_cast<const char *>(resampled.data()),
+					   out_frames * sizeof(float), CHUNK_BYTES,
+					   [&](const std::vector<char> &chunk) {
+						   benchmark::DoNotOptimize(chunk.data());
+						   ++chunks;
+					   });
+	}
+	const uint64_t allocations = allocation_counter::total() - allocations_before;
+	src_delete(resampler);
+	state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(frames));
+	state.counters["chunks"] = benchmark::Counter(static_cast<double>(chunks), benchmark::Counter::kIsRate);
+	state.counters["allocs_per_callback"] =
+		benchmark::Counter(static_cast<double>(allocations), benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_AudioPath)->ArgNames({"frames", "channels"})->ArgsProduct({{480, 1024, 4800}, {1, 2, 6}});
+
+void BM_SerializeAudioChunk(benchmark::State &state)
+{
+	const auto samples = static_cast<size_t>(state.range(0));
+	const std::vector<float> pcm(samples, 0.5f);
+	sayo::AudioChunk chunk;
+	std::string wire;
+	for (auto _ : state) {
+		chunk.set_pcm(reinterpret_cast<const char *>(pcm.data()), samples * sizeof(float));
+		chunk.SerializeToString(&wire);
+		benchmark::DoNotOptimize(wire.data());
+	}
+	state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(samples * sizeof(float)));
+}
+BENCHMARK(BM_SerializeAudioChunk)->ArgName("samples")->Arg(512)->Arg(1536)->Arg(4096)->Arg(16000);
+
+} // namespace
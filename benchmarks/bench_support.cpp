@@ -0,0 +1,65 @@
+#include "bench_support.h"
+#include <plugin-support.h>
+
+extern "C" {
+const char *PLUGIN_NAME = "sayo-benchmarks";
+const char *PLUGIN_VERSION = "";
+
+void obs_log(int, const char *, ...) {}
+}
+
+namespace {
+
+uint32_t next(uint32_t &state)
+{
+	// xorshift32
+	state ^= state << 13;
+	state ^= state >> 17;
+	state ^= state << 5;
+	return state;
+}
+
+const char *const LATIN[] = {"ka", "lo", "ren", "ti", "sa", "mon", "e", "stra", "vi", "da", "ne", "pro", "ght", "ing", "or"};
+const char *const CYRILLIC[] = {"ка", "ло", "ре", "ти", "ст", "мо", "ва", "ни", "пр", "ё", "ую", "ш", "ры"};
+
+} // namespace
+
+namespace bench {
+
+std::vector<std::string> words(const size_t count, uint32_t seed)
+{
+	std::vector<std::string> result;
+	result.reserve(count);
+	uint32_t state = seed * 2654435761u + 1;
+	for (size_t i = 0; i < count; ++i) {
+		const uint32_t kind = next(state) % 10;
+		std::string word;
+		if (kind == 0) {
+			word = std::to_string(next(state) % 2000);
+		} else {
+			const bool cyrillic = kind <= 2;
+			const size_t syllables = 1 + next(state) % 4;
+			for (size_t s = 0; s < syllables; ++s) {
+				word += cyrillic ? CYRILLIC[next(state) % (sizeof(CYRILLIC) / sizeof(*CYRILLIC))]
+						 : LATIN[next(state) % (sizeof(LATIN) / sizeof(*LATIN))];
+			}
+		}
+		result.push_back(std::move(word));
+	}
+	return result;
+}
+
+std::string mixed_script_text(const size_t size)
+{
+	static const char *const pieces[] = {
+		"Hello, world! ", "Привет, мир. ", "東京タワーは高い。", "don't-stop ", "1,234.56 ",
+		"😀 ", "(quoted) ", "«кавычки» ", "naïve café ", "中文字幕测试，", "— dash ", "\xE2\x80\x8B",
+	};
+	std::string text;
+	uint32_t state = 12345;
+	while (text.size() < size)
+		text += pieces[next(state) % (sizeof(pieces) / sizeof(*pieces))];
+	return text;
+}
+
+} // namespace bench
@@ -0,0 +1,20 @@
+#ifndef BENCH_SUPPORT_H
+#define BENCH_SUPPORT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace bench {
+
+// Deterministic pseudo-random words of roughly the shape ASR results have:
+// mostly Latin, some Cyrillic, the odd number. The same seed gives the same words.
+std::vector<std::string> words(size_t count, uint32_t seed = 1);
+
+// Caption text mixing Latin, Cyrillic, CJK, emoji and punctuation, about size bytes.
+std::string mixed_script_text(size_t size);
+
+} // namespace bench
+
+#endif
@@ -0,0 +1,280 @@
+// End-to-end caption latency: plays a WAV file (or synthetic speech) at real
+// time into the plugin's audio_callback, through a libobs stub, to a scripted
+// mock Sayo server on loopback, and times every result until its text reaches
+// update_internal_text. Each result is followed through the pipeline:
+//
+//   fill     the chunk before captured to this chunk captured, in the audio
+//            callback that completed each: the chunk's audio arriving
+//   send     chunk captured to the server reading it
+//   server   server read to result written (the scripted processing delay)
+//   return   result written to the "transcript_result" signal
+//   display  signal to the text source update that shows it (next video tick)
+//   total    the chunk before captured to the update that shows this one
+//
+// Samples are weighted by the words in each result, so percentiles are per word.
+// Apart from those, a keyword trigger on a word of the script presses a stub
+// hotkey, and every result holding that word is timed from its signal to the
+// press: the trigger waits for the next video tick to be queued, and the
+// stub runs the queued task at once, where OBS would hand it to the UI thread.
+//
+//   sayo-e2e-latency [--wav file.wav] [--seconds N] [--script lines.txt]
+//                    [--processing-ms N] [--fps N] [--trigger word]
+//                    [--csv out.csv] [--verbose]
+
+#include "harness/audio_input.h"
+#include "harness/latency_histogram.h"
+#include "harness/latency_tracker.h"
+#include "harness/mock_sayo.h"
+#include "harness/obs_stub.h"
+#include "harness/plugin_harness.h"
+#include <obs-module.h>
+#include <plugin-support.h>
+#include <util/platform.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+bool verbose = false;
+
+} // namespace
+
+extern "C" {
+const char *PLUGIN_NAME = "sayo-e2e-latency";
+const char *PLUGIN_VERSION = "";
+
+void obs_log(int log_level, const char *format, ...)
+{
+	if (!verbose && log_level > LOG_WARNING)
+		return;
+	va_list args;
+	va_start(args, format);
+	vfprintf(stderr, format, args);
+	va_end(args);
+	fputc('\n', stderr);
+}
+}
+
+namespace {
+
+constexpr uint32_t BLOCK_FRAMES = 1024; // AUDIO_OUTPUT_FRAMES
+constexpr char AUDIO_SOURCE[] = "Harness Audio";
+constexpr char TRIGGER_HOTKEY[] = "Harness Trigger";
+
+const std::vector<std::string> DEFAULT_SCRIPT = {
+	"the", "quick", "brown fox", "", "jumps", "over the", "", "lazy dog", "", "",
+};
+
+bool read_script(const std::string &path, std::vector<std::string> &script)
+{
+	std::ifstream file(path);
+	if (!file)
+		return false;
+	script.clear();
+	for (std::string line; std::getline(file, line);)
+		script.push_back(line);
+	return true;
+}
+
+// Results holding the trigger word, from their "transcript_result" to the hotkey press
+struct TriggerTimes {
+	std::string word;
+	std::mutex mutex;
+	std::deque<uint64_t> results;
+	LatencyHistogram latency;
+	size_t unmatched = 0; // presses with no result to time them from
+
+	static void signalled(void *data, calldata_t *cd)
+	{
+		const uint64_t now = os_gettime_ns();
+		auto *times = static_cast<TriggerTimes *>(data);
+		const char *text = calldata_string(cd, "text");
+		if (!text || !strstr(text, times->word.c_str()))
+			return;
+		std::lock_guard<std::mutex> lock(times->mutex);
+		times->results.push_back(now);
+	}
+
+	void pressed()
+	{
+		const uint64_t now = os_gettime_ns();
+		std::lock_guard<std::mutex> lock(mutex);
+		if (results.empty()) {
+			++unmatched;
+			return;
+		}
+		latency.add(now - results.front());
+		results.pop_front();
+	}
+};
+
+int usage()
+{
+	fprintf(stderr, "usage: sayo-e2e-latency [--wav file.wav] [--seconds N] [--script lines.txt]\n"
+			"                        [--processing-ms N] [--fps N] [--trigger word]\n"
+			"                        [--csv out.csv] [--verbose]\n");
+	return 2;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+	std::string wav_path;
+	double seconds = 60.0;
+	std::vector<std::string> script = DEFAULT_SCRIPT;
+	int processing_ms = 0;
+	int fps = 60;
+	const char *csv_path = nullptr;
+	TriggerTimes trigger;
+	trigger.word = "fox";
+	for (int i = 1; i < argc; ++i) {
+		if (!strcmp(argv[i], "--wav") && i + 1 < argc) {
+			wav_path = argv[++i];
+		} else if (!strcmp(argv[i], "--seconds") && i + 1 < argc) {
+			seconds = std::stod(argv[++i]);
+		} else if (!strcmp(argv[i], "--script") && i + 1 < argc) {
+			if (!read_script(argv[++i], script)) {
+				fprintf(stderr, "cannot read script %s\n", argv[i]);
+				return 1;
+			}
+		} else if (!strcmp(argv[i], "--processing-ms") && i + 1 < argc) {
+			processing_ms = std::stoi(argv[++i]);
+		} else if (!strcmp(argv[i], "--fps") && i + 1 < argc) {
+			fps = std::max(1, std::stoi(argv[++i]));
+		} else if (!strcmp(argv[i], "--trigger") && i + 1 < argc) {
+			trigger.word = argv[++i];
+		} else if (!strcmp(argv[i], "--csv") && i + 1 < argc) {
+			csv_path = argv[++i];
+		} else if (!strcmp(argv[i], "--verbose")) {
+			verbose = true;
+		} else {
+			return usage();
+		}
+	}
+
+	AudioClip clip;
+	if (!wav_path.empty()) {
+		std::string error;
+		if (!read_wav(wav_path, clip, error)) {
+			fprintf(stderr, "%s\n", error.c_str());
+			return 1;
+		}
+		seconds = clip.seconds();
+	} else {
+		clip = synthetic_speech(seconds, 48000);
+	}
+
+	FILE *csv = csv_path ? fopen(csv_path, "w") : nullptr;
+	if (csv)
+		fprintf(csv, "stream,chunk,words,fill_ms,send_ms,server_ms,return_ms,display_ms,total_ms\n");
+	std::mutex histograms_mutex;
+	LatencyHistogram fill, send, processing, back, display, total;
+	size_t results = 0;
+	LatencyTracker tracker([&](const LatencyTracker::Sample &sample) {
+		const uint64_t words = std::max<uint32_t>(1, sample.words);
+		std::lock_guard<std::mutex> lock(histograms_mutex);
+		++results;
+		fill.add(sample.fill_ns, words);
+		send.add(sample.send_ns, words);
+		processing.add(sample.server_ns, words);
+		back.add(sample.return_ns, words);
+		display.add(sample.display_ns, words);
+		total.add(sample.total_ns, words);
+		if (csv)
+			fprintf(csv, "%u,%u,%llu,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f\n", sample.stream, sample.chunk,
+				static_cast<unsigned long long>(words), sample.fill_ns / 1e6, sample.send_ns / 1e6,
+				sample.server_ns / 1e6, sample.return_ns / 1e6, sample.display_ns / 1e6,
+				sample.total_ns / 1e6);
+	});
+
+	std::atomic<size_t> chunks{0};
+	mock_sayo::Service service(script, std::chrono::milliseconds(processing_ms),
+				   [&](const mock_sayo::ChunkTiming &timing) {
+					   ++chunks;
+					   tracker.chunk(timing);
+				   });
+	int port = 0;
+	const std::unique_ptr<grpc::Server> server = service.listen(port);
+	if (!server) {
+		fprintf(stderr, "cannot start the mock server\n");
+		return 1;
+	}
+
+	plugin_harness::load((std::filesystem::temp_directory_path() / "sayo-e2e-latency").string(), clip.sample_rate);
+	plugin_harness::track(tracker);
+	obs_source_t *audio = obs_stub::create_audio_source(AUDIO_SOURCE);
+	obs_source_t *asr = plugin_harness::create_source("ASR", AUDIO_SOURCE, port);
+	obs_stub::add_hotkey(TRIGGER_HOTKEY, [&trigger](const bool pressed) {
+		if (pressed)
+			trigger.pressed();
+	});
+	signal_handler_connect(obs_source_get_signal_handler(asr), "transcript_result", TriggerTimes::signalled,
+			       &trigger);
+	obs_data_t *settings = obs_source_get_settings(asr);
+	obs_data_set_string(settings, "keyword_triggers", (trigger.word + " => hotkey: " + TRIGGER_HOTKEY).c_str());
+	obs_source_update(asr, settings);
+	obs_data_release(settings);
+
+	auto video = std::make_unique<plugin_harness::VideoThread>(fps);
+	video->add(asr);
+	obs_stub::click(asr, "connect_button");
+	const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(20);
+	while (service.streamsOpened() == 0 && std::chrono::steady_clock::now() < deadline)
+		std::this_thread::sleep_for(std::chrono::milliseconds(10));
+	if (service.streamsOpened() == 0) {
+		fprintf(stderr, "the plugin did not connect to the mock server on port %d\n", port);
+		video.reset();
+		obs_source_release(asr);
+		obs_source_release(audio);
+		return 1;
+	}
+
+	fprintf(stderr, "playing %.1f s of %s at %u Hz\n", seconds, wav_path.empty() ? "synthetic speech" : wav_path.c_str(),
+		clip.sample_rate);
+	const auto blocks = static_cast<uint64_t>(clip.frames() / BLOCK_FRAMES);
+	play(clip, BLOCK_FRAMES, 1.0, [&](const audio_data &block, const uint64_t n) {
+		if (n >= blocks)
+			return false;
+		obs_stub::push_audio(audio, block);
+		return true;
+	});
+
+	// Let the last results reach the screen
+	const auto drain_deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+	while (tracker.pending() > 0 && std::chrono::steady_clock::now() < drain_deadline)
+		std::this_thread::sleep_for(std::chrono::milliseconds(20));
+	const size_t lost = tracker.pending();
+
+	video.reset();
+	obs_source_release(asr);
+	server->Shutdown();
+	obs_source_release(audio);
+	plugin_harness::unload();
+	if (csv)
+		fclose(csv);
+
+	printf("%zu chunks read by the server, %zu results timed, %zu never shown\n\n", chunks.load(), results, lost);
+	fill.print(stdout, "fill");
+	send.print(stdout, "send");
+	processing.print(stdout, "server");
+	back.print(stdout, "return");
+	display.print(stdout, "display");
+	total.print(stdout, "total");
+	printf("\nkeyword trigger \"%s\", result signal to hotkey press, %zu presses without a result\n",
+	       trigger.word.c_str(), trigger.unmatched);
+	trigger.latency.print(stdout, "trigger");
+	return results > 0 ? 0 : 1;
+}
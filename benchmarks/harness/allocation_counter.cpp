@@ -0,0 +1,96 @@
+#include "allocation_counter.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+std::atomic<uint64_t> allocated{0};
+std::atomic<uint64_t> freed{0};
+
+void *allocate(const std::size_t size)
+{
+	if (void *p = std::malloc(size ? size : 1)) {
+		allocated.fetch_add(1, std::memory_order_relaxed);
+		return p;
+	}
+	return nullptr;
+}
+
+void release(void *p)
+{
+	if (!p)
+		return;
+	freed.fetch_add(1, std::memory_order_relaxed);
+	std::free(p);
+}
+
+} // namespace
+
+void *operator new(const std::size_t size)
+{
+	if (void *p = allocate(size))
+		return p;
+	throw std::bad_alloc();
+}
+
+void *operator new[](const std::size_t size)
+{
+	return operator new(size);
+}
+
+void *operator new(const std::size_t size, const std::nothrow_t &) noexcept
+{
+	return allocate(size);
+}
+
+void *operator new[](const std::size_t size, const std::nothrow_t &) noexcept
+{
+	return allocate(size);
+}
+
+void operator delete(void *p) noexcept
+{
+	release(p);
+}
+
+void operator delete[](void *p) noexcept
+{
+	release(p);
+}
+
+void operator delete(void *p, std::size_t) noexcept
+{
+	release(p);
+}
+
+void operator delete[](void *p, std::size_t) noexcept
+{
+	release(p);
+}
+
+void operator delete(void *p, const std::nothrow_t &) noexcept
+{
+	release(p);
+}
+
+void operator delete[](void *p, const std::nothrow_t &) noexcept
+{
+	release(p);
+}
+
+namespace allocation_counter {
+
+uint64_t total()
+{
+	return allocated.load(std::memory_order_relaxed);
+}
+
+uint64_t live()
+{
+	const uint64_t released = freed.load(std::memory_order_relaxed);
+	const uint64_t allocations = total();
+	return allocations > released ? allocations - released : 0;
+}
+
+} // namespace allocation_counter
@@ -0,0 +1,16 @@
+#ifndef ALLOCATION_COUNTER_H
+#define ALLOCATION_COUNTER_H
+
+#include <cstdint>
+
+// Counts operator new and delete across the process. Linking a call to
+// either function below replaces the global operators, so only the tools that
+// use it pay for the counting. malloc from C libraries is not seen.
+namespace allocation_counter {
+
+uint64_t total(); // allocations since the process started
+uint64_t live();  // allocations not yet freed
+
+} // namespace allocation_counter
+
+#endif
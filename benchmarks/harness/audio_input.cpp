@@ -0,0 +1,167 @@
+#include "audio_input.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <thread>
+
+namespace {
+
+uint32_t read_le(const uint8_t *in, const int bytes)
+{
+	uint32_t value = 0;
+	for (int i = bytes - 1; i >= 0; --i)
+		value = value << 8 | in[i];
+	return value;
+}
+
+float sample_at(const uint8_t *in, const uint16_t format, const uint16_t bits)
+{
+	if (format == 3) {
+		const uint32_t bits32 = read_le(in, 4);
+		float value;
+		std::memcpy(&value, &bits32, sizeof(value));
+		return value;
+	}
+	switch (bits) {
+	case 16:
+		return static_cast<float>(static_cast<int16_t>(read_le(in, 2))) / 32768.0f;
+	case 24:
+		return static_cast<float>(static_cast<int32_t>(read_le(in, 3) << 8) >> 8) / 8388608.0f;
+	default:
+		return static_cast<float>(static_cast<double>(static_cast<int32_t>(read_le(in, 4))) / 2147483648.0);
+	}
+}
+
+} // namespace
+
+bool read_wav(const std::string &path, AudioClip &clip, std::string &error)
+{
+	std::ifstream file(path, std::ios::binary);
+	if (!file) {
+		error = "cannot open " + path;
+		return false;
+	}
+	const std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+	if (bytes.size() < 12 || std::memcmp(bytes.data(), "RIFF", 4) != 0 || std::memcmp(bytes.data() + 8, "WAVE", 4) != 0) {
+		error = path + " is not a WAV file";
+		return false;
+	}
+
+	uint16_t format = 0, channels = 0, bits = 0;
+	uint32_t sample_rate = 0;
+	const uint8_t *data = nullptr;
+	size_t data_size = 0;
+	for (size_t pos = 12; pos + 8 <= bytes.size();) {
+		const uint8_t *chunk = bytes.data() + pos;
+		const size_t size = std::min<size_t>(read_le(chunk + 4, 4), bytes.size() - pos - 8);
+		if (std::memcmp(chunk, "fmt ", 4) == 0 && size >= 16) {
+			format = static_cast<uint16_t>(read_le(chunk + 8, 2));
+			channels = static_cast<uint16_t>(read_le(chunk + 10, 2));
+			sample_rate = read_le(chunk + 12, 4);
+			bits = static_cast<uint16_t>(read_le(chunk + 22, 2));
+			// WAVE_FORMAT_EXTENSIBLE: the real format leads the sub-format GUID
+			if (format == 0xFFFE && size >= 26)
+				format = static_cast<uint16_t>(read_le(chunk + 32, 2));
+		} else if (std::memcmp(chunk, "data", 4) == 0) {
+			data = chunk + 8;
+			data_size = size;
+		}
+		pos += 8 + size + (size & 1);
+	}
+
+	const bool supported = (format == 1 && (bits == 16 || bits == 24 || bits == 32)) || (format == 3 && bits == 32);
+	if (!supported || channels == 0 || sample_rate == 0 || !data) {
+		error = path + ": only 16/24/32-bit PCM and 32-bit float WAV are supported";
+		return false;
+	}
+
+	const size_t frame_bytes = static_cast<size_t>(channels) * (bits / 8);
+	const size_t frames = data_size / frame_bytes;
+	const size_t kept = std::min<size_t>(channels, 2);
+	clip.sample_rate = sample_rate;
+	clip.planes.assign(kept, std::vector<float>(frames));
+	for (size_t i = 0; i < frames; ++i) {
+		for (size_t c = 0; c < kept; ++c)
+			clip.planes[c][i] = sample_at(data + i * frame_bytes + c * (bits / 8), format, bits);
+	}
+	return true;
+}
+
+AudioClip synthetic_speech(const double seconds, const uint32_t sample_rate, const uint32_t seed)
+{
+	constexpr double PI = 3.14159265358979323846;
+	constexpr int HARMONICS = 10;
+
+	AudioClip clip;
+	clip.sample_rate = sample_rate;
+	const auto frames = static_cast<size_t>(seconds * sample_rate);
+	clip.planes.assign(2, std::vector<float>(frames));
+
+	std::mt19937 random(seed);
+	std::uniform_real_distribution<double> uniform(0.0, 1.0);
+	size_t i = 0;
+	double phase = 0.0;
+	while (i < frames) {
+		const int syllables = 6 + static_cast<int>(uniform(random) * 9);
+		for (int s = 0; s < syllables && i < frames; ++s) {
+			const auto length = static_cast<size_t>((0.15 + 0.15 * uniform(random)) * sample_rate);
+			const double pitch = 100.0 + 120.0 * uniform(random);
+			const double glide = (uniform(random) - 0.5) * 40.0;
+			const double loudness = 0.2 + 0.2 * uniform(random);
+			for (size_t n = 0; n < length && i < frames; ++n, ++i) {
+				const double t = static_cast<double>(n) / static_cast<double>(length);
+				phase += 2.0 * PI * (pitch + glide * t) / sample_rate;
+				double voiced = 0.0;
+				for (int h = 1; h <= HARMONICS; ++h)
+					voiced += std::sin(h * phase) / h;
+				const double envelope = std::sin(PI * t) * std::sin(PI * t);
+				const double noise = (uniform(random) - 0.5) * 2e-4;
+				clip.planes[0][i] = static_cast<float>(loudness * envelope * voiced * 0.5 + noise);
+				clip.planes[1][i] = clip.planes[0][i] * 0.9f;
+			}
+			// Gap between syllables, then a longer pause after the phrase
+			const double gap = s + 1 < syllables ? 0.04 : 0.3 + 0.5 * uniform(random);
+			for (auto n = static_cast<size_t>(gap * sample_rate); n > 0 && i < frames; --n, ++i) {
+				clip.planes[0][i] = static_cast<float>((uniform(random) - 0.5) * 2e-4);
+				clip.planes[1][i] = clip.planes[0][i];
+			}
+		}
+	}
+	return clip;
+}
+
+void play(const AudioClip &clip, const uint32_t block_frames, const double speed,
+	  const std::function<bool(const audio_data &block, uint64_t n)> &deliver)
+{
+	using Clock = std::chrono::steady_clock;
+	const size_t frames = clip.frames();
+	if (frames == 0 || block_frames == 0)
+		return;
+
+	std::vector<std::vector<float>> block(clip.planes.size(), std::vector<float>(block_frames));
+	audio_data data{};
+	for (size_t c = 0; c < block.size(); ++c)
+		data.data[c] = reinterpret_cast<uint8_t *>(block[c].data());
+	data.frames = block_frames;
+
+	const std::chrono::duration<double> block_time(static_cast<double>(block_frames) / clip.sample_rate);
+	const Clock::time_point start = Clock::now();
+	size_t pos = 0;
+	for (uint64_t n = 0;; ++n) {
+		for (size_t c = 0; c < block.size(); ++c) {
+			for (uint32_t i = 0; i < block_frames; ++i)
+				block[c][i] = clip.planes[c][(pos + i) % frames];
+		}
+		pos = (pos + block_frames) % frames;
+		if (speed > 0.0)
+			std::this_thread::sleep_until(start + std::chrono::duration_cast<Clock::duration>(block_time * (n / speed)));
+		data.timestamp = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+								 block_time * static_cast<double>(n)).count());
+		if (!deliver(data, n))
+			return;
+	}
+}
@@ -0,0 +1,33 @@
+#ifndef AUDIO_INPUT_H
+#define AUDIO_INPUT_H
+
+#include <obs-module.h>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+// Planar float audio for the harness to play into capture callbacks.
+struct AudioClip {
+	uint32_t sample_rate = 48000;
+	std::vector<std::vector<float>> planes; // one or two
+
+	[[nodiscard]] size_t frames() const { return planes.empty() ? 0 : planes[0].size(); }
+	[[nodiscard]] double seconds() const { return static_cast<double>(frames()) / sample_rate; }
+};
+
+// 16-, 24- or 32-bit PCM or 32-bit float WAV. Channels past the second are dropped.
+bool read_wav(const std::string &path, AudioClip &clip, std::string &error);
+
+// Stereo test signal shaped like speech: voiced syllables at about four a
+// second, grouped into phrases with short pauses, over a low noise floor so
+// no block is digital silence. The same seed gives the same signal.
+AudioClip synthetic_speech(double seconds, uint32_t sample_rate, uint32_t seed = 1);
+
+// Delivers the clip in blocks of block_frames, looping it, as OBS's audio
+// thread would: block n is due n blocks after the start, divided by speed
+// (0 = as fast as possible). Stops when deliver returns false.
+void play(const AudioClip &clip, uint32_t block_frames, double speed,
+	  const std::function<bool(const audio_data &block, uint64_t n)> &deliver);
+
+#endif
@@ -0,0 +1,77 @@
+#include "latency_histogram.h"
+#include <algorithm>
+#include <string>
+
+void LatencyHistogram::add(const uint64_t ns, const uint64_t count)
+{
+	const uint64_t us = ns / 1000;
+	buckets_[Buckets::of(us)] += count;
+	count_ += count;
+	sum_us_ += us * count;
+	max_us_ = std::max(max_us_, us);
+}
+
+void LatencyHistogram::merge(const LatencyHistogram &other)
+{
+	for (size_t i = 0; i < Buckets::COUNT; ++i)
+		buckets_[i] += other.buckets_[i];
+	count_ += other.count_;
+	sum_us_ += other.sum_us_;
+	max_us_ = std::max(max_us_, other.max_us_);
+}
+
+double LatencyHistogram::meanMs() const
+{
+	return count_ ? static_cast<double>(sum_us_) / static_cast<double>(count_) / 1000.0 : 0.0;
+}
+
+double LatencyHistogram::percentileMs(const double p) const
+{
+	if (count_ == 0)
+		return 0.0;
+	const uint64_t edge = Buckets::upperEdge(Buckets::percentile(buckets_, count_, p));
+	return static_cast<double>(std::min(edge, max_us_)) / 1000.0;
+}
+
+void LatencyHistogram::printSummary(FILE *out, const char *name) const
+{
+	fprintf(out, "%-10s %8llu  mean %8.1f  p50 %8.1f  p90 %8.1f  p99 %8.1f  max %8.1f ms\n", name,
+		static_cast<unsigned long long>(count_), meanMs(), percentileMs(0.50), percentileMs(0.90),
+		percentileMs(0.99), maxMs());
+}
+
+void LatencyHistogram::print(FILE *out, const char *name) const
+{
+	printSummary(out, name);
+	if (count_ == 0)
+		return;
+
+	static constexpr double EDGES_MS[] = {1, 2, 5, 10, 20, 50, 100, 200, 500, 1000, 2000, 5000, 10000};
+	constexpr size_t BINS = sizeof(EDGES_MS) / sizeof(EDGES_MS[0]) + 1;
+	uint64_t bins[BINS] = {};
+	for (size_t i = 0; i < Buckets::COUNT; ++i) {
+		if (!buckets_[i])
+			continue;
+		const double edge_ms = static_cast<double>(Buckets::upperEdge(i) + 1) / 1000.0;
+		const size_t bin = static_cast<size_t>(
+			std::lower_bound(std::begin(EDGES_MS), std::end(EDGES_MS), edge_ms) - std::begin(EDGES_MS));
+		bins[bin] += buckets_[i];
+	}
+
+	size_t first = 0, last = BINS - 1;
+	while (!bins[first])
+		++first;
+	while (!bins[last])
+		--last;
+	const uint64_t widest = *std::max_element(bins + first, bins + last + 1);
+	for (size_t bin = first; bin <= last; ++bin) {
+		char label[24];
+		if (bin < BINS - 1)
+			snprintf(label, sizeof(label), "<= %g ms", EDGES_MS[bin]);
+		else
+			snprintf(label, sizeof(label), " > %g ms", EDGES_MS[BINS - 2]);
+		const auto width = static_cast<size_t>(40.0 * static_cast<double>(bins[bin]) / static_cast<double>(widest));
+		fprintf(out, "  %-12s %8llu  %s\n", label, static_cast<unsigned long long>(bins[bin]),
+			std::string(width, '#').c_str());
+	}
+}
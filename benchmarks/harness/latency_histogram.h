@@ -0,0 +1,37 @@
+#ifndef LATENCY_HISTOGRAM_H
+#define LATENCY_HISTOGRAM_H
+
+#include "log_linear_buckets.h"
+#include <cstdint>
+#include <cstdio>
+
+// Latencies in microseconds, in the buckets of DurationHistogram over the
+// whole uint64_t range: percentiles within about 3 % and a fixed size however
+// long a run is.
+class LatencyHistogram {
+public:
+	void add(uint64_t ns, uint64_t count = 1);
+	void merge(const LatencyHistogram &other);
+	void clear() { *this = LatencyHistogram(); }
+
+	[[nodiscard]] uint64_t count() const { return count_; }
+	[[nodiscard]] double meanMs() const;
+	[[nodiscard]] double maxMs() const { return static_cast<double>(max_us_) / 1000.0; }
+	// p in [0, 1]; the upper edge of the bucket holding that rank.
+	[[nodiscard]] double percentileMs(double p) const;
+
+	// One line of count, mean, p50/p90/p99 and max.
+	void printSummary(FILE *out, const char *name) const;
+	// The summary, then the distribution over 1-2-5 millisecond bins.
+	void print(FILE *out, const char *name) const;
+
+private:
+	using Buckets = LogLinearBuckets<5>;
+
+	Buckets::Counts buckets_{};
+	uint64_t count_ = 0;
+	uint64_t sum_us_ = 0;
+	uint64_t max_us_ = 0;
+};
+
+#endif
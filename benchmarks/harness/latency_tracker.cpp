@@ -0,0 +1,130 @@
+#include "latency_tracker.h"
+#include <algorithm>
+#include <vector>
+
+namespace {
+
+uint64_t elapsed(const uint64_t from, const uint64_t to)
+{
+	return to > from ? to - from : 0;
+}
+
+} // namespace
+
+LatencyTracker::Result *LatencyTracker::find(const uint32_t stream, const uint32_t chunk, const uint64_t now_ns)
+{
+	if (static_cast<int64_t>(chunk) <= streams_[stream].last_done)
+		return nullptr;
+	Result &result = results_[key(stream, chunk)];
+	if (!result.first_ns)
+		result.first_ns = now_ns;
+	return &result;
+}
+
+void LatencyTracker::chunk(const mock_sayo::ChunkTiming &timing)
+{
+	std::vector<Sample> samples;
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		Stream &stream = streams_[timing.stream];
+		// The chunk's first frame came no earlier than the chunk before was captured
+		const uint64_t previous = timing.seq && timing.seq == stream.last_seq + 1 ? stream.last_captured : 0;
+		stream.last_received = timing.received_ns;
+		stream.last_seq = timing.seq;
+		stream.last_captured = timing.captured_ns;
+		if (!timing.replied_ns)
+			return;
+
+		Result *result = find(timing.stream, timing.chunk, timing.received_ns);
+		if (!result)
+			return;
+		result->started = previous;
+		result->completed = timing.captured_ns;
+		result->received = timing.received_ns;
+		result->replied = timing.replied_ns;
+		result->words = timing.words;
+		finish(timing.stream, timing.chunk, samples);
+	}
+	for (const Sample &sample : samples)
+		handler_(sample);
+}
+
+void LatencyTracker::signalled(std::string_view text, const uint64_t time_ns)
+{
+	std::vector<Sample> samples;
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		for (const mock_sayo::Marker &marker : mock_sayo::markers(text)) {
+			Result *result = find(marker.stream, marker.chunk, time_ns);
+			if (result && !result->signalled) {
+				result->signalled = time_ns;
+				finish(marker.stream, marker.chunk, samples);
+			}
+		}
+	}
+	for (const Sample &sample : samples)
+		handler_(sample);
+}
+
+void LatencyTracker::shown(std::string_view text, const uint64_t time_ns)
+{
+	std::vector<Sample> samples;
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		for (const mock_sayo::Marker &marker : mock_sayo::markers(text)) {
+			Result *result = find(marker.stream, marker.chunk, time_ns);
+			if (result && !result->shown) {
+				result->shown = time_ns;
+				finish(marker.stream, marker.chunk, samples);
+			}
+		}
+	}
+	for (const Sample &sample : samples)
+		handler_(sample);
+}
+
+void LatencyTracker::finish(const uint32_t stream, const uint32_t chunk, std::vector<Sample> &samples)
+{
+	const auto it = results_.find(key(stream, chunk));
+	const Result &r = it->second;
+	if (!r.received || !r.signalled || !r.shown)
+		return;
+	// The first chunk of a stream, or one after a gap in seq, has no start
+	if (r.started && r.completed) {
+		samples.push_back(Sample{stream, chunk, r.words, elapsed(r.started, r.completed),
+					 elapsed(r.completed, r.received), elapsed(r.received, r.replied),
+					 elapsed(r.replied, r.signalled), elapsed(r.signalled, r.shown),
+					 elapsed(r.started, r.shown)});
+	}
+	results_.erase(it);
+	Stream &s = streams_[stream];
+	s.last_done = std::max<int64_t>(s.last_done, chunk);
+}
+
+size_t LatencyTracker::expire(const uint64_t now_ns, const uint64_t max_age_ns)
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	size_t expired = 0;
+	for (auto it = results_.begin(); it != results_.end();) {
+		if (it->second.first_ns + max_age_ns < now_ns) {
+			it = results_.erase(it);
+			++expired;
+		} else {
+			++it;
+		}
+	}
+	return expired;
+}
+
+size_t LatencyTracker::pending() const
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	return results_.size();
+}
+
+size_t LatencyTracker::streams() const
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	return static_cast<size_t>(std::count_if(streams_.begin(), streams_.end(),
+						 [](const auto &entry) { return entry.second.last_received != 0; }));
+}
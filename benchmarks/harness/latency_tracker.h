@@ -0,0 +1,74 @@
+#ifndef LATENCY_TRACKER_H
+#define LATENCY_TRACKER_H
+
+#include "mock_sayo.h"
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// Follows each result from its audio to the text update that shows it. The
+// pieces come from different threads, in any order: the server's chunk
+// timings, which carry the time the client captured each chunk, the
+// "transcript_result" signal and the text source's "update" signal. A result
+// is reported once all are in and then forgotten, so a run of any length
+// holds only the results in flight.
+class LatencyTracker {
+public:
+	struct Sample {
+		uint32_t stream;
+		uint32_t chunk;
+		uint32_t words;
+		uint64_t fill_ns;    // the chunk before captured to this one captured: its audio arriving
+		uint64_t send_ns;    // chunk captured to the server reading it
+		uint64_t server_ns;  // server read to result written
+		uint64_t return_ns;  // result written to "transcript_result"
+		uint64_t display_ns; // signal to the text update showing it
+		uint64_t total_ns;   // the chunk before captured to the text update
+	};
+	using SampleHandler = std::function<void(const Sample &)>;
+
+	explicit LatencyTracker(SampleHandler handler) : handler_(std::move(handler)) {}
+
+	void chunk(const mock_sayo::ChunkTiming &timing);
+	void signalled(std::string_view text, uint64_t time_ns);
+	void shown(std::string_view text, uint64_t time_ns);
+	// Drops results first heard of more than max_age_ns before now_ns and
+	// returns how many; they count as lost.
+	size_t expire(uint64_t now_ns, uint64_t max_age_ns);
+
+	[[nodiscard]] size_t pending() const;
+	// Streams the server has sent chunk timings for.
+	[[nodiscard]] size_t streams() const;
+
+private:
+	struct Result {
+		uint64_t first_ns = 0; // when any piece of it arrived
+		uint64_t started = 0;
+		uint64_t completed = 0;
+		uint64_t received = 0;
+		uint64_t replied = 0;
+		uint64_t signalled = 0;
+		uint64_t shown = 0;
+		uint32_t words = 0;
+	};
+	struct Stream {
+		uint64_t last_received = 0;
+		uint64_t last_seq = 0;
+		uint64_t last_captured = 0;
+		int64_t last_done = -1; // results show in order, so older markers are stale
+	};
+
+	static uint64_t key(uint32_t stream, uint32_t chunk) { return static_cast<uint64_t>(stream) << 32 | chunk; }
+	Result *find(uint32_t stream, uint32_t chunk, uint64_t now_ns);
+	void finish(uint32_t stream, uint32_t chunk, std::vector<Sample> &samples);
+
+	const SampleHandler handler_;
+	mutable std::mutex mutex_;
+	std::unordered_map<uint32_t, Stream> streams_;
+	std::unordered_map<uint64_t, Result> results_;
+};
+
+#endif
@@ -0,0 +1,149 @@
+#include "mock_sayo.h"
+#include <util/platform.h>
+#include <sstream>
+#include <thread>
+#ifndef _WIN32
+#include <csignal>
+#include <sys/wait.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/prctl.h>
+#endif
+#endif
+
+namespace mock_sayo {
+
+namespace {
+
+uint32_t word_count(const std::string &line)
+{
+	std::istringstream in(line);
+	uint32_t words = 0;
+	for (std::string word; in >> word;)
+		++words;
+	return words;
+}
+
+} // namespace
+
+std::vector<Marker> markers(std::string_view text)
+{
+	std::vector<Marker> found;
+	for (size_t pos = text.find('#'); pos != std::string_view::npos; pos = text.find('#', pos + 1)) {
+		// Wrapping may have put the marker at the start of a line
+		if (pos > 0 && text[pos - 1] != ' ' && text[pos - 1] != '\n')
+			continue;
+		Marker marker{0, 0};
+		size_t i = pos + 1;
+		const size_t stream_start = i;
+		for (; i < text.size() && text[i] >= '0' && text[i] <= '9'; ++i)
+			marker.stream = marker.stream * 10 + static_cast<uint32_t>(text[i] - '0');
+		if (i == stream_start || i >= text.size() || text[i] != ':')
+			continue;
+		const size_t chunk_start = ++i;
+		for (; i < text.size() && text[i] >= '0' && text[i] <= '9'; ++i)
+			marker.chunk = marker.chunk * 10 + static_cast<uint32_t>(text[i] - '0');
+		if (i > chunk_start)
+			found.push_back(marker);
+	}
+	return found;
+}
+
+Service::Service(std::vector<std::string> script, const std::chrono::microseconds processing, ChunkHandler handler)
+	: script_(script.empty() ? std::vector<std::string>{""} : std::move(script)),
+	  processing_(processing),
+	  handler_(std::move(handler))
+{
+}
+
+grpc::Status Service::StreamingASR(grpc::ServerContext *,
+				   grpc::ServerReaderWriter<sayo::ASRResult, sayo::AudioChunk> *stream)
+{
+	const uint32_t id = streams_opened_++;
+	++streams_open_;
+	sayo::AudioChunk chunk;
+	sayo::ASRResult result;
+	for (uint32_t n = 0; stream->Read(&chunk); ++n) {
+		ChunkTiming timing{id, n, chunk.seq(), chunk.capture_ns(), os_gettime_ns(), 0, 0};
+		if (processing_.count() > 0)
+			std::this_thread::sleep_for(processing_);
+		const std::string &line = script_[n % script_.size()];
+		if (line.empty()) {
+			if (handler_)
+				handler_(timing);
+			continue;
+		}
+		result.set_text(line + " #" + std::to_string(id) + ":" + std::to_string(n));
+		timing.words = word_count(line);
+		timing.replied_ns = os_gettime_ns();
+		result.set_last_seq(chunk.seq());
+		result.set_server_processing_ns(timing.replied_ns - timing.received_ns);
+		if (handler_)
+			handler_(timing);
+		stream->Write(result);
+	}
+	--streams_open_;
+	return grpc::Status::OK;
+}
+
+grpc::Status Service::Ping(grpc::ServerContext *, const sayo::PingRequest *, sayo::PingResponse *response)
+{
+	response->set_message("pong");
+	return grpc::Status::OK;
+}
+
+std::unique_ptr<grpc::Server> Service::listen(int &port)
+{
+	grpc::ServerBuilder builder;
+	builder.AddListeningPort("127.0.0.1:0", grpc::InsecureServerCredentials(), &port);
+	builder.RegisterService(this);
+	std::unique_ptr<grpc::Server> server = builder.BuildAndStart();
+	return port > 0 ? std::move(server) : nullptr;
+}
+
+#ifndef _WIN32
+pid_t spawn(std::vector<std::string> script, const std::chrono::microseconds processing, int &port, int &timings_fd)
+{
+	int fds[2];
+	if (pipe(fds) != 0)
+		return -1;
+	const pid_t pid = fork();
+	if (pid < 0) {
+		close(fds[0]);
+		close(fds[1]);
+		return -1;
+	}
+
+	if (pid == 0) {
+#ifdef __linux__
+		prctl(PR_SET_PDEATHSIG, SIGTERM);
+#endif
+		close(fds[0]);
+		signal(SIGPIPE, SIG_IGN);
+		const int out = fds[1];
+		// Records are smaller than PIPE_BUF, so writes from several streams never interleave
+		Service service(std::move(script), processing, [out](const ChunkTiming &timing) {
+			if (write(out, &timing, sizeof(timing)) != static_cast<ssize_t>(sizeof(timing)))
+				_exit(0); // the parent has gone
+		});
+		int child_port = 0;
+		const std::unique_ptr<grpc::Server> server = service.listen(child_port);
+		if (write(out, &child_port, sizeof(child_port)) != static_cast<ssize_t>(sizeof(child_port)) || !server)
+			_exit(1);
+		server->Wait();
+		_exit(0);
+	}
+
+	close(fds[1]);
+	if (read(fds[0], &port, sizeof(port)) != static_cast<ssize_t>(sizeof(port)) || port <= 0) {
+		close(fds[0]);
+		kill(pid, SIGTERM);
+		waitpid(pid, nullptr, 0);
+		return -1;
+	}
+	timings_fd = fds[0];
+	return pid;
+}
+#endif
+
+} // namespace mock_sayo
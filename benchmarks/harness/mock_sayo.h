@@ -0,0 +1,78 @@
+#ifndef MOCK_SAYO_H
+#define MOCK_SAYO_H
+
+#include "server_gRPC/sayo.grpc.pb.h"
+#include <grpcpp/grpcpp.h>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#ifndef _WIN32
+#include <sys/types.h>
+#endif
+
+namespace mock_sayo {
+
+struct ChunkTiming {
+	uint32_t stream;      // streams are numbered in the order they opened
+	uint32_t chunk;       // within the stream
+	uint64_t seq;         // AudioChunk.seq
+	uint64_t captured_ns; // AudioChunk.capture_ns
+	uint64_t received_ns; // os_gettime_ns() when Read returned it
+	uint64_t replied_ns;  // just before its result was written, 0 for no result
+	uint32_t words;       // in the result, not counting its marker
+};
+
+struct Marker {
+	uint32_t stream;
+	uint32_t chunk;
+};
+
+// Every "#<stream>:<chunk>" marker starting a word of a caption, in order.
+std::vector<Marker> markers(std::string_view text);
+
+// Scripted stand-in for the Sayo server. Chunk n of a stream is answered
+// with line n of the script (cycling), followed by its marker; an empty line
+// sends nothing. The processing delay is spent before each answer, on the
+// stream's own thread, so a delay longer than a chunk backs the stream up.
+// The handler sees every chunk, just before its result is written.
+class Service final : public sayo::SayoService::Service {
+public:
+	using ChunkHandler = std::function<void(const ChunkTiming &)>;
+
+	Service(std::vector<std::string> script, std::chrono::microseconds processing, ChunkHandler handler);
+
+	grpc::Status StreamingASR(grpc::ServerContext *context,
+				  grpc::ServerReaderWriter<sayo::ASRResult, sayo::AudioChunk> *stream) override;
+	grpc::Status Ping(grpc::ServerContext *context, const sayo::PingRequest *request,
+			  sayo::PingResponse *response) override;
+
+	// Listens on an ephemeral loopback port and returns the server, or null.
+	std::unique_ptr<grpc::Server> listen(int &port);
+
+	[[nodiscard]] uint32_t streamsOpened() const { return streams_opened_; }
+	[[nodiscard]] uint32_t streamsOpen() const { return streams_open_; }
+
+private:
+	const std::vector<std::string> script_;
+	const std::chrono::microseconds processing_;
+	const ChunkHandler handler_;
+	std::atomic<uint32_t> streams_opened_{0};
+	std::atomic<uint32_t> streams_open_{0};
+};
+
+#ifndef _WIN32
+// Runs a Service in a child process, so that the caller's CPU time, threads
+// and sockets are the client's alone. Fork before anything starts gRPC. The
+// child writes a ChunkTiming record to timings_fd for every chunk, and exits
+// when the caller does or is killed. Returns the child's pid, or -1.
+pid_t spawn(std::vector<std::string> script, std::chrono::microseconds processing, int &port, int &timings_fd);
+#endif
+
+} // namespace mock_sayo
+
+#endif
@@ -0,0 +1,1209 @@
+#include "obs_stub.h"
+#include <callback/calldata.h>
+#include <callback/proc.h>
+#include <callback/signal.h>
+#include <util/bmem.h>
+#include <util/platform.h>
+#include <util/text-lookup.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+struct signal_handler {
+	std::mutex mutex;
+	std::map<std::string, std::vector<std::pair<signal_callback_t, void *>>> callbacks;
+};
+
+struct proc_handler {
+	std::mutex mutex;
+	std::map<std::string, std::pair<proc_handler_proc_t, void *>> procs;
+};
+
+struct obs_data_array {
+	std::atomic<long> refs{1};
+	std::vector<obs_data_t *> items;
+};
+
+struct obs_data {
+	enum class Type { Null, String, Int, Double, Bool, Object, Array };
+	struct Value {
+		Type type = Type::Null;
+		std::string string;
+		long long integer = 0;
+		double number = 0.0;
+		bool boolean = false;
+		obs_data_t *object = nullptr;
+		obs_data_array_t *array = nullptr;
+	};
+	struct Item {
+		Value user;
+		Value fallback; // obs_data_set_default_*
+	};
+
+	std::atomic<long> refs{1};
+	std::map<std::string, Item> items;
+	std::string json;
+};
+
+struct obs_property {
+	std::string name;
+	std::string description;
+	std::string long_description;
+	obs_property_type type = OBS_PROPERTY_INVALID;
+	bool enabled = true;
+	bool visible = true;
+	obs_properties_t *parent = nullptr;
+	obs_property_t *next = nullptr;
+	obs_property_clicked_t clicked = nullptr;
+	int int_min = 0, int_max = 0, int_step = 0;
+	double float_min = 0.0, float_max = 0.0, float_step = 0.0;
+	obs_combo_type combo_type = OBS_COMBO_TYPE_LIST;
+	obs_combo_format combo_format = OBS_COMBO_FORMAT_STRING;
+	std::vector<std::pair<std::string, std::string>> items;
+};
+
+struct obs_properties {
+	std::vector<std::unique_ptr<obs_property>> list;
+};
+
+struct obs_source {
+	std::string id;
+	std::string name;
+	bool is_private = false;
+	obs_source_info info{}; // zero for types the plugin did not register
+	obs_data_t *settings = nullptr;
+	void *data = nullptr;
+	std::atomic<long> refs{1};
+	proc_handler_t procs;
+	signal_handler_t signals;
+	std::mutex audio_mutex;
+	std::vector<std::pair<obs_source_audio_capture_t, void *>> audio_callbacks;
+};
+
+struct obs_hotkey {
+	std::string name;
+	std::function<void(bool)> pressed;
+};
+
+namespace {
+
+struct Globals {
+	std::mutex mutex;
+	std::vector<obs_source_info> types;
+	std::vector<obs_source_t *> sources; // public ones, oldest first
+	std::vector<std::unique_ptr<obs_hotkey>> hotkeys; // obs_hotkey_id is the index
+	signal_handler_t signals;
+	audio_output_info audio{};
+	std::string config_dir = "sayo-harness";
+
+	Globals()
+	{
+		audio.name = "stub";
+		audio.samples_per_sec = 48000;
+		audio.format = AUDIO_FORMAT_FLOAT_PLANAR;
+		audio.speakers = SPEAKERS_STEREO;
+	}
+};
+
+Globals &globals()
+{
+	static Globals instance;
+	return instance;
+}
+
+char *duplicate(const std::string &text)
+{
+	return static_cast<char *>(bmemdup(text.c_str(), text.size() + 1));
+}
+
+void release_value(obs_data::Value &value)
+{
+	obs_data_release(value.object);
+	obs_data_array_release(value.array);
+	value = obs_data::Value();
+}
+
+obs_data::Value *find(obs_data_t *data, const char *name)
+{
+	if (!data || !name)
+		return nullptr;
+	const auto it = data->items.find(name);
+	if (it == data->items.end())
+		return nullptr;
+	return it->second.user.type != obs_data::Type::Null ? &it->second.user : &it->second.fallback;
+}
+
+obs_data::Value &slot(obs_data_t *data, const char *name, const bool fallback)
+{
+	obs_data::Item &item = data->items[name];
+	obs_data::Value &value = fallback ? item.fallback : item.user;
+	release_value(value);
+	return value;
+}
+
+void append_json_string(std::string &out, const std::string &text)
+{
+	out += '"';
+	for (const char c : text) {
+		switch (c) {
+		case '"':
+			out += "\\\"";
+			break;
+		case '\\':
+			out += "\\\\";
+			break;
+		case '\n':
+			out += "\\n";
+			break;
+		case '\r':
+			out += "\\r";
+			break;
+		case '\t':
+			out += "\\t";
+			break;
+		default:
+			if (static_cast<unsigned char>(c) < 0x20) {
+				char escaped[8];
+				snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+				out += escaped;
+			} else {
+				out += c;
+			}
+		}
+	}
+	out += '"';
+}
+
+void append_json(std::string &out, obs_data_t *data);
+
+void append_json(std::string &out, const obs_data::Value &value)
+{
+	switch (value.type) {
+	case obs_data::Type::String:
+		append_json_string(out, value.string);
+		break;
+	case obs_data::Type::Int:
+		out += std::to_string(value.integer);
+		break;
+	case obs_data::Type::Double: {
+		char number[32];
+		snprintf(number, sizeof(number), "%.17g", value.number);
+		out += number;
+		break;
+	}
+	case obs_data::Type::Bool:
+		out += value.boolean ? "true" : "false";
+		break;
+	case obs_data::Type::Object:
+		append_json(out, value.object);
+		break;
+	case obs_data::Type::Array:
+		out += '[';
+		for (size_t i = 0; i < value.array->items.size(); ++i) {
+			if (i > 0)
+				out += ',';
+			append_json(out, value.array->items[i]);
+		}
+		out += ']';
+		break;
+	case obs_data::Type::Null:
+		out += "null";
+		break;
+	}
+}
+
+// User values only, as obs_data_get_json() does
+void append_json(std::string &out, obs_data_t *data)
+{
+	out += '{';
+	bool first = true;
+	for (const auto &[name, item] : data->items) {
+		if (item.user.type == obs_data::Type::Null)
+			continue;
+		if (!first)
+			out += ',';
+		first = false;
+		append_json_string(out, name);
+		out += ':';
+		append_json(out, item.user);
+	}
+	out += '}';
+}
+
+obs_property_t *add_property(obs_properties_t *props, const char *name, const char *description,
+			     const obs_property_type type)
+{
+	if (!props || !name || obs_properties_get(props, name))
+		return nullptr;
+	auto property = std::make_unique<obs_property>();
+	property->name = name;
+	property->description = description ? description : "";
+	property->type = type;
+	property->parent = props;
+	if (!props->list.empty())
+		props->list.back()->next = property.get();
+	props->list.push_back(std::move(property));
+	return props->list.back().get();
+}
+
+obs_source_t *create_source(const char *id, const char *name, obs_data_t *settings, const bool is_private)
+{
+	auto *source = new obs_source;
+	source->id = id ? id : "";
+	source->name = name ? name : "";
+	source->is_private = is_private;
+	{
+		Globals &g = globals();
+		std::lock_guard<std::mutex> lock(g.mutex);
+		const auto type = std::find_if(g.types.begin(), g.types.end(), [&](const obs_source_info &info) {
+			return source->id == info.id;
+		});
+		if (type != g.types.end())
+			source->info = *type;
+	}
+	// Shared with the caller, as in OBS
+	if (settings)
+		obs_data_addref(settings);
+	source->settings = settings ? settings : obs_data_create();
+
+	if (source->info.get_defaults)
+		source->info.get_defaults(source->settings);
+	if (source->info.create)
+		source->data = source->info.create(source->settings, source);
+
+	if (!is_private) {
+		{
+			Globals &g = globals();
+			std::lock_guard<std::mutex> lock(g.mutex);
+			g.sources.push_back(source);
+		}
+		calldata_t cd;
+		calldata_init(&cd);
+		calldata_set_ptr(&cd, "source", source);
+		signal_handler_signal(&globals().signals, "source_create", &cd);
+		calldata_free(&cd);
+	}
+	return source;
+}
+
+// calldata stack, as libobs lays it out: per parameter the name's size, the
+// name with its terminator, the data's size and the data; a zero size ends it.
+uint8_t *find_param(const calldata_t *cd, const char *name)
+{
+	if (!cd->stack || !name)
+		return nullptr;
+	const size_t name_size = strlen(name) + 1;
+	uint8_t *pos = cd->stack;
+	for (;;) {
+		size_t size;
+		memcpy(&size, pos, sizeof(size));
+		if (size == 0)
+			return nullptr;
+		const bool match = size == name_size && memcmp(pos + sizeof(size_t), name, name_size) == 0;
+		if (match)
+			return pos;
+		pos += sizeof(size_t) + size;
+		memcpy(&size, pos, sizeof(size));
+		pos += sizeof(size_t) + size;
+	}
+}
+
+size_t param_size(const uint8_t *param)
+{
+	size_t name_size, data_size;
+	memcpy(&name_size, param, sizeof(name_size));
+	memcpy(&data_size, param + sizeof(size_t) + name_size, sizeof(data_size));
+	return 2 * sizeof(size_t) + name_size + data_size;
+}
+
+} // namespace
+
+namespace obs_stub {
+
+void set_sample_rate(const uint32_t samples_per_sec)
+{
+	globals().audio.samples_per_sec = samples_per_sec;
+}
+
+void set_config_dir(const std::string &dir)
+{
+	globals().config_dir = dir;
+}
+
+obs_source_t *create_audio_source(const char *name)
+{
+	obs_source_t *source = create_source("harness_audio_source", name, nullptr, false);
+	source->info.output_flags = OBS_SOURCE_AUDIO;
+	return source;
+}
+
+void push_audio(obs_source_t *source, const audio_data &data)
+{
+	std::lock_guard<std::mutex> lock(source->audio_mutex);
+	for (const auto &[callback, param] : source->audio_callbacks)
+		callback(param, source, &data, false);
+}
+
+void video_tick(obs_source_t *source, const float seconds)
+{
+	if (source->data && source->info.video_tick)
+		source->info.video_tick(source->data, seconds);
+}
+
+bool click(obs_source_t *source, const char *button)
+{
+	obs_properties_t *props = obs_source_properties(source);
+	obs_property_t *property = obs_properties_get(props, button);
+	const bool clicked = property && property->clicked;
+	if (clicked)
+		property->clicked(props, property, source->data);
+	obs_properties_destroy(props);
+	return clicked;
+}
+
+void add_hotkey(const char *name, std::function<void(bool pressed)> pressed)
+{
+	Globals &g = globals();
+	std::lock_guard<std::mutex> lock(g.mutex);
+	g.hotkeys.push_back(std::make_unique<obs_hotkey>(obs_hotkey{name, std::move(pressed)}));
+}
+
+} // namespace obs_stub
+
+extern "C" {
+
+/* Memory and platform */
+
+void *bmalloc(size_t size)
+{
+	void *ptr = malloc(size ? size : 1);
+	if (!ptr)
+		abort();
+	return ptr;
+}
+
+void *brealloc(void *ptr, size_t size)
+{
+	ptr = realloc(ptr, size ? size : 1);
+	if (!ptr)
+		abort();
+	return ptr;
+}
+
+void bfree(void *ptr)
+{
+	free(ptr);
+}
+
+void *bmemdup(const void *ptr, size_t size)
+{
+	void *out = bmalloc(size);
+	if (size)
+		memcpy(out, ptr, size);
+	return out;
+}
+
+uint64_t os_gettime_ns(void)
+{
+	return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+					     std::chrono::steady_clock::now().time_since_epoch())
+					     .count());
+}
+
+int os_mkdirs(const char *path)
+{
+	std::error_code error;
+	if (std::filesystem::is_directory(path, error))
+		return MKDIR_EXISTS;
+	return std::filesystem::create_directories(path, error) ? MKDIR_SUCCESS : MKDIR_ERROR;
+}
+
+FILE *os_fopen(const char *path, const char *mode)
+{
+	return path ? fopen(path, mode) : nullptr;
+}
+
+int os_rename(const char *old_path, const char *new_path)
+{
+	std::error_code error;
+	std::filesystem::rename(old_path, new_path, error);
+	return error ? -1 : 0;
+}
+
+char *os_quick_read_utf8_file(const char *path)
+{
+	FILE *file = os_fopen(path, "rb");
+	if (!file)
+		return nullptr;
+	std::string text;
+	char buffer[4096];
+	size_t read;
+	while ((read = fread(buffer, 1, sizeof(buffer), file)) > 0)
+		text.append(buffer, read);
+	fclose(file);
+	if (text.compare(0, 3, "\xEF\xBB\xBF") == 0)
+		text.erase(0, 3);
+	return duplicate(text);
+}
+
+struct os_dir {
+	std::filesystem::directory_iterator it;
+	os_dirent entry;
+};
+
+os_dir_t *os_opendir(const char *path)
+{
+	std::error_code error;
+	std::filesystem::directory_iterator it(path, error);
+	return error ? nullptr : new os_dir{it, {}};
+}
+
+struct os_dirent *os_readdir(os_dir_t *dir)
+{
+	std::error_code error;
+	if (!dir || dir->it == std::filesystem::directory_iterator())
+		return nullptr;
+	const std::string name = dir->it->path().filename().string();
+	snprintf(dir->entry.d_name, sizeof(dir->entry.d_name), "%s", name.c_str());
+	dir->entry.directory = dir->it->is_directory(error);
+	dir->it.increment(error);
+	if (error)
+		dir->it = std::filesystem::directory_iterator();
+	return &dir->entry;
+}
+
+void os_closedir(os_dir_t *dir)
+{
+	delete dir;
+}
+
+/* Module */
+
+char *obs_module_get_config_path(obs_module_t *, const char *file)
+{
+	return duplicate(globals().config_dir + "/" + (file ? file : ""));
+}
+
+lookup_t *obs_module_load_locale(obs_module_t *, const char *, const char *)
+{
+	return nullptr;
+}
+
+bool text_lookup_getstr(lookup_t *, const char *, const char **)
+{
+	return false;
+}
+
+void text_lookup_destroy(lookup_t *) {}
+
+void obs_register_source_s(const struct obs_source_info *info, size_t size)
+{
+	obs_source_info copy{};
+	memcpy(&copy, info, std::min(size, sizeof(copy)));
+	Globals &g = globals();
+	std::lock_guard<std::mutex> lock(g.mutex);
+	g.types.push_back(copy);
+}
+
+void obs_queue_task(enum obs_task_type, obs_task_t task, void *param, bool)
+{
+	task(param);
+}
+
+audio_t *obs_get_audio(void)
+{
+	return reinterpret_cast<audio_t *>(&globals().audio);
+}
+
+const struct audio_output_info *audio_output_get_info(const audio_t *)
+{
+	return &globals().audio;
+}
+
+signal_handler_t *obs_get_signal_handler(void)
+{
+	return &globals().signals;
+}
+
+obs_hotkey_id obs_hotkey_register_source(obs_source_t *, const char *, const char *, obs_hotkey_func, void *)
+{
+	return 0;
+}
+
+void obs_enum_hotkeys(obs_hotkey_enum_func func, void *data)
+{
+	Globals &g = globals();
+	std::vector<obs_hotkey *> hotkeys;
+	{
+		std::lock_guard<std::mutex> lock(g.mutex);
+		for (const auto &hotkey : g.hotkeys)
+			hotkeys.push_back(hotkey.get());
+	}
+	for (size_t id = 0; id < hotkeys.size(); ++id) {
+		if (!func(data, id, hotkeys[id]))
+			break;
+	}
+}
+
+const char *obs_hotkey_get_name(const obs_hotkey_t *key)
+{
+	return key->name.c_str();
+}
+
+const char *obs_hotkey_get_description(const obs_hotkey_t *key)
+{
+	return key->name.c_str();
+}
+
+void obs_hotkey_trigger_routed_callback(obs_hotkey_id id, bool pressed)
+{
+	Globals &g = globals();
+	std::function<void(bool)> callback;
+	{
+		std::lock_guard<std::mutex> lock(g.mutex);
+		if (id < g.hotkeys.size())
+			callback = g.hotkeys[id]->pressed;
+	}
+	if (callback)
+		callback(pressed);
+}
+
+/* Sources */
+
+obs_source_t *obs_source_create(const char *id, const char *name, obs_data_t *settings, obs_data_t *)
+{
+	return create_source(id, name, settings, false);
+}
+
+obs_source_t *obs_source_create_private(const char *id, const char *name, obs_data_t *settings)
+{
+	return create_source(id, name, settings, true);
+}
+
+obs_source_t *obs_source_get_ref(obs_source_t *source)
+{
+	if (source)
+		++source->refs;
+	return source;
+}
+
+void obs_source_release(obs_source_t *source)
+{
+	if (!source || --source->refs > 0)
+		return;
+	if (!source->is_private) {
+		Globals &g = globals();
+		std::lock_guard<std::mutex> lock(g.mutex);
+		g.sources.erase(std::remove(g.sources.begin(), g.sources.end(), source), g.sources.end());
+	}
+	if (source->data && source->info.destroy)
+		source->info.destroy(source->data);
+	obs_data_release(source->settings);
+	delete source;
+}
+
+obs_source_t *obs_get_source_by_name(const char *name)
+{
+	if (!name)
+		return nullptr;
+	Globals &g = globals();
+	std::lock_guard<std::mutex> lock(g.mutex);
+	for (obs_source_t *source : g.sources) {
+		if (source->name == name)
+			return obs_source_get_ref(source);
+	}
+	return nullptr;
+}
+
+void obs_enum_sources(bool (*enum_proc)(void *, obs_source_t *), void *param)
+{
+	std::vector<obs_source_t *> sources;
+	{
+		Globals &g = globals();
+		std::lock_guard<std::mutex> lock(g.mutex);
+		sources = g.sources;
+	}
+	for (obs_source_t *source : sources) {
+		if (!enum_proc(param, source))
+			break;
+	}
+}
+
+const char *obs_source_get_name(const obs_source_t *source)
+{
+	return source ? source->name.c_str() : nullptr;
+}
+
+const char *obs_source_get_id(const obs_source_t *source)
+{
+	return source ? source->id.c_str() : nullptr;
+}
+
+uint32_t obs_source_get_output_flags(const obs_source_t *source)
+{
+	return source ? source->info.output_flags : 0;
+}
+
+obs_data_t *obs_source_get_settings(const obs_source_t *source)
+{
+	if (!source)
+		return nullptr;
+	obs_data_addref(source->settings);
+	return source->settings;
+}
+
+void obs_source_update(obs_source_t *source, obs_data_t *settings)
+{
+	if (!source)
+		return;
+	if (settings)
+		obs_data_apply(source->settings, settings);
+	if (source->data && source->info.update)
+		source->info.update(source->data, source->settings);
+
+	calldata_t cd;
+	calldata_init(&cd);
+	calldata_set_ptr(&cd, "source", source);
+	signal_handler_signal(&source->signals, "update", &cd);
+	calldata_free(&cd);
+}
+
+obs_properties_t *obs_source_properties(const obs_source_t *source)
+{
+	if (source && source->data && source->info.get_properties)
+		return source->info.get_properties(source->data);
+	return obs_properties_create();
+}
+
+uint32_t obs_source_get_width(obs_source_t *source)
+{
+	return source && source->data && source->info.get_width ? source->info.get_width(source->data) : 0;
+}
+
+uint32_t obs_source_get_height(obs_source_t *source)
+{
+	return source && source->data && source->info.get_height ? source->info.get_height(source->data) : 0;
+}
+
+void obs_source_video_render(obs_source_t *) {}
+
+proc_handler_t *obs_source_get_proc_handler(const obs_source_t *source)
+{
+	return source ? const_cast<proc_handler_t *>(&source->procs) : nullptr;
+}
+
+signal_handler_t *obs_source_get_signal_handler(const obs_source_t *source)
+{
+	return source ? const_cast<signal_handler_t *>(&source->signals) : nullptr;
+}
+
+void obs_source_add_audio_capture_callback(obs_source_t *source, obs_source_audio_capture_t callback, void *param)
+{
+	if (!source)
+		return;
+	std::lock_guard<std::mutex> lock(source->audio_mutex);
+	source->audio_callbacks.emplace_back(callback, param);
+}
+
+void obs_source_remove_audio_capture_callback(obs_source_t *source, obs_source_audio_capture_t callback, void *param)
+{
+	if (!source)
+		return;
+	std::lock_guard<std::mutex> lock(source->audio_mutex);
+	auto &callbacks = source->audio_callbacks;
+	const auto it = std::find(callbacks.begin(), callbacks.end(), std::make_pair(callback, param));
+	if (it != callbacks.end())
+		callbacks.erase(it);
+}
+
+/* Procs, signals and calldata */
+
+void proc_handler_add(proc_handler_t *handler, const char *decl_string, proc_handler_proc_t proc, void *data)
+{
+	// "void name(...)": the name is the word before the parenthesis
+	const std::string decl = decl_string;
+	const size_t paren = decl.find('(');
+	const size_t space = decl.rfind(' ', paren);
+	const std::string name = decl.substr(space == std::string::npos ? 0 : space + 1,
+					     paren - (space == std::string::npos ? 0 : space + 1));
+	std::lock_guard<std::mutex> lock(handler->mutex);
+	handler->procs[name] = {proc, data};
+}
+
+bool proc_handler_call(proc_handler_t *handler, const char *name, calldata_t *params)
+{
+	std::pair<proc_handler_proc_t, void *> proc;
+	{
+		std::lock_guard<std::mutex> lock(handler->mutex);
+		const auto it = handler->procs.find(name);
+		if (it == handler->procs.end())
+			return false;
+		proc = it->second;
+	}
+	proc.first(proc.second, params);
+	return true;
+}
+
+bool signal_handler_add(signal_handler_t *, const char *)
+{
+	return true;
+}
+
+void signal_handler_connect(signal_handler_t *handler, const char *signal, signal_callback_t callback, void *data)
+{
+	std::lock_guard<std::mutex> lock(handler->mutex);
+	handler->callbacks[signal].emplace_back(callback, data);
+}
+
+void signal_handler_signal(signal_handler_t *handler, const char *signal, calldata_t *params)
+{
+	std::vector<std::pair<signal_callback_t, void *>> callbacks;
+	{
+		std::lock_guard<std::mutex> lock(handler->mutex);
+		const auto it = handler->callbacks.find(signal);
+		if (it == handler->callbacks.end())
+			return;
+		callbacks = it->second;
+	}
+	for (const auto &[callback, data] : callbacks)
+		callback(data, params);
+}
+
+bool calldata_get_data(const calldata_t *data, const char *name, void *out, size_t size)
+{
+	const uint8_t *param = find_param(data, name);
+	if (!param)
+		return false;
+	size_t name_size, data_size;
+	memcpy(&name_size, param, sizeof(name_size));
+	param += sizeof(size_t) + name_size;
+	memcpy(&data_size, param, sizeof(data_size));
+	if (data_size != size)
+		return false;
+	memcpy(out, param + sizeof(size_t), size);
+	return true;
+}
+
+bool calldata_get_string(const calldata_t *data, const char *name, const char **str)
+{
+	const uint8_t *param = find_param(data, name);
+	if (!param)
+		return false;
+	size_t name_size, data_size;
+	memcpy(&name_size, param, sizeof(name_size));
+	param += sizeof(size_t) + name_size;
+	memcpy(&data_size, param, sizeof(data_size));
+	*str = data_size ? reinterpret_cast<const char *>(param + sizeof(size_t)) : nullptr;
+	return true;
+}
+
+void calldata_set_data(calldata_t *data, const char *name, const void *in, size_t new_size)
+{
+	if (!name || !*name)
+		return;
+	if (!data->stack) {
+		data->capacity = 128;
+		data->stack = static_cast<uint8_t *>(bmalloc(data->capacity));
+		memset(data->stack, 0, sizeof(size_t));
+		data->size = sizeof(size_t);
+	}
+
+	// Drop the old value, then append the new one in front of the terminator
+	if (uint8_t *param = find_param(data, name)) {
+		const size_t old_size = param_size(param);
+		memmove(param, param + old_size, data->size - static_cast<size_t>(param - data->stack) - old_size);
+		data->size -= old_size;
+	}
+	const size_t name_size = strlen(name) + 1;
+	const size_t needed = data->size + 2 * sizeof(size_t) + name_size + new_size;
+	if (needed > data->capacity) {
+		if (data->fixed)
+			return;
+		data->capacity = std::max(needed, data->capacity * 2);
+		data->stack = static_cast<uint8_t *>(brealloc(data->stack, data->capacity));
+	}
+
+	uint8_t *pos = data->stack + data->size - sizeof(size_t);
+	memcpy(pos, &name_size, sizeof(size_t));
+	memcpy(pos + sizeof(size_t), name, name_size);
+	pos += sizeof(size_t) + name_size;
+	memcpy(pos, &new_size, sizeof(size_t));
+	if (new_size)
+		memcpy(pos + sizeof(size_t), in, new_size);
+	pos += sizeof(size_t) + new_size;
+	memset(pos, 0, sizeof(size_t));
+	data->size = needed;
+}
+
+/* Settings */
+
+obs_data_t *obs_data_create()
+{
+	return new obs_data;
+}
+
+void obs_data_addref(obs_data_t *data)
+{
+	if (data)
+		++data->refs;
+}
+
+void obs_data_release(obs_data_t *data)
+{
+	if (!data || --data->refs > 0)
+		return;
+	for (auto &[name, item] : data->items) {
+		release_value(item.user);
+		release_value(item.fallback);
+	}
+	delete data;
+}
+
+const char *obs_data_get_json(obs_data_t *data)
+{
+	if (!data)
+		return nullptr;
+	data->json.clear();
+	append_json(data->json, data);
+	return data->json.c_str();
+}
+
+void obs_data_apply(obs_data_t *target, obs_data_t *apply_data)
+{
+	if (!target || !apply_data || target == apply_data)
+		return;
+	for (const auto &[name, item] : apply_data->items) {
+		if (item.user.type == obs_data::Type::Null)
+			continue;
+		obs_data::Value &value = slot(target, name.c_str(), false);
+		value = item.user;
+		obs_data_addref(value.object);
+		if (value.array)
+			++value.array->refs;
+	}
+}
+
+void obs_data_set_string(obs_data_t *data, const char *name, const char *val)
+{
+	obs_data::Value &value = slot(data, name, false);
+	value.type = obs_data::Type::String;
+	value.string = val ? val : "";
+}
+
+void obs_data_set_int(obs_data_t *data, const char *name, long long val)
+{
+	obs_data::Value &value = slot(data, name, false);
+	value.type = obs_data::Type::Int;
+	value.integer = val;
+}
+
+void obs_data_set_bool(obs_data_t *data, const char *name, bool val)
+{
+	obs_data::Value &value = slot(data, name, false);
+	value.type = obs_data::Type::Bool;
+	value.boolean = val;
+}
+
+void obs_data_set_array(obs_data_t *data, const char *name, obs_data_array_t *array)
+{
+	obs_data::Value &value = slot(data, name, false);
+	value.type = array ? obs_data::Type::Array : obs_data::Type::Null;
+	if (array)
+		++array->refs;
+	value.array = array;
+}
+
+void obs_data_set_default_string(obs_data_t *data, const char *name, const char *val)
+{
+	obs_data::Value &value = slot(data, name, true);
+	value.type = obs_data::Type::String;
+	value.string = val ? val : "";
+}
+
+void obs_data_set_default_int(obs_data_t *data, const char *name, long long val)
+{
+	obs_data::Value &value = slot(data, name, true);
+	value.type = obs_data::Type::Int;
+	value.integer = val;
+}
+
+void obs_data_set_default_double(obs_data_t *data, const char *name, double val)
+{
+	obs_data::Value &value = slot(data, name, true);
+	value.type = obs_data::Type::Double;
+	value.number = val;
+}
+
+void obs_data_set_default_bool(obs_data_t *data, const char *name, bool val)
+{
+	obs_data::Value &value = slot(data, name, true);
+	value.type = obs_data::Type::Bool;
+	value.boolean = val;
+}
+
+const char *obs_data_get_string(obs_data_t *data, const char *name)
+{
+	const obs_data::Value *value = find(data, name);
+	return value && value->type == obs_data::Type::String ? value->string.c_str() : "";
+}
+
+long long obs_data_get_int(obs_data_t *data, const char *name)
+{
+	const obs_data::Value *value = find(data, name);
+	if (!value)
+		return 0;
+	if (value->type == obs_data::Type::Double)
+		return static_cast<long long>(value->number);
+	return value->type == obs_data::Type::Int ? value->integer : 0;
+}
+
+double obs_data_get_double(obs_data_t *data, const char *name)
+{
+	const obs_data::Value *value = find(data, name);
+	if (!value)
+		return 0.0;
+	if (value->type == obs_data::Type::Int)
+		return static_cast<double>(value->integer);
+	return value->type == obs_data::Type::Double ? value->number : 0.0;
+}
+
+bool obs_data_get_bool(obs_data_t *data, const char *name)
+{
+	const obs_data::Value *value = find(data, name);
+	return value && value->type == obs_data::Type::Bool && value->boolean;
+}
+
+obs_data_t *obs_data_get_obj(obs_data_t *data, const char *name)
+{
+	const obs_data::Value *value = find(data, name);
+	if (!value || !value->object)
+		return nullptr;
+	obs_data_addref(value->object);
+	return value->object;
+}
+
+obs_data_array_t *obs_data_array_create()
+{
+	return new obs_data_array;
+}
+
+void obs_data_array_release(obs_data_array_t *array)
+{
+	if (!array || --array->refs > 0)
+		return;
+	for (obs_data_t *item : array->items)
+		obs_data_release(item);
+	delete array;
+}
+
+size_t obs_data_array_push_back(obs_data_array_t *array, obs_data_t *obj)
+{
+	if (!array || !obj)
+		return 0;
+	obs_data_addref(obj);
+	array->items.push_back(obj);
+	return array->items.size() - 1;
+}
+
+/* Properties */
+
+obs_properties_t *obs_properties_create(void)
+{
+	return new obs_properties;
+}
+
+void obs_properties_destroy(obs_properties_t *props)
+{
+	delete props;
+}
+
+obs_property_t *obs_properties_first(obs_properties_t *props)
+{
+	return props && !props->list.empty() ? props->list.front().get() : nullptr;
+}
+
+obs_property_t *obs_properties_get(obs_properties_t *props, const char *property)
+{
+	if (!props || !property)
+		return nullptr;
+	for (const auto &p : props->list) {
+		if (p->name == property)
+			return p.get();
+	}
+	return nullptr;
+}
+
+obs_property_t *obs_properties_add_bool(obs_properties_t *props, const char *name, const char *description)
+{
+	return add_property(props, name, description, OBS_PROPERTY_BOOL);
+}
+
+obs_property_t *obs_properties_add_int(obs_properties_t *props, const char *name, const char *description, int min,
+				       int max, int step)
+{
+	obs_property_t *p = add_property(props, name, description, OBS_PROPERTY_INT);
+	if (p) {
+		p->int_min = min;
+		p->int_max = max;
+		p->int_step = step;
+	}
+	return p;
+}
+
+obs_property_t *obs_properties_add_float(obs_properties_t *props, const char *name, const char *description,
+					 double min, double max, double step)
+{
+	obs_property_t *p = add_property(props, name, description, OBS_PROPERTY_FLOAT);
+	if (p) {
+		p->float_min = min;
+		p->float_max = max;
+		p->float_step = step;
+	}
+	return p;
+}
+
+obs_property_t *obs_properties_add_text(obs_properties_t *props, const char *name, const char *description,
+					enum obs_text_type)
+{
+	return add_property(props, name, description, OBS_PROPERTY_TEXT);
+}
+
+obs_property_t *obs_properties_add_path(obs_properties_t *props, const char *name, const char *description,
+					enum obs_path_type, const char *, const char *)
+{
+	return add_property(props, name, description, OBS_PROPERTY_PATH);
+}
+
+obs_property_t *obs_properties_add_list(obs_properties_t *props, const char *name, const char *description,
+					enum obs_combo_type type, enum obs_combo_format format)
+{
+	obs_property_t *p = add_property(props, name, description, OBS_PROPERTY_LIST);
+	if (p) {
+		p->combo_type = type;
+		p->combo_format = format;
+	}
+	return p;
+}
+
+obs_property_t *obs_properties_add_color(obs_properties_t *props, const char *name, const char *description)
+{
+	return add_property(props, name, description, OBS_PROPERTY_COLOR);
+}
+
+obs_property_t *obs_properties_add_font(obs_properties_t *props, const char *name, const char *description)
+{
+	return add_property(props, name, description, OBS_PROPERTY_FONT);
+}
+
+obs_property_t *obs_properties_add_button(obs_properties_t *props, const char *name, const char *text,
+					  obs_property_clicked_t callback)
+{
+	obs_property_t *p = add_property(props, name, text, OBS_PROPERTY_BUTTON);
+	if (p)
+		p->clicked = callback;
+	return p;
+}
+
+bool obs_property_next(obs_property_t **p)
+{
+	if (!p || !*p)
+		return false;
+	*p = (*p)->next;
+	return *p != nullptr;
+}
+
+const char *obs_property_name(obs_property_t *p)
+{
+	return p ? p->name.c_str() : nullptr;
+}
+
+const char *obs_property_description(obs_property_t *p)
+{
+	return p ? p->description.c_str() : nullptr;
+}
+
+enum obs_property_type obs_property_get_type(obs_property_t *p)
+{
+	return p ? p->type : OBS_PROPERTY_INVALID;
+}
+
+int obs_property_int_min(obs_property_t *p)
+{
+	return p ? p->int_min : 0;
+}
+
+int obs_property_int_max(obs_property_t *p)
+{
+	return p ? p->int_max : 0;
+}
+
+int obs_property_int_step(obs_property_t *p)
+{
+	return p ? p->int_step : 0;
+}
+
+double obs_property_float_min(obs_property_t *p)
+{
+	return p ? p->float_min : 0.0;
+}
+
+double obs_property_float_max(obs_property_t *p)
+{
+	return p ? p->float_max : 0.0;
+}
+
+double obs_property_float_step(obs_property_t *p)
+{
+	return p ? p->float_step : 0.0;
+}
+
+enum obs_combo_type obs_property_list_type(obs_property_t *p)
+{
+	return p ? p->combo_type : OBS_COMBO_TYPE_INVALID;
+}
+
+enum obs_combo_format obs_property_list_format(obs_property_t *p)
+{
+	return p ? p->combo_format : OBS_COMBO_FORMAT_INVALID;
+}
+
+size_t obs_property_list_add_string(obs_property_t *p, const char *name, const char *val)
+{
+	if (!p)
+		return 0;
+	p->items.emplace_back(name ? name : "", val ? val : "");
+	return p->items.size() - 1;
+}
+
+void obs_property_set_enabled(obs_property_t *p, bool enabled)
+{
+	if (p)
+		p->enabled = enabled;
+}
+
+void obs_property_set_description(obs_property_t *p, const char *description)
+{
+	if (p)
+		p->description = description ? description : "";
+}
+
+void obs_property_set_long_description(obs_property_t *p, const char *long_description)
+{
+	if (p)
+		p->long_description = long_description ? long_description : "";
+}
+
+void obs_property_float_set_suffix(obs_property_t *, const char *) {}
+
+} // extern "C"
@@ -0,0 +1,45 @@
+#ifndef OBS_STUB_H
+#define OBS_STUB_H
+
+// A thin stand-in for libobs, linked instead of it, so the plugin can run
+// headless. It keeps settings, sources, properties, procs, signals and audio
+// capture callbacks in memory and has no graphics or frontend; its only
+// hotkeys are the ones added with add_hotkey().
+// Sources of types the plugin did not register (text_ft2_source, the audio
+// sources created here) are inert: updating one merges its settings and emits
+// its "update" signal straight away, where OBS would defer both to the next
+// video frame. obs_queue_task runs the task on the calling thread.
+//
+// The harness drives what OBS would: the audio thread through push_audio(),
+// the graphics thread through video_tick(), the properties UI through click().
+
+#include <obs-module.h>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+namespace obs_stub {
+
+// What audio_output_get_info() reports; set before creating sources.
+void set_sample_rate(uint32_t samples_per_sec);
+// Directory obs_module_config_path() resolves into.
+void set_config_dir(const std::string &dir);
+
+// An input with OBS_SOURCE_AUDIO, for the plugin to capture from. Release it
+// with obs_source_release() like any other source.
+obs_source_t *create_audio_source(const char *name);
+// Runs the capture callbacks registered on source, as OBS's audio thread does.
+void push_audio(obs_source_t *source, const audio_data &data);
+
+// Calls the source type's video_tick.
+void video_tick(obs_source_t *source, float seconds);
+// Presses a button of the source's properties the way the properties dialog does.
+bool click(obs_source_t *source, const char *button);
+
+// A hotkey obs_enum_hotkeys() lists under name; obs_hotkey_trigger_routed_callback()
+// calls pressed with true and then false, on the caller's thread.
+void add_hotkey(const char *name, std::function<void(bool pressed)> pressed);
+
+} // namespace obs_stub
+
+#endif
@@ -0,0 +1,123 @@
+#include "plugin_harness.h"
+#include "obs_stub.h"
+#include <util/platform.h>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+extern "C" {
+bool obs_module_load(void);
+void obs_module_unload(void);
+}
+
+namespace plugin_harness {
+
+namespace {
+
+void on_text_update(void *data, calldata_t *cd)
+{
+	const uint64_t now = os_gettime_ns();
+	obs_data_t *settings = obs_source_get_settings(static_cast<obs_source_t *>(calldata_ptr(cd, "source")));
+	const std::string text = obs_data_get_string(settings, "text");
+	obs_data_release(settings);
+	static_cast<LatencyTracker *>(data)->shown(text, now);
+}
+
+void on_transcript_result(void *data, calldata_t *cd)
+{
+	const uint64_t now = os_gettime_ns();
+	const char *text = calldata_string(cd, "text");
+	static_cast<LatencyTracker *>(data)->signalled(text ? text : "", now);
+}
+
+// The plugin creates its text source inside asr_create, before the ASR source is announced
+void on_source_create(void *data, calldata_t *cd)
+{
+	auto *source = static_cast<obs_source_t *>(calldata_ptr(cd, "source"));
+	const char *id = obs_source_get_id(source);
+	if (strcmp(id, "text_ft2_source") == 0)
+		signal_handler_connect(obs_source_get_signal_handler(source), "update", on_text_update, data);
+	else if (strcmp(id, "asr_text_source") == 0)
+		signal_handler_connect(obs_source_get_signal_handler(source), "transcript_result", on_transcript_result,
+				       data);
+}
+
+} // namespace
+
+void load(const std::string &config_dir, const uint32_t sample_rate)
+{
+	obs_stub::set_config_dir(config_dir);
+	obs_stub::set_sample_rate(sample_rate);
+	obs_module_load();
+}
+
+void unload()
+{
+	obs_module_unload();
+}
+
+void track(LatencyTracker &tracker)
+{
+	signal_handler_connect(obs_get_signal_handler(), "source_create", on_source_create, &tracker);
+}
+
+obs_source_t *create_source(const char *name, const char *audio_source, const int port)
+{
+	obs_data_t *settings = obs_data_create();
+	obs_data_set_string(settings, "server_address", "127.0.0.1");
+	obs_data_set_int(settings, "server_port", port);
+	obs_data_set_string(settings, "audio_source", audio_source);
+	obs_data_set_bool(settings, "transcript_log", false);
+	obs_source_t *source = obs_source_create("asr_text_source", name, settings, nullptr);
+	// As if the properties dialog were confirmed: asr_update hooks the audio source
+	obs_source_update(source, settings);
+	obs_data_release(settings);
+	return source;
+}
+
+VideoThread::VideoThread(const int fps, const double speed) : thread_([this, fps, speed] { run(fps, speed); }) {}
+
+VideoThread::~VideoThread()
+{
+	running_ = false;
+	thread_.join();
+}
+
+void VideoThread::add(obs_source_t *source)
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	sources_.push_back(source);
+}
+
+void VideoThread::remove(obs_source_t *source)
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	sources_.erase(std::remove(sources_.begin(), sources_.end(), source), sources_.end());
+}
+
+LatencyHistogram VideoThread::takeFrameTimes()
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	LatencyHistogram times = frame_times_;
+	frame_times_.clear();
+	return times;
+}
+
+void VideoThread::run(const int fps, const double speed)
+{
+	const auto frame = std::chrono::nanoseconds(static_cast<int64_t>(1e9 / (fps * speed)));
+	auto next = std::chrono::steady_clock::now();
+	while (running_) {
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			const uint64_t start = os_gettime_ns();
+			for (obs_source_t *source : sources_)
+				obs_stub::video_tick(source, 1.0f / static_cast<float>(fps));
+			frame_times_.add(os_gettime_ns() - start);
+		}
+		next += frame;
+		std::this_thread::sleep_until(next);
+	}
+}
+
+} // namespace plugin_harness
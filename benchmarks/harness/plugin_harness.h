@@ -0,0 +1,55 @@
+#ifndef PLUGIN_HARNESS_H
+#define PLUGIN_HARNESS_H
+
+#include "latency_histogram.h"
+#include "latency_tracker.h"
+#include <obs-module.h>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// The plugin as the harness tools run it, on top of obs_stub.
+namespace plugin_harness {
+
+// Loads the plugin, with its files under config_dir and OBS audio at sample_rate.
+void load(const std::string &config_dir, uint32_t sample_rate);
+void unload();
+
+// Sends the results and caption updates of sources created from now on to tracker.
+void track(LatencyTracker &tracker);
+
+// An asr_text_source capturing from audio_source and set to stream to
+// 127.0.0.1:port, configured as a user would through its properties. Press
+// "connect_button" with obs_stub::click() to start it.
+obs_source_t *create_source(const char *name, const char *audio_source, int port);
+
+// Ticks sources at fps, as OBS's graphics thread does, timing each frame. At
+// speed > 1 frames come that many times faster, each still 1/fps seconds long,
+// to keep pace with audio played at the same speed.
+class VideoThread {
+public:
+	explicit VideoThread(int fps, double speed = 1.0);
+	VideoThread(const VideoThread &) = delete;
+	VideoThread &operator=(const VideoThread &) = delete;
+	~VideoThread();
+
+	void add(obs_source_t *source);
+	void remove(obs_source_t *source);
+	// Time spent ticking all sources, per frame, since the last call.
+	LatencyHistogram takeFrameTimes();
+
+private:
+	void run(int fps, double speed);
+
+	std::mutex mutex_;
+	std::vector<obs_source_t *> sources_;
+	LatencyHistogram frame_times_;
+	std::atomic<bool> running_{true};
+	std::thread thread_;
+};
+
+} // namespace plugin_harness
+
+#endif
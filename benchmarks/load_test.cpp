@@ -0,0 +1,339 @@
+// Multi-instance load test: N ASR sources capture the same audio source, as
+// when a scene has one captioned source per speaker or language, each with
+// its own resampler, chunker and gRPC stream to a scripted mock Sayo server.
+// The server runs in a child process, so the CPU time, threads, memory and
+// sockets measured are the plugin's alone. For each N the sources connect,
+// warm up, and run at real time for the measured period:
+//
+//   cpu/stream  process CPU time over wall time, divided by N
+//   threads     threads added since before the first source, and per stream
+//   rss         resident memory added since before the first source
+//   sockets     socket descriptors added since before the first source
+//   latency     a chunk's audio arriving to the caption update showing it, per word
+//   audio       time the capture callbacks of all N sources take per block
+//   tick        time video_tick of all N sources takes per frame
+//
+//   sayo-load-test [--streams 1,2,4,...] [--seconds N] [--script lines.txt]
+//                  [--processing-ms N] [--fps N] [--csv out.csv] [--verbose]
+
+#include <obs-module.h>
+#include <plugin-support.h>
+#include <cstdarg>
+#include <cstdio>
+
+namespace {
+
+bool verbose = false;
+
+} // namespace
+
+extern "C" {
+const char *PLUGIN_NAME = "sayo-load-test";
+const char *PLUGIN_VERSION = "";
+
+void obs_log(int log_level, const char *format, ...)
+{
+	if (!verbose && log_level > LOG_WARNING)
+		return;
+	va_list args;
+	va_start(args, format);
+	vfprintf(stderr, format, args);
+	va_end(args);
+	fputc('\n', stderr);
+}
+}
+
+#ifdef _WIN32
+
+int main()
+{
+	fprintf(stderr, "sayo-load-test needs fork and /proc; it runs on Linux only\n");
+	return 1;
+}
+
+#else
+
+#include "harness/audio_input.h"
+#include "harness/latency_histogram.h"
+#include "harness/latency_tracker.h"
+#include "harness/mock_sayo.h"
+#include "harness/obs_stub.h"
+#include "harness/plugin_harness.h"
+#include <util/platform.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstring>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace {
+
+constexpr uint32_t BLOCK_FRAMES = 1024; // AUDIO_OUTPUT_FRAMES
+constexpr uint32_t SAMPLE_RATE = 48000;
+constexpr char AUDIO_SOURCE[] = "Harness Audio";
+constexpr auto WARMUP = std::chrono::seconds(2);
+constexpr auto CONNECT_TIMEOUT = std::chrono::seconds(30);
+// A result not shown this long after the server read its chunk is lost
+constexpr uint64_t LOST_AFTER_NS = 5'000'000'000ull;
+
+const std::vector<std::string> DEFAULT_SCRIPT = {
+	"the", "quick", "brown fox", "", "jumps", "over the", "", "lazy dog", "", "",
+};
+
+struct Usage {
+	double cpu_s = 0;
+	double wall_s = 0;
+	size_t threads = 0;
+	size_t rss_kb = 0;
+	size_t sockets = 0;
+};
+
+Usage usage_now()
+{
+	Usage usage;
+	timespec ts{};
+	clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+	usage.cpu_s = static_cast<double>(ts.tv_sec) + static_cast<double>(ts.tv_nsec) / 1e9;
+	usage.wall_s = static_cast<double>(os_gettime_ns()) / 1e9;
+
+	std::error_code ec;
+	for (auto it = std::filesystem::directory_iterator("/proc/self/task", ec);
+	     !ec && it != std::filesystem::directory_iterator(); it.increment(ec))
+		++usage.threads;
+	for (auto it = std::filesystem::directory_iterator("/proc/self/fd", ec);
+	     !ec && it != std::filesystem::directory_iterator(); it.increment(ec)) {
+		std::error_code link_ec;
+		const std::string target = std::filesystem::read_symlink(it->path(), link_ec).string();
+		if (!link_ec && target.compare(0, 7, "socket:") == 0)
+			++usage.sockets;
+	}
+
+	std::ifstream statm("/proc/self/statm");
+	size_t pages = 0, resident = 0;
+	if (statm >> pages >> resident)
+		usage.rss_kb = resident * static_cast<size_t>(sysconf(_SC_PAGESIZE)) / 1024;
+	return usage;
+}
+
+size_t delta(const size_t now, const size_t base)
+{
+	return now > base ? now - base : 0;
+}
+
+bool parse_streams(const std::string &list, std::vector<int> &streams)
+{
+	streams.clear();
+	std::istringstream in(list);
+	for (std::string item; std::getline(in, item, ',');) {
+		const int n = atoi(item.c_str());
+		if (n <= 0)
+			return false;
+		streams.push_back(n);
+	}
+	return !streams.empty();
+}
+
+bool read_script(const std::string &path, std::vector<std::string> &script)
+{
+	std::ifstream file(path);
+	if (!file)
+		return false;
+	script.clear();
+	for (std::string line; std::getline(file, line);)
+		script.push_back(line);
+	return true;
+}
+
+int usage()
+{
+	fprintf(stderr, "usage: sayo-load-test [--streams 1,2,4,...] [--seconds N] [--script lines.txt]\n"
+			"                      [--processing-ms N] [--fps N] [--csv out.csv] [--verbose]\n");
+	return 2;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+	std::vector<int> steps = {1, 2, 4, 8, 16, 32, 64};
+	double seconds = 20.0;
+	std::vector<std::string> script = DEFAULT_SCRIPT;
+	int processing_ms = 0;
+	int fps = 60;
+	const char *csv_path = nullptr;
+	for (int i = 1; i < argc; ++i) {
+		if (!strcmp(argv[i], "--streams") && i + 1 < argc) {
+			if (!parse_streams(argv[++i], steps))
+				return usage();
+		} else if (!strcmp(argv[i], "--seconds") && i + 1 < argc) {
+			seconds = std::max(1.0, std::stod(argv[++i]));
+		} else if (!strcmp(argv[i], "--script") && i + 1 < argc) {
+			if (!read_script(argv[++i], script)) {
+				fprintf(stderr, "cannot read script %s\n", argv[i]);
+				return 1;
+			}
+		} else if (!strcmp(argv[i], "--processing-ms") && i + 1 < argc) {
+			processing_ms = std::stoi(argv[++i]);
+		} else if (!strcmp(argv[i], "--fps") && i + 1 < argc) {
+			fps = std::max(1, std::stoi(argv[++i]));
+		} else if (!strcmp(argv[i], "--csv") && i + 1 < argc) {
+			csv_path = argv[++i];
+		} else if (!strcmp(argv[i], "--verbose")) {
+			verbose = true;
+		} else {
+			return usage();
+		}
+	}
+
+	// Before anything in this process starts gRPC
+	int port = 0, timings_fd = -1;
+	const pid_t server = mock_sayo::spawn(script, std::chrono::milliseconds(processing_ms), port, timings_fd);
+	if (server < 0) {
+		fprintf(stderr, "cannot start the mock server\n");
+		return 1;
+	}
+
+	std::mutex latency_mutex;
+	LatencyHistogram latency;
+	LatencyTracker tracker([&](const LatencyTracker::Sample &sample) {
+		std::lock_guard<std::mutex> lock(latency_mutex);
+		latency.add(sample.total_ns, std::max<uint32_t>(1, sample.words));
+	});
+	std::thread timings([&tracker, timings_fd] {
+		mock_sayo::ChunkTiming timing{};
+		while (read(timings_fd, &timing, sizeof(timing)) == static_cast<ssize_t>(sizeof(timing)))
+			tracker.chunk(timing);
+	});
+
+	plugin_harness::load((std::filesystem::temp_directory_path() / "sayo-load-test").string(), SAMPLE_RATE);
+	plugin_harness::track(tracker);
+	obs_source_t *audio = obs_stub::create_audio_source(AUDIO_SOURCE);
+	auto video = std::make_unique<plugin_harness::VideoThread>(fps);
+
+	std::mutex audio_mutex;
+	LatencyHistogram audio_times;
+	std::atomic<bool> playing{true};
+	const AudioClip clip = synthetic_speech(30.0, SAMPLE_RATE);
+	std::thread player([&] {
+		play(clip, BLOCK_FRAMES, 1.0, [&](const audio_data &block, uint64_t) {
+			const uint64_t start = os_gettime_ns();
+			obs_stub::push_audio(audio, block);
+			std::lock_guard<std::mutex> lock(audio_mutex);
+			audio_times.add(os_gettime_ns() - start);
+			return playing.load();
+		});
+	});
+
+	std::this_thread::sleep_for(WARMUP);
+	const Usage base = usage_now();
+
+	FILE *csv = csv_path ? fopen(csv_path, "w") : nullptr;
+	if (csv)
+		fprintf(csv, "streams,cpu_pct_per_stream,threads,rss_kb,sockets,words,lost,"
+			     "latency_p50_ms,latency_p99_ms,latency_max_ms,audio_p99_ms,tick_p99_ms\n");
+	printf("%7s %11s %8s %8s %9s %8s %8s %6s %9s %9s %9s %9s %9s\n", "streams", "cpu/stream", "threads",
+	       "/stream", "rss MB", "sockets", "words", "lost", "p50 ms", "p99 ms", "max ms", "audio ms", "tick ms");
+
+	int status = 0;
+	std::vector<obs_source_t *> sources;
+	for (const int n : steps) {
+		const size_t streams_before = tracker.streams();
+		for (int i = 0; i < n; ++i) {
+			const std::string name = "ASR " + std::to_string(i + 1);
+			obs_source_t *source = plugin_harness::create_source(name.c_str(), AUDIO_SOURCE, port);
+			video->add(source);
+			obs_stub::click(source, "connect_button");
+			sources.push_back(source);
+		}
+
+		const auto deadline = std::chrono::steady_clock::now() + CONNECT_TIMEOUT;
+		while (tracker.streams() < streams_before + static_cast<size_t>(n) &&
+		       std::chrono::steady_clock::now() < deadline)
+			std::this_thread::sleep_for(std::chrono::milliseconds(20));
+		if (tracker.streams() < streams_before + static_cast<size_t>(n)) {
+			fprintf(stderr, "only %zu of %d sources streamed to the mock server\n",
+				tracker.streams() - streams_before, n);
+			status = 1;
+		} else {
+			std::this_thread::sleep_for(WARMUP);
+			tracker.expire(os_gettime_ns(), 0);
+			{
+				std::lock_guard<std::mutex> lock(latency_mutex);
+				latency.clear();
+			}
+			{
+				std::lock_guard<std::mutex> lock(audio_mutex);
+				audio_times.clear();
+			}
+			video->takeFrameTimes();
+			const Usage start = usage_now();
+			std::this_thread::sleep_for(std::chrono::duration<double>(seconds));
+			const Usage end = usage_now();
+			const size_t lost = tracker.expire(os_gettime_ns(), LOST_AFTER_NS);
+
+			LatencyHistogram step_latency, step_audio;
+			{
+				std::lock_guard<std::mutex> lock(latency_mutex);
+				step_latency = latency;
+			}
+			{
+				std::lock_guard<std::mutex> lock(audio_mutex);
+				step_audio = audio_times;
+			}
+			const LatencyHistogram ticks = video->takeFrameTimes();
+
+			const double cpu_pct = 100.0 * (end.cpu_s - start.cpu_s) / (end.wall_s - start.wall_s) / n;
+			const size_t threads = delta(end.threads, base.threads);
+			const double rss_mb = static_cast<double>(delta(end.rss_kb, base.rss_kb)) / 1024.0;
+			const size_t sockets = delta(end.sockets, base.sockets);
+			printf("%7d %10.2f%% %8zu %8.1f %9.1f %8zu %8llu %6zu %9.1f %9.1f %9.1f %9.3f %9.3f\n", n, cpu_pct,
+			       threads, static_cast<double>(threads) / n, rss_mb, sockets,
+			       static_cast<unsigned long long>(step_latency.count()), lost, step_latency.percentileMs(0.50),
+			       step_latency.percentileMs(0.99), step_latency.maxMs(), step_audio.percentileMs(0.99),
+			       ticks.percentileMs(0.99));
+			fflush(stdout);
+			if (csv)
+				fprintf(csv, "%d,%.3f,%zu,%zu,%zu,%llu,%zu,%.3f,%.3f,%.3f,%.3f,%.3f\n", n, cpu_pct, threads,
+					delta(end.rss_kb, base.rss_kb), sockets,
+					static_cast<unsigned long long>(step_latency.count()), lost,
+					step_latency.percentileMs(0.50), step_latency.percentileMs(0.99), step_latency.maxMs(),
+					step_audio.percentileMs(0.99), ticks.percentileMs(0.99));
+		}
+
+		for (obs_source_t *source : sources) {
+			video->remove(source);
+			obs_source_release(source);
+		}
+		sources.clear();
+		tracker.expire(os_gettime_ns(), 0);
+		if (status)
+			break;
+	}
+	if (csv)
+		fclose(csv);
+
+	playing = false;
+	player.join();
+	video.reset();
+	obs_source_release(audio);
+	plugin_harness::unload();
+
+	kill(server, SIGTERM);
+	waitpid(server, nullptr, 0);
+	timings.join();
+	close(timings_fd);
+	return status;
+}
+
+#endif
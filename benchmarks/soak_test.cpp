@@ -0,0 +1,413 @@
+// Soak test: streams synthetic speech through N ASR sources for hours of
+// simulated time against a mock Sayo server in a child process, with audio
+// and video running --speed times faster than real time. Every --sample-minutes
+// of simulated time it records:
+//
+//   rss            resident memory
+//   threads        threads of this process (detached connect threads included)
+//   sockets        socket descriptors
+//   allocations    operator new allocations not yet freed
+//   send_buffer    largest audio waiting to fill a chunk, bytes, summed over sources
+//   audio_queue    largest backlog of chunks waiting to be sent, summed over sources
+//   results_queue  largest backlog of results waiting for a tick, summed over sources
+//   latency p99    a chunk's audio arriving to the update showing it, real time
+//
+// Each --reconnect-minutes every source presses "connect_button" again, which
+// replaces its client from a detached thread. At the end the mean of the last
+// quarter of the samples is compared with the first quarter, skipping those
+// of the first --warmup-minutes; a metric that grew by more than --tolerance
+// percent, and by more than its floor, fails the run.
+//
+//   sayo-soak-test [--hours H] [--speed X] [--streams N] [--sample-minutes M]
+//                  [--warmup-minutes M] [--reconnect-minutes M] [--tolerance PCT]
+//                  [--processing-ms N] [--script lines.txt] [--csv out.csv] [--verbose]
+
+#include <obs-module.h>
+#include <plugin-support.h>
+#include <cstdarg>
+#include <cstdio>
+
+namespace {
+
+bool verbose = false;
+
+} // namespace
+
+extern "C" {
+const char *PLUGIN_NAME = "sayo-soak-test";
+const char *PLUGIN_VERSION = "";
+
+void obs_log(int log_level, const char *format, ...)
+{
+	if (!verbose && log_level > LOG_WARNING)
+		return;
+	va_list args;
+	va_start(args, format);
+	vfprintf(stderr, format, args);
+	va_end(args);
+	fputc('\n', stderr);
+}
+}
+
+#ifdef _WIN32
+
+int main()
+{
+	fprintf(stderr, "sayo-soak-test needs fork and /proc; it runs on Linux only\n");
+	return 1;
+}
+
+#else
+
+#include "harness/allocation_counter.h"
+#include "harness/audio_input.h"
+#include "harness/latency_histogram.h"
+#include "harness/latency_tracker.h"
+#include "harness/mock_sayo.h"
+#include "harness/obs_stub.h"
+#include "harness/plugin_harness.h"
+#include <util/platform.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace {
+
+constexpr uint32_t BLOCK_FRAMES = 1024; // AUDIO_OUTPUT_FRAMES
+constexpr uint32_t SAMPLE_RATE = 48000;
+constexpr int FPS = 60;
+constexpr char AUDIO_SOURCE[] = "Harness Audio";
+constexpr auto CONNECT_TIMEOUT = std::chrono::seconds(30);
+constexpr auto POLL = std::chrono::milliseconds(50);
+// A result not shown this long after the server read its chunk is lost
+constexpr uint64_t LOST_AFTER_NS = 5'000'000'000ull;
+
+const std::vector<std::string> DEFAULT_SCRIPT = {
+	"the", "quick", "brown fox", "", "jumps", "over the", "", "lazy dog", "", "",
+};
+
+enum Metric { RSS, THREADS, SOCKETS, ALLOCATIONS, SEND_BUFFER, AUDIO_QUEUE, RESULTS_QUEUE, LATENCY, METRICS };
+
+struct MetricInfo {
+	const char *name;
+	const char *unit;
+	double floor; // growth below this passes whatever the tolerance
+};
+
+constexpr MetricInfo METRIC_INFO[METRICS] = {
+	{"rss", "MB", 8.0},
+	{"threads", "", 2.0},
+	{"sockets", "", 2.0},
+	{"allocations", "", 2000.0},
+	{"send_buffer", "bytes", 6144.0}, // one chunk
+	{"audio_queue", "chunks", 4.0},
+	{"results_queue", "results", 4.0},
+	{"latency p99", "ms", 20.0},
+};
+
+struct Sample {
+	double hours = 0; // simulated
+	double values[METRICS] = {};
+	uint64_t words = 0;
+	size_t lost = 0;
+};
+
+size_t count_entries(const char *dir, const char *link_prefix)
+{
+	size_t count = 0;
+	std::error_code ec;
+	for (auto it = std::filesystem::directory_iterator(dir, ec); !ec && it != std::filesystem::directory_iterator();
+	     it.increment(ec)) {
+		if (!link_prefix) {
+			++count;
+			continue;
+		}
+		std::error_code link_ec;
+		const std::string target = std::filesystem::read_symlink(it->path(), link_ec).string();
+		if (!link_ec && target.compare(0, strlen(link_prefix), link_prefix) == 0)
+			++count;
+	}
+	return count;
+}
+
+double rss_mb()
+{
+	std::ifstream statm("/proc/self/statm");
+	size_t pages = 0, resident = 0;
+	if (!(statm >> pages >> resident))
+		return 0;
+	return static_cast<double>(resident) * static_cast<double>(sysconf(_SC_PAGESIZE)) / (1024.0 * 1024.0);
+}
+
+// Sums get_queue_depths over the sources
+void queue_depths(const std::vector<obs_source_t *> &sources, double depths[METRICS])
+{
+	for (obs_source_t *source : sources) {
+		calldata_t cd;
+		calldata_init(&cd);
+		if (proc_handler_call(obs_source_get_proc_handler(source), "get_queue_depths", &cd)) {
+			depths[SEND_BUFFER] += static_cast<double>(calldata_int(&cd, "send_buffer"));
+			depths[AUDIO_QUEUE] += static_cast<double>(calldata_int(&cd, "audio_queue"));
+			depths[RESULTS_QUEUE] += static_cast<double>(calldata_int(&cd, "results_queue"));
+		}
+		calldata_free(&cd);
+	}
+}
+
+double mean(const std::vector<Sample> &samples, const size_t from, const size_t to, const Metric metric)
+{
+	double sum = 0;
+	for (size_t i = from; i < to; ++i)
+		sum += samples[i].values[metric];
+	return to > from ? sum / static_cast<double>(to - from) : 0;
+}
+
+bool read_script(const std::string &path, std::vector<std::string> &script)
+{
+	std::ifstream file(path);
+	if (!file)
+		return false;
+	script.clear();
+	for (std::string line; std::getline(file, line);)
+		script.push_back(line);
+	return true;
+}
+
+int usage()
+{
+	fprintf(stderr, "usage: sayo-soak-test [--hours H] [--speed X] [--streams N] [--sample-minutes M]\n"
+			"                      [--warmup-minutes M] [--reconnect-minutes M] [--tolerance PCT]\n"
+			"                      [--processing-ms N] [--script lines.txt] [--csv out.csv] [--verbose]\n");
+	return 2;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+	double hours = 12.0;
+	double speed = 60.0;
+	int streams = 1;
+	double sample_minutes = 10.0;
+	double warmup_minutes = 30.0;
+	double reconnect_minutes = 60.0;
+	double tolerance = 10.0;
+	int processing_ms = 0;
+	std::vector<std::string> script = DEFAULT_SCRIPT;
+	const char *csv_path = nullptr;
+	for (int i = 1; i < argc; ++i) {
+		if (!strcmp(argv[i], "--hours") && i + 1 < argc) {
+			hours = std::stod(argv[++i]);
+		} else if (!strcmp(argv[i], "--speed") && i + 1 < argc) {
+			speed = std::max(1.0, std::stod(argv[++i]));
+		} else if (!strcmp(argv[i], "--streams") && i + 1 < argc) {
+			streams = std::max(1, std::stoi(argv[++i]));
+		} else if (!strcmp(argv[i], "--sample-minutes") && i + 1 < argc) {
+			sample_minutes = std::stod(argv[++i]);
+		} else if (!strcmp(argv[i], "--warmup-minutes") && i + 1 < argc) {
+			warmup_minutes = std::stod(argv[++i]);
+		} else if (!strcmp(argv[i], "--reconnect-minutes") && i + 1 < argc) {
+			reconnect_minutes = std::stod(argv[++i]);
+		} else if (!strcmp(argv[i], "--tolerance") && i + 1 < argc) {
+			tolerance = std::stod(argv[++i]);
+		} else if (!strcmp(argv[i], "--processing-ms") && i + 1 < argc) {
+			processing_ms = std::stoi(argv[++i]);
+		} else if (!strcmp(argv[i], "--script") && i + 1 < argc) {
+			if (!read_script(argv[++i], script)) {
+				fprintf(stderr, "cannot read script %s\n", argv[i]);
+				return 1;
+			}
+		} else if (!strcmp(argv[i], "--csv") && i + 1 < argc) {
+			csv_path = argv[++i];
+		} else if (!strcmp(argv[i], "--verbose")) {
+			verbose = true;
+		} else {
+			return usage();
+		}
+	}
+	if (sample_minutes <= 0 || hours * 60.0 < warmup_minutes + 4 * sample_minutes) {
+		fprintf(stderr, "--hours must cover --warmup-minutes and four samples of --sample-minutes\n");
+		return 2;
+	}
+
+	// Before anything in this process starts gRPC
+	int port = 0, timings_fd = -1;
+	const pid_t server = mock_sayo::spawn(script, std::chrono::milliseconds(processing_ms), port, timings_fd);
+	if (server < 0) {
+		fprintf(stderr, "cannot start the mock server\n");
+		return 1;
+	}
+
+	std::mutex latency_mutex;
+	LatencyHistogram latency;
+	LatencyTracker tracker([&](const LatencyTracker::Sample &sample) {
+		std::lock_guard<std::mutex> lock(latency_mutex);
+		latency.add(sample.total_ns, std::max<uint32_t>(1, sample.words));
+	});
+	std::thread timings([&tracker, timings_fd] {
+		mock_sayo::ChunkTiming timing{};
+		while (read(timings_fd, &timing, sizeof(timing)) == static_cast<ssize_t>(sizeof(timing)))
+			tracker.chunk(timing);
+	});
+
+	plugin_harness::load((std::filesystem::temp_directory_path() / "sayo-soak-test").string(), SAMPLE_RATE);
+	plugin_harness::track(tracker);
+	obs_source_t *audio = obs_stub::create_audio_source(AUDIO_SOURCE);
+	auto video = std::make_unique<plugin_harness::VideoThread>(FPS, speed);
+	std::vector<obs_source_t *> sources;
+	for (int i = 0; i < streams; ++i) {
+		const std::string name = "ASR " + std::to_string(i + 1);
+		obs_source_t *source = plugin_harness::create_source(name.c_str(), AUDIO_SOURCE, port);
+		video->add(source);
+		obs_stub::click(source, "connect_button");
+		sources.push_back(source);
+	}
+
+	std::atomic<bool> playing{true};
+	const AudioClip clip = synthetic_speech(30.0, SAMPLE_RATE);
+	std::thread player([&] {
+		play(clip, BLOCK_FRAMES, speed, [&](const audio_data &block, uint64_t) {
+			obs_stub::push_audio(audio, block);
+			return playing.load();
+		});
+	});
+
+	int status = 0;
+	const auto connect_deadline = std::chrono::steady_clock::now() + CONNECT_TIMEOUT;
+	while (tracker.streams() < static_cast<size_t>(streams) && std::chrono::steady_clock::now() < connect_deadline)
+		std::this_thread::sleep_for(std::chrono::milliseconds(20));
+	if (tracker.streams() < static_cast<size_t>(streams)) {
+		fprintf(stderr, "only %zu of %d sources streamed to the mock server\n", tracker.streams(), streams);
+		status = 1;
+	}
+
+	FILE *csv = csv_path ? fopen(csv_path, "w") : nullptr;
+	if (csv) {
+		fprintf(csv, "hours");
+		for (const MetricInfo &info : METRIC_INFO)
+			fprintf(csv, ",%s", info.name);
+		fprintf(csv, ",words,lost\n");
+	}
+	if (!status)
+		fprintf(stderr, "soaking %d source(s) for %.1f h at %.0fx: %.1f min of real time\n", streams, hours, speed,
+			hours * 60.0 / speed);
+	printf("%7s %8s %8s %8s %12s %12s %12s %14s %12s %8s %6s\n", "hours", "rss MB", "threads", "sockets",
+	       "allocations", "send_buffer", "audio_queue", "results_queue", "p99 ms", "words", "lost");
+
+	std::vector<Sample> samples;
+	const auto start = std::chrono::steady_clock::now();
+	const auto real = [speed](const double simulated_minutes) {
+		return std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+			std::chrono::duration<double>(simulated_minutes * 60.0 / speed));
+	};
+	const auto end = start + real(hours * 60.0);
+	auto next_sample = start + real(sample_minutes);
+	auto next_reconnect = reconnect_minutes > 0 ? start + real(reconnect_minutes) : end;
+	double depths[METRICS] = {};
+	while (!status && std::chrono::steady_clock::now() < end) {
+		std::this_thread::sleep_for(POLL);
+		double now_depths[METRICS] = {};
+		queue_depths(sources, now_depths);
+		for (const Metric metric : {SEND_BUFFER, AUDIO_QUEUE, RESULTS_QUEUE})
+			depths[metric] = std::max(depths[metric], now_depths[metric]);
+
+		const auto now = std::chrono::steady_clock::now();
+		if (now >= next_reconnect) {
+			for (obs_source_t *source : sources)
+				obs_stub::click(source, "connect_button");
+			next_reconnect += real(reconnect_minutes);
+		}
+		if (now < next_sample)
+			continue;
+		next_sample += real(sample_minutes);
+
+		Sample sample;
+		sample.hours = std::chrono::duration<double>(now - start).count() * speed / 3600.0;
+		sample.lost = tracker.expire(os_gettime_ns(), LOST_AFTER_NS);
+		LatencyHistogram interval;
+		{
+			std::lock_guard<std::mutex> lock(latency_mutex);
+			interval = latency;
+			latency.clear();
+		}
+		sample.words = interval.count();
+		sample.values[RSS] = rss_mb();
+		sample.values[THREADS] = static_cast<double>(count_entries("/proc/self/task", nullptr));
+		sample.values[SOCKETS] = static_cast<double>(count_entries("/proc/self/fd", "socket:"));
+		sample.values[ALLOCATIONS] = static_cast<double>(allocation_counter::live());
+		for (const Metric metric : {SEND_BUFFER, AUDIO_QUEUE, RESULTS_QUEUE})
+			sample.values[metric] = depths[metric];
+		sample.values[LATENCY] = interval.percentileMs(0.99);
+		std::fill(std::begin(depths), std::end(depths), 0.0);
+		samples.push_back(sample);
+
+		printf("%7.2f %8.1f %8.0f %8.0f %12.0f %12.0f %12.0f %14.0f %12.1f %8llu %6zu\n", sample.hours,
+		       sample.values[RSS], sample.values[THREADS], sample.values[SOCKETS], sample.values[ALLOCATIONS],
+		       sample.values[SEND_BUFFER], sample.values[AUDIO_QUEUE], sample.values[RESULTS_QUEUE],
+		       sample.values[LATENCY], static_cast<unsigned long long>(sample.words), sample.lost);
+		fflush(stdout);
+		if (csv) {
+			fprintf(csv, "%.3f", sample.hours);
+			for (const double value : sample.values)
+				fprintf(csv, ",%.3f", value);
+			fprintf(csv, ",%llu,%zu\n", static_cast<unsigned long long>(sample.words), sample.lost);
+		}
+	}
+	if (csv)
+		fclose(csv);
+
+	playing = false;
+	player.join();
+	video.reset();
+	for (obs_source_t *source : sources)
+		obs_source_release(source);
+	obs_source_release(audio);
+	plugin_harness::unload();
+	kill(server, SIGTERM);
+	waitpid(server, nullptr, 0);
+	timings.join();
+	close(timings_fd);
+	if (status)
+		return status;
+
+	// Warm-up holds start-up: connections, the resampler, histories and caches filling
+	const auto first = static_cast<size_t>(
+		std::count_if(samples.begin(), samples.end(),
+			      [warmup_minutes](const Sample &sample) { return sample.hours * 60.0 < warmup_minutes; }));
+	if (samples.size() < first + 4) {
+		fprintf(stderr, "too few samples after warm-up to judge a trend\n");
+		return 1;
+	}
+	const size_t quarter = (samples.size() - first) / 4;
+	printf("\n%-14s %12s %12s %12s %-8s\n", "", "early", "late", "limit", "");
+	for (int m = 0; m < METRICS; ++m) {
+		const auto metric = static_cast<Metric>(m);
+		const double early = mean(samples, first, first + quarter, metric);
+		const double late = mean(samples, samples.size() - quarter, samples.size(), metric);
+		const double limit = early + std::max(METRIC_INFO[m].floor, early * tolerance / 100.0);
+		const bool grew = late > limit;
+		printf("%-14s %12.1f %12.1f %12.1f %-8s %s\n", METRIC_INFO[m].name, early, late, limit,
+		       METRIC_INFO[m].unit, grew ? "GREW" : "ok");
+		if (grew)
+			status = 1;
+	}
+	size_t lost = 0;
+	for (const Sample &sample : samples)
+		lost += sample.lost;
+	if (lost)
+		printf("\n%zu results never shown\n", lost);
+	return status;
+}
+
+#endif
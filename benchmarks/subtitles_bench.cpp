@@ -0,0 +1,86 @@
+// Caption layout: SubtitlesBuffer's per-word path, reading the rendered
+// text, relayout on resize, and UAX #14 segmentation of mixed scripts.
+
+#include "bench_support.h"
+#include "harness/allocation_counter.h"
+#include "line_break.h"
+#include "subtitle_buffer.h"
+#include <benchmark/benchmark.h>
+#include <string>
+#include <vector>
+
+namespace {
+
+const std::vector<std::string> &vocabulary()
+{
+	static const std::vector<std::string> words = bench::words(4096);
+	return words;
+}
+
+void fill(SubtitlesBuffer &buffer, const size_t count)
+{
+	const auto &words = vocabulary();
+	for (size_t i = 0; i < count; ++i)
+		buffer.addWord(words[i % words.size()]);
+}
+
+void BM_AddWord(benchmark::State &state)
+{
+	const auto max_lines = static_cast<size_t>(state.range(0));
+	const auto max_chars = static_cast<size_t>(state.range(1));
+	SubtitlesBuffer buffer(max_lines, max_chars);
+	fill(buffer, 1024); // steady state: the history is full
+	const auto &words = vocabulary();
+	size_t next = 0;
+	const uint64_t allocations_before = allocation_counter::total();
+	for (auto _ : state) {
+		buffer.addWord(words[next]);
+		next = (next + 1) % words.size();
+	}
+	const uint64_t allocations = allocation_counter::total() - allocations_before;
+	state.SetItemsProcessed(state.iterations());
+	state.counters["allocs_per_word"] =
+		benchmark::Counter(static_cast<double>(allocations), benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_AddWord)->ArgNames({"lines", "chars"})->ArgsProduct({{1, 2, 4}, {32, 60, 100}});
+
+void BM_GetBufferContent(benchmark::State &state)
+{
+	SubtitlesBuffer buffer(static_cast<size_t>(state.range(0)), 60);
+	fill(buffer, 1024);
+	for (auto _ : state)
+		benchmark::DoNotOptimize(buffer.getBufferContent().data());
+}
+BENCHMARK(BM_GetBufferContent)->ArgName("lines")->Arg(2)->Arg(10);
+
+void BM_ChangeSize(benchmark::State &state)
+{
+	SubtitlesBuffer buffer(2, 60);
+	fill(buffer, static_cast<size_t>(state.range(0)));
+	bool wide = false;
+	for (auto _ : state) {
+		wide = !wide;
+		buffer.changeSize(wide ? 3 : 2, wide ? 80 : 40);
+		benchmark::DoNotOptimize(buffer.getBufferContent().data());
+	}
+}
+BENCHMARK(BM_ChangeSize)->ArgName("history_words")->Arg(16)->Arg(256)->Arg(4096);
+
+void BM_SegmentMixedScript(benchmark::State &state)
+{
+	const std::string text = bench::mixed_script_text(static_cast<size_t>(state.range(0)));
+	int64_t segments = 0;
+	for (auto _ : state) {
+		line_break::Segmenter segmenter(text);
+		line_break::Segment segment;
+		while (segmenter.next(segment)) {
+			benchmark::DoNotOptimize(segment.text.data());
+			++segments;
+		}
+	}
+	state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(text.size()));
+	state.counters["segments"] = benchmark::Counter(static_cast<double>(segments), benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_SegmentMixedScript)->ArgName("bytes")->Arg(64)->Arg(1024)->Arg(65536);
+
+} // namespace
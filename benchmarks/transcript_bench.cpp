@@ -0,0 +1,149 @@
+// Result-side text processing: the transcript index, keyword triggers and
+// profanity masking, all of which run once per result.
+
+#include "bench_support.h"
+#include "keyword_triggers.h"
+#include "profanity_filter.h"
+#include "transcript_index.h"
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr size_t RESULTS_PER_HOUR = 9000; // about 2.5 results a second of speech
+constexpr size_t WORDS_PER_RESULT = 6;
+
+std::vector<std::string> results(const size_t count, const uint32_t seed = 7)
+{
+	const std::vector<std::string> words = bench::words(count * WORDS_PER_RESULT, seed);
+	std::vector<std::string> out(count);
+	for (size_t i = 0; i < words.size(); ++i) {
+		std::string &result = out[i / WORDS_PER_RESULT];
+		if (!result.empty())
+			result += ' ';
+		result += words[i];
+	}
+	return out;
+}
+
+// Rebuilds an hour of results each iteration; memory is reported per hour
+void BM_TranscriptIndexHour(benchmark::State &state)
+{
+	const std::vector<std::string> hour = results(RESULTS_PER_HOUR);
+	size_t memory = 0;
+	for (auto _ : state) {
+		TranscriptIndex index;
+		uint64_t time_ns = 0;
+		for (const std::string &result : hour)
+			index.add(time_ns += 400000000, result);
+		memory = index.memoryUsage();
+	}
+	state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(hour.size()));
+	state.counters["bytes_per_hour"] = static_cast<double>(memory);
+}
+BENCHMARK(BM_TranscriptIndexHour)->Unit(benchmark::kMillisecond);
+
+void BM_TranscriptIndexSearch(benchmark::State &state)
+{
+	static TranscriptIndex index;
+	static const std::vector<std::string> session = results(3 * RESULTS_PER_HOUR);
+	if (index.resultCount() == 0) {
+		uint64_t time_ns = 0;
+		for (const std::string &result : session)
+			index.add(time_ns += 400000000, result);
+	}
+	// Queries made of words from results spread over the session
+	const auto terms = static_cast<size_t>(state.range(0));
+	std::vector<std::string> queries;
+	for (size_t i = 0; i < 64; ++i) {
+		const std::string &result = session[(i * 7919) % session.size()];
+		queries.push_back(result.substr(0, result.find(' ')));
+		for (size_t t = 1; t < terms; ++t)
+			queries.back() += " " + session[(i * 7919 + t) % session.size()].substr(0, 4);
+	}
+	size_t next = 0;
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(index.search(queries[next], 20));
+		next = (next + 1) % queries.size();
+	}
+}
+BENCHMARK(BM_TranscriptIndexSearch)->ArgName("terms")->Arg(1)->Arg(2)->Arg(3);
+
+// KeywordMatcher::feed on one result, as ReceiverLoop runs it. Only the
+// matching: a fired trigger then waits for the next video tick and the UI
+// task queue before it switches a scene or presses a hotkey, which takes up
+// to a frame longer and is not timed here.
+void BM_KeywordMatch(benchmark::State &state)
+{
+	const auto count = static_cast<size_t>(state.range(0));
+	const std::vector<std::string> phrases = results(count, 3);
+	std::string spec;
+	for (size_t i = 0; i < count; ++i)
+		spec += phrases[i].substr(0, phrases[i].find(' ', phrases[i].find(' ') + 1)) + " => hotkey: h" +
+			std::to_string(i) + "\n";
+	const auto triggers = KeywordTriggers::parse(spec);
+
+	// Every 16th result completes a phrase that started in the one before
+	std::vector<std::string> stream = results(1024, 11);
+	for (size_t i = 16; i < stream.size(); i += 16) {
+		const std::string &phrase = phrases[i % count];
+		const size_t space = phrase.find(' ');
+		stream[i - 1] += " " + phrase.substr(0, space);
+		stream[i] = phrase.substr(space + 1, phrase.find(' ', space + 1) - space - 1) + " " + stream[i];
+	}
+
+	KeywordMatcher matcher;
+	int64_t fired = 0;
+	size_t next = 0;
+	for (auto _ : state) {
+		matcher.feed(triggers, stream[next], [&](const KeywordTrigger &trigger) {
+			benchmark::DoNotOptimize(trigger.target.data());
+			++fired;
+		});
+		next = (next + 1) % stream.size();
+	}
+	state.SetItemsProcessed(state.iterations());
+	state.counters["fired"] = benchmark::Counter(static_cast<double>(fired), benchmark::Counter::kIsRate);
+	state.counters["states"] = static_cast<double>(triggers->automaton().stateCount());
+}
+BENCHMARK(BM_KeywordMatch)->ArgName("phrases")->Arg(10)->Arg(100)->Arg(1000);
+
+std::string word_list(const size_t count)
+{
+	std::string list;
+	for (const std::string &word : bench::words(count, 5))
+		list += word + "\n";
+	return list;
+}
+
+void BM_ProfanityMask(benchmark::State &state)
+{
+	const auto filter = ProfanityFilter::compile(word_list(static_cast<size_t>(state.range(0))));
+	const std::vector<std::string> stream = results(1024, 13);
+	size_t bytes = 0;
+	size_t next = 0;
+	for (auto _ : state) {
+		const std::string masked = filter->mask(stream[next]);
+		benchmark::DoNotOptimize(masked.data());
+		bytes += stream[next].size();
+		next = (next + 1) % stream.size();
+	}
+	state.SetBytesProcessed(static_cast<int64_t>(bytes));
+	state.SetItemsProcessed(state.iterations());
+	state.counters["memory_bytes"] = static_cast<double>(filter->automaton().memoryUsage());
+}
+BENCHMARK(BM_ProfanityMask)->ArgName("words")->Arg(100)->Arg(10000)->Arg(100000);
+
+// What a reload costs the UI thread before the swap
+void BM_ProfanityCompile(benchmark::State &state)
+{
+	const std::string list = word_list(static_cast<size_t>(state.range(0)));
+	for (auto _ : state)
+		benchmark::DoNotOptimize(ProfanityFilter::compile(list));
+	state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(list.size()));
+}
+BENCHMARK(BM_ProfanityCompile)->ArgName("words")->Arg(1000)->Arg(100000)->Unit(benchmark::kMillisecond);
+
+} // namespace
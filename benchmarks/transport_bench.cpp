@@ -0,0 +1,231 @@
+// Transport benchmark: ASRGrpcClient streaming to a SayoService in the same
+// process over an in-process channel, so it needs neither OBS nor a network.
+// Each chunk carries its send time in its first 8 bytes. The service uses it
+// to measure SendChunk-to-server latency, and echoes it in the results it
+// sends back, so the client can time the return path through ReceiverLoop.
+//
+// Arguments:
+//   streams        clients streaming at once
+//   samples        float samples per chunk (1536 = the plugin's 96 ms)
+//   window         chunks in flight before the sender waits; 1 measures
+//                  unloaded latency, larger values throughput
+//   respond_every  the service sends a result every this many chunks, 0 never
+//   processing_us  time the service spends on each chunk
+
+#include "server_gRPC/grpc_client.h"
+#include <benchmark/benchmark.h>
+#include <grpcpp/grpcpp.h>
+#include <plugin-support.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <ctime>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+extern "C" {
+const char *PLUGIN_NAME = "sayo-transport-benchmarks";
+const char *PLUGIN_VERSION = "";
+
+void obs_log(int, const char *, ...) {}
+}
+
+namespace {
+
+uint64_t now_ns()
+{
+	return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+					     std::chrono::steady_clock::now().time_since_epoch())
+					     .count());
+}
+
+// CPU time of the whole process: client and service threads alike
+uint64_t process_cpu_ns()
+{
+#ifdef _WIN32
+	return static_cast<uint64_t>(std::clock()) * (1000000000ull / CLOCKS_PER_SEC);
+#else
+	timespec ts{};
+	clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+	return static_cast<uint64_t>(ts.tv_sec) * 1000000000ull + static_cast<uint64_t>(ts.tv_nsec);
+#endif
+}
+
+double percentile_us(std::vector<uint64_t> &samples, const double p)
+{
+	if (samples.empty())
+		return 0.0;
+	const auto rank = static_cast<size_t>(p * static_cast<double>(samples.size() - 1));
+	std::nth_element(samples.begin(), samples.begin() + static_cast<std::ptrdiff_t>(rank), samples.end());
+	return static_cast<double>(samples[rank]) / 1000.0;
+}
+
+struct Behaviour {
+	int respond_every;
+	int processing_us;
+	size_t text_bytes;
+};
+
+class BenchService final : public sayo::SayoService::Service {
+public:
+	explicit BenchService(const Behaviour behaviour) : behaviour_(behaviour) {}
+
+	grpc::Status StreamingASR(grpc::ServerContext *,
+				  grpc::ServerReaderWriter<sayo::ASRResult, sayo::AudioChunk> *stream) override
+	{
+		sayo::AudioChunk chunk;
+		sayo::ASRResult result;
+		std::vector<uint64_t> latencies;
+		uint64_t count = 0;
+		while (stream->Read(&chunk)) {
+			uint64_t sent_ns = 0;
+			if (chunk.pcm().size() >= sizeof(sent_ns))
+				std::memcpy(&sent_ns, chunk.pcm().data(), sizeof(sent_ns));
+			latencies.push_back(now_ns() - sent_ns);
+
+			if (behaviour_.processing_us > 0)
+				std::this_thread::sleep_for(std::chrono::microseconds(behaviour_.processing_us));
+			if (behaviour_.respond_every > 0 && ++count % behaviour_.respond_every == 0) {
+				std::string text = std::to_string(sent_ns) + " ";
+				text.resize(std::max(text.size(), behaviour_.text_bytes), 'x');
+				result.set_text(text);
+				stream->Write(result);
+			}
+			{
+				std::lock_guard<std::mutex> lock(mutex_);
+				++received_;
+			}
+			cv_.notify_all();
+		}
+
+		std::lock_guard<std::mutex> lock(mutex_);
+		latencies_.insert(latencies_.end(), latencies.begin(), latencies.end());
+		return grpc::Status::OK;
+	}
+
+	grpc::Status Ping(grpc::ServerContext *, const sayo::PingRequest *, sayo::PingResponse *response) override
+	{
+		response->set_message("pong");
+		return grpc::Status::OK;
+	}
+
+	// Blocks until at least count chunks have arrived in total
+	void waitForReceived(const uint64_t count)
+	{
+		std::unique_lock<std::mutex> lock(mutex_);
+		cv_.wait(lock, [&] { return received_ >= count; });
+	}
+
+	// Send-to-read latencies of every chunk; complete once the streams have ended
+	std::vector<uint64_t> takeLatencies()
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		return std::move(latencies_);
+	}
+
+private:
+	const Behaviour behaviour_;
+	std::mutex mutex_;
+	std::condition_variable cv_;
+	uint64_t received_ = 0;
+	std::vector<uint64_t> latencies_;
+};
+
+void BM_Transport(benchmark::State &state)
+{
+	const auto streams = static_cast<size_t>(state.range(0));
+	const auto samples = std::max<size_t>(static_cast<size_t>(state.range(1)), 2);
+	const auto window = static_cast<uint64_t>(state.range(2)) * streams;
+	const Behaviour behaviour{static_cast<int>(state.range(3)), static_cast<int>(state.range(4)), 64};
+	constexpr uint64_t BATCH = 256; // chunks per stream per iteration
+
+	BenchService service(behaviour);
+	grpc::ServerBuilder builder;
+	builder.RegisterService(&service);
+	const std::unique_ptr<grpc::Server> server = builder.BuildAndStart();
+
+	std::vector<std::unique_ptr<ASRGrpcClient>> clients;
+	std::vector<std::vector<uint64_t>> result_latencies(streams);
+	for (size_t i = 0; i < streams; ++i) {
+		clients.push_back(std::make_unique<ASRGrpcClient>(server->InProcessChannel(grpc::ChannelArguments()), nullptr));
+		clients.back()->SetResultHandler([&latencies = result_latencies[i]](const std::string &text) {
+			latencies.push_back(now_ns() - std::stoull(text));
+			return text;
+		});
+		clients.back()->Start();
+	}
+
+	std::vector<char> chunk(samples * sizeof(float), 0);
+	uint64_t sent = 0;
+	bool failed = false;
+	const uint64_t cpu_before = process_cpu_ns();
+	for (auto _ : state) {
+		for (uint64_t n = 0; n < BATCH && !failed; ++n) {
+			for (const auto &client : clients) {
+				if (sent >= window)
+					service.waitForReceived(sent - window + 1);
+				const uint64_t stamp = now_ns();
+				std::memcpy(chunk.data(), &stamp, sizeof(stamp));
+				if (!client->SendChunk(chunk)) {
+					failed = true;
+					break;
+				}
+				++sent;
+			}
+		}
+		if (failed) {
+			state.SkipWithError("stream failed");
+			break;
+		}
+		service.waitForReceived(sent);
+		// Nothing ticks here to drain the results
+		for (const auto &client : clients) {
+			std::lock_guard<std::mutex> lock(client->queue_mutex);
+			client->asr_results_queue = {};
+		}
+	}
+	const uint64_t cpu = process_cpu_ns() - cpu_before;
+
+	for (const auto &client : clients)
+		client->Stop();
+	server->Shutdown();
+
+	std::vector<uint64_t> write_latencies = service.takeLatencies();
+	std::vector<uint64_t> read_latencies;
+	for (const auto &latencies : result_latencies)
+		read_latencies.insert(read_latencies.end(), latencies.begin(), latencies.end());
+
+	state.SetBytesProcessed(static_cast<int64_t>(sent * chunk.size()));
+	state.SetItemsProcessed(static_cast<int64_t>(sent));
+	state.counters["chunks_per_second"] = benchmark::Counter(static_cast<double>(sent), benchmark::Counter::kIsRate);
+	state.counters["write_p50_us"] = percentile_us(write_latencies, 0.50);
+	state.counters["write_p99_us"] = percentile_us(write_latencies, 0.99);
+	if (!read_latencies.empty()) {
+		state.counters["result_p50_us"] = percentile_us(read_latencies, 0.50);
+		state.counters["result_p99_us"] = percentile_us(read_latencies, 0.99);
+	}
+	if (sent > 0)
+		state.counters["cpu_us_per_chunk"] = static_cast<double>(cpu) / 1000.0 / static_cast<double>(sent);
+	// Cores busy per stream while streaming
+	state.counters["cpu_per_stream"] = benchmark::Counter(static_cast<double>(cpu) / 1e9 / static_cast<double>(streams),
+							      benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_Transport)
+	->ArgNames({"streams", "samples", "window", "respond_every", "processing_us"})
+	->Args({1, 1536, 1, 0, 0})
+	->Args({1, 1536, 64, 0, 0})
+	->Args({1, 16000, 64, 0, 0})
+	->Args({4, 1536, 64, 0, 0})
+	->Args({1, 1536, 1, 1, 0})
+	->Args({1, 1536, 64, 4, 0})
+	->Args({1, 1536, 16, 4, 500})
+	->UseRealTime()
+	->MeasureProcessCPUTime()
+	->Unit(benchmark::kMillisecond);
+
+} // namespace
@@ -0,0 +1,190 @@
+#!/usr/bin/env python3
+"""Generates src/line_break_table.h, the two-stage UAX #14 line break class lookup.
+
+With --ucd LineBreak.txt the classes are taken verbatim from the Unicode
+Character Database. Without it they are derived from the general category and
+East Asian width data bundled with Python's unicodedata plus the explicit
+overrides below, which covers every class the caption segmenter distinguishes.
+
+Usage: build-aux/gen-line-break-table.py [--ucd LineBreak.txt] [-o src/line_break_table.h]
+"""
+
+import argparse
+import sys
+import unicodedata
+
+# Must match line_break::BreakClass in src/line_break.h
+CLASSES = [
+    "AL", "BA", "BB", "B2", "BK", "CB", "CJ", "CL", "CM", "CP", "CR", "EB", "EM", "EX",
+    "GL", "H2", "H3", "HL", "HY", "ID", "IN", "IS", "JL", "JT", "JV", "LF", "NL", "NS",
+    "NU", "OP", "PO", "PR", "QU", "RI", "SA", "SP", "SY", "WJ", "ZW", "ZWJ",
+]
+# LB1: ambiguous, surrogate and unassigned code points resolve to AL
+RESOLVED = {"AI": "AL", "SG": "AL", "XX": "AL"}
+
+LIMIT = 0x40000  # planes 0-3; everything above resolves to AL
+BLOCK = 128
+
+ASCII = (
+    "CM CM CM CM CM CM CM CM CM BA LF BK BK CR CM CM "
+    "CM CM CM CM CM CM CM CM CM CM CM CM CM CM CM CM "
+    "SP EX QU AL PR PO AL QU OP CP AL PR IS HY IS SY "
+    "NU NU NU NU NU NU NU NU NU NU IS IS AL AL AL EX "
+    "AL AL AL AL AL AL AL AL AL AL AL AL AL AL AL AL "
+    "AL AL AL AL AL AL AL AL AL AL AL OP PR CP AL AL "
+    "AL AL AL AL AL AL AL AL AL AL AL AL AL AL AL AL "
+    "AL AL AL AL AL AL AL AL AL AL AL OP BA CL AL CM"
+).split()
+
+OVERRIDES = {
+    0x0085: "NL", 0x00A0: "GL", 0x00A1: "OP", 0x00A2: "PO", 0x00A3: "PR", 0x00A4: "PR",
+    0x00A5: "PR", 0x00AB: "QU", 0x00AD: "BA", 0x00B0: "PO", 0x00B1: "PR", 0x00B4: "BB",
+    0x00BB: "QU", 0x00BF: "OP", 0x034F: "GL", 0x1680: "BA", 0x180E: "GL", 0x2007: "GL",
+    0x200B: "ZW", 0x200D: "ZWJ", 0x2010: "BA", 0x2011: "GL", 0x2012: "BA", 0x2013: "BA",
+    0x2014: "B2", 0x2018: "QU", 0x2019: "QU", 0x201C: "QU", 0x201D: "QU", 0x2024: "IN",
+    0x2025: "IN", 0x2026: "IN", 0x2027: "BA", 0x2028: "BK", 0x2029: "BK", 0x202F: "GL",
+    0x2030: "PO", 0x2031: "PO", 0x2060: "WJ", 0x20AC: "PR", 0x2116: "PR", 0x2212: "PR",
+    0x3000: "BA", 0x3001: "CL", 0x3002: "CL", 0x3005: "NS", 0x303B: "NS", 0x309D: "NS",
+    0x309E: "NS", 0x30A0: "NS", 0x30FB: "NS", 0x30FC: "CJ", 0x30FD: "NS", 0x30FE: "NS",
+    0xFE50: "CL", 0xFE52: "CL", 0xFEFF: "WJ", 0xFF01: "EX", 0xFF05: "PO", 0xFF04: "PR",
+    0xFF0C: "CL", 0xFF0E: "CL", 0xFF1A: "NS", 0xFF1B: "NS", 0xFF1F: "EX", 0xFF61: "CL",
+    0xFF64: "CL", 0xFF65: "NS", 0xFF70: "CJ",
+}
+
+SMALL_KANA = [
+    0x3041, 0x3043, 0x3045, 0x3047, 0x3049, 0x3063, 0x3083, 0x3085, 0x3087, 0x308E,
+    0x3095, 0x3096, 0x30A1, 0x30A3, 0x30A5, 0x30A7, 0x30A9, 0x30C3, 0x30E3, 0x30E5,
+    0x30E7, 0x30EE, 0x30F5, 0x30F6,
+] + list(range(0x31F0, 0x3200)) + list(range(0xFF67, 0xFF70))
+
+ID_RANGES = [
+    (0x2E80, 0x2FFF), (0x3040, 0x30FF), (0x3130, 0x33FF), (0x3400, 0x4DBF),
+    (0x4E00, 0x9FFF), (0xA000, 0xA4CF), (0xF900, 0xFAFF), (0xFE30, 0xFE4F),
+    (0xFF00, 0xFF60), (0xFF66, 0xFF9F), (0x1F000, 0x1FAFF), (0x20000, 0x3FFFD),
+]
+SA_RANGES = [
+    (0x0E00, 0x0EFF), (0x1000, 0x109F), (0x1780, 0x17FF), (0x1950, 0x19DF),
+    (0x1A20, 0x1AAF), (0xAA60, 0xAADF),
+]
+
+
+def in_ranges(cp, ranges):
+    return any(lo <= cp <= hi for lo, hi in ranges)
+
+
+def derive(cp):
+    if cp < 0x80:
+        return ASCII[cp]
+    if cp in OVERRIDES:
+        return OVERRIDES[cp]
+    if cp in SMALL_KANA:
+        return "CJ"
+    if 0xAC00 <= cp <= 0xD7A3:
+        return "H2" if (cp - 0xAC00) % 28 == 0 else "H3"
+    if 0x1100 <= cp <= 0x115F or 0xA960 <= cp <= 0xA97C:
+        return "JL"
+    if 0x1160 <= cp <= 0x11A7 or 0xD7B0 <= cp <= 0xD7C6:
+        return "JV"
+    if 0x11A8 <= cp <= 0x11FF or 0xD7CB <= cp <= 0xD7FB:
+        return "JT"
+    if 0x1F1E6 <= cp <= 0x1F1FF:
+        return "RI"
+    if 0x1F3FB <= cp <= 0x1F3FF:
+        return "EM"
+    if 0x05D0 <= cp <= 0x05EA or 0xFB1D <= cp <= 0xFB4F:
+        return "HL"
+
+    cat = unicodedata.category(chr(cp))
+    if cat in ("Mn", "Mc", "Me", "Cc", "Cf"):
+        return "CM"
+    if in_ranges(cp, SA_RANGES):
+        return "SA"
+    if cat == "Ps":
+        return "OP"
+    if cat == "Pe":
+        return "CL"
+    if cat in ("Pi", "Pf"):
+        return "QU"
+    if in_ranges(cp, ID_RANGES):
+        return "ID"
+    if cat == "Zs":
+        return "BA"
+    if cat == "Nd":
+        return "NU"
+    if cat == "Sc":
+        return "PR"
+    if unicodedata.east_asian_width(chr(cp)) in ("W", "F") and cat in ("Lo", "So", "Cn"):
+        return "ID"
+    return "AL"
+
+
+def load_ucd(path):
+    classes = {}
+    with open(path, encoding="utf-8") as ucd:
+        for line in ucd:
+            line = line.split("#", 1)[0].strip()
+            if not line:
+                continue
+            cps, cls = (part.strip() for part in line.split(";"))
+            lo, _, hi = cps.partition("..")
+            for cp in range(int(lo, 16), int(hi or lo, 16) + 1):
+                if cp < LIMIT:
+                    classes[cp] = cls
+    return classes
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--ucd", help="path to LineBreak.txt")
+    parser.add_argument("-o", "--output", default="src/line_break_table.h")
+    args = parser.parse_args()
+
+    ucd = load_ucd(args.ucd) if args.ucd else None
+    index = {name: i for i, name in enumerate(CLASSES)}
+
+    values = []
+    for cp in range(LIMIT):
+        cls = ucd.get(cp, "ID" if in_ranges(cp, ID_RANGES) else "XX") if ucd else derive(cp)
+        cls = RESOLVED.get(cls, cls)
+        values.append(index.get(cls, index["AL"]))
+
+    blocks, stage1, stage2 = {}, [], []
+    for start in range(0, LIMIT, BLOCK):
+        block = tuple(values[start:start + BLOCK])
+        if block not in blocks:
+            blocks[block] = len(blocks)
+            stage2.extend(block)
+        stage1.append(blocks[block])
+
+    source = f"LineBreak.txt ({args.ucd})" if args.ucd else \
+        f"Unicode {unicodedata.unidata_version} categories (Python unicodedata) and overrides"
+    out = [
+        "// Generated by build-aux/gen-line-break-table.py. DO NOT EDIT!",
+        f"// source: {source}",
+        "",
+        "#ifndef LINE_BREAK_TABLE_H",
+        "#define LINE_BREAK_TABLE_H",
+        "",
+        "#include <cstdint>",
+        "",
+        "namespace line_break::table {",
+        "",
+        f"constexpr char32_t LIMIT = 0x{LIMIT:X};",
+        f"constexpr unsigned BLOCK_SHIFT = {BLOCK.bit_length() - 1};",
+        "",
+        f"constexpr {'uint8_t' if len(blocks) <= 256 else 'uint16_t'} stage1[{len(stage1)}] = {{",
+    ]
+    for i in range(0, len(stage1), 16):
+        out.append("\t" + ", ".join(str(v) for v in stage1[i:i + 16]) + ",")
+    out += ["};", "", f"constexpr uint8_t stage2[{len(stage2)}] = {{"]
+    for i in range(0, len(stage2), 32):
+        out.append("\t" + ", ".join(str(v) for v in stage2[i:i + 32]) + ",")
+    out += ["};", "", "} // namespace line_break::table", "", "#endif", ""]
+
+    with open(args.output, "w", encoding="utf-8") as header:
+        header.write("\n".join(out))
+    print(f"{args.output}: {len(stage1)} stage-1 entries, {len(blocks)} unique blocks", file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()
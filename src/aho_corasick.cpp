@@ -0,0 +1,87 @@
+#include "aho_corasick.h"
+#include <algorithm>
+#include <map>
+
+AhoCorasick::AhoCorasick(const std::vector<std::string> &patterns)
+{
+	// Build the trie with ordered child maps, then flatten it
+	std::vector<std::map<uint8_t, uint32_t>> children(1);
+	states_.push_back(State{0, 0, ROOT, NONE, NONE, 0});
+	lengths_.reserve(patterns.size());
+	for (uint32_t index = 0; index < patterns.size(); ++index) {
+		const std::string &pattern = patterns[index];
+		lengths_.push_back(static_cast<uint32_t>(pattern.size()));
+		if (pattern.empty())
+			continue;
+		uint32_t state = ROOT;
+		for (const char c : pattern) {
+			const auto byte = static_cast<uint8_t>(c);
+			const auto it = children[state].find(byte);
+			if (it != children[state].end()) {
+				state = it->second;
+				continue;
+			}
+			const auto next = static_cast<uint32_t>(states_.size());
+			children[state].emplace(byte, next);
+			children.emplace_back();
+			states_.push_back(State{0, 0, ROOT, NONE, NONE, states_[state].depth + 1});
+			state = next;
+		}
+		if (states_[state].pattern == NONE)
+			states_[state].pattern = index;
+	}
+
+	for (uint32_t state = 0; state < states_.size(); ++state) {
+		states_[state].first_edge = static_cast<uint32_t>(edges_.size());
+		states_[state].edge_count = static_cast<uint32_t>(children[state].size());
+		for (const auto &[byte, target] : children[state])
+			edges_.push_back(Edge{byte, target});
+	}
+	root_.fill(ROOT);
+	for (const auto &[byte, target] : children[ROOT])
+		root_[byte] = target;
+
+	// Failure links breadth-first, so every state's link is final before its children use it
+	std::vector<uint32_t> queue;
+	queue.reserve(states_.size());
+	for (const auto &[byte, target] : children[ROOT])
+		queue.push_back(target);
+	for (size_t head = 0; head < queue.size(); ++head) {
+		const uint32_t state = queue[head];
+		for (const auto &[byte, target] : children[state]) {
+			const uint32_t fail = step(states_[state].fail, byte);
+			states_[target].fail = fail;
+			states_[target].output = states_[fail].pattern != NONE ? fail : states_[fail].output;
+			queue.push_back(target);
+		}
+	}
+}
+
+uint32_t AhoCorasick::step(uint32_t state, const uint8_t byte) const
+{
+	while (state != ROOT) {
+		const State &s = states_[state];
+		const Edge *begin = edges_.data() + s.first_edge;
+		const Edge *end = begin + s.edge_count;
+		const Edge *it = std::lower_bound(begin, end, byte, [](const Edge &edge, uint8_t b) { return edge.byte < b; });
+		if (it != end && it->byte == byte)
+			return it->target;
+		state = s.fail;
+	}
+	return root_[byte];
+}
+
+size_t AhoCorasick::openLength(uint32_t state) const
+{
+	for (; state != ROOT; state = states_[state].fail) {
+		if (states_[state].edge_count)
+			return states_[state].depth;
+	}
+	return 0;
+}
+
+size_t AhoCorasick::memoryUsage() const
+{
+	return states_.capacity() * sizeof(State) + edges_.capacity() * sizeof(Edge) + sizeof(root_) +
+	       lengths_.capacity() * sizeof(uint32_t);
+}
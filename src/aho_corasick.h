@@ -0,0 +1,65 @@
+#ifndef AHO_CORASICK_H
+#define AHO_CORASICK_H
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Byte-level Aho–Corasick automaton over a fixed set of patterns. Matching is
+// a state carried from byte to byte, so a text can arrive in any number of
+// pieces and a pattern spanning two of them is still found; the work per
+// byte is amortised constant however many patterns there are.
+//
+// The root has a full transition table, since most bytes of running text
+// lead back to it; other states keep their edges sorted in one flat array
+// and fall back along failure links.
+class AhoCorasick {
+public:
+	static constexpr uint32_t ROOT = 0;
+	static constexpr uint32_t NONE = UINT32_MAX;
+
+	// Empty patterns are ignored; a repeated pattern reports its first index.
+	explicit AhoCorasick(const std::vector<std::string> &patterns = {});
+
+	[[nodiscard]] uint32_t step(uint32_t state, uint8_t byte) const;
+
+	// Calls fn(pattern index) for every pattern ending at state, longest first.
+	template<typename Fn> void matches(uint32_t state, Fn &&fn) const
+	{
+		if (states_[state].pattern == NONE)
+			state = states_[state].output;
+		for (; state != NONE; state = states_[state].output)
+			fn(states_[state].pattern);
+	}
+
+	// Length of the longest suffix of the text so far that some pattern goes on
+	// from, so a match may still end in text yet to come; 0 when there is none.
+	[[nodiscard]] size_t openLength(uint32_t state) const;
+
+	[[nodiscard]] size_t patternLength(const uint32_t pattern) const { return lengths_[pattern]; }
+	[[nodiscard]] size_t patternCount() const { return lengths_.size(); }
+	[[nodiscard]] size_t stateCount() const { return states_.size(); }
+	[[nodiscard]] size_t memoryUsage() const;
+
+private:
+	struct Edge {
+		uint8_t byte;
+		uint32_t target;
+	};
+	struct State {
+		uint32_t first_edge;
+		uint32_t edge_count;
+		uint32_t fail;
+		uint32_t pattern; // ending here, NONE if none
+		uint32_t output;  // nearest state along the failure links that ends a pattern
+		uint32_t depth;   // bytes from the root
+	};
+
+	std::vector<State> states_;
+	std::vector<Edge> edges_;
+	std::array<uint32_t, 256> root_{};
+	std::vector<uint32_t> lengths_;
+};
+
+#endif
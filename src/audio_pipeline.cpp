@@ -0,0 +1,75 @@
+#include "audio_pipeline.h"
+#include <cstdint>
+#include <cstring>
+
+namespace audio_pipeline {
+
+void downmix(const float *const *planes, const size_t channels, const size_t frames, std::vector<float> &out)
+{
+	out.resize(frames);
+	if (channels == 0)
+		return;
+	std::memcpy(out.data(), planes[0], frames * sizeof(float));
+	if (channels == 1)
+		return;
+
+	for (size_t channel = 1; channel < channels; ++channel) {
+		const float *plane = planes[channel];
+		for (size_t i = 0; i < frames; ++i)
+			out[i] += plane[i];
+	}
+	const float scale = 1.0f / static_cast<float>(channels);
+	for (size_t i = 0; i < frames; ++i)
+		out[i] *= scale;
+}
+
+bool is_empty_chunk(const float *buffer, const size_t frames)
+{
+	if (frames == 0)
+		return true;
+	// The first sample is all zero bits and every sample equals the one before it
+	uint32_t first;
+	std::memcpy(&first, buffer, sizeof(first));
+	return first == 0 && std::memcmp(buffer, buffer + 1, (frames - 1) * sizeof(float)) == 0;
+}
+
+size_t resample_audio(SRC_STATE *resampler, const double ratio, const float *in, const size_t in_frames,
+		      std::vector<float> &out, int &error)
+{
+	const size_t max_out_frames = static_cast<size_t>(static_cast<double>(in_frames) * ratio) + 1;
+	if (out.size() < max_out_frames)
+		out.resize(max_out_frames);
+
+	SRC_DATA src_data;
+	src_data.data_in = in;
+	src_data.input_frames = static_cast<long>(in_frames);
+	src_data.data_out = out.data();
+	src_data.output_frames = static_cast<long>(max_out_frames);
+	src_data.src_ratio = ratio;
+	src_data.end_of_input = 0;
+
+	error = src_process(resampler, &src_data);
+	if (error != 0)
+		return 0;
+	return static_cast<size_t>(src_data.output_frames_gen);
+}
+
+void cut_chunks(std::vector<char> &pending, const char *data, const size_t size, const size_t chunk_size,
+		const std::function<void(const std::vector<char> &chunk)> &fn)
+{
+	pending.insert(pending.end(), data, data + size);
+	if (pending.size() < chunk_size)
+		return;
+
+	// One erase for all the chunks taken, not one per chunk
+	std::vector<char> chunk;
+	size_t offset = 0;
+	for (; pending.size() - offset >= chunk_size; offset += chunk_size) {
+		chunk.assign(pending.begin() + static_cast<std::ptrdiff_t>(offset),
+			     pending.begin() + static_cast<std::ptrdiff_t>(offset + chunk_size));
+		fn(chunk);
+	}
+	pending.erase(pending.begin(), pending.begin() + static_cast<std::ptrdiff_t>(offset));
+}
+
+} // namespace audio_pipeline
@@ -0,0 +1,33 @@
+#ifndef AUDIO_PIPELINE_H
+#define AUDIO_PIPELINE_H
+
+#include <samplerate.h>
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+// The steps between OBS's audio callback and the gRPC stream: downmix the
+// planar input to mono, skip digital silence, resample to the server rate
+// and cut the result into fixed-size chunks. Nothing here touches OBS, so
+// the benchmarks can run the same code the plugin does.
+namespace audio_pipeline {
+
+// Averages the first channels planes into out, which is resized to frames.
+void downmix(const float *const *planes, size_t channels, size_t frames, std::vector<float> &out);
+
+// True when every sample is +0.0f, which OBS delivers for sources with nothing playing.
+bool is_empty_chunk(const float *buffer, size_t frames);
+
+// Resamples in at ratio into out, growing it as needed. Returns the frames
+// produced; on failure returns 0 and sets error to the libsamplerate code.
+size_t resample_audio(SRC_STATE *resampler, double ratio, const float *in, size_t in_frames,
+		      std::vector<float> &out, int &error);
+
+// Appends size bytes of data to pending and passes each complete chunk of
+// chunk_size bytes to fn, oldest first. The rest stays pending.
+void cut_chunks(std::vector<char> &pending, const char *data, size_t size, size_t chunk_size,
+		const std::function<void(const std::vector<char> &chunk)> &fn);
+
+} // namespace audio_pipeline
+
+#endif
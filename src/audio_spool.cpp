@@ -0,0 +1,336 @@
+#include "audio_spool.h"
+#include <obs-module.h>
+#include <plugin-support.h>
+#include <util/platform.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+namespace {
+
+// Each chunk is stored as its length, its capture time and the PCM bytes.
+// The rest of a segment is zeroes, so a zero length ends it.
+struct ChunkHeader {
+	uint32_t length;
+	uint32_t sent; // set by pop(), so a spool taking the segment over skips it
+	uint64_t time_ns;
+};
+
+} // namespace
+
+AudioSpool::AudioSpool(std::string dir) : dir_(std::move(dir)), worker_(std::make_unique<BackgroundWorker>())
+{
+	// Segments a previous spool left here; new ones are numbered after them
+	std::vector<uint64_t> found;
+	if (os_dir_t *dir = os_opendir(dir_.c_str())) {
+		while (const os_dirent *entry = os_readdir(dir)) {
+			unsigned long long index;
+			char extra;
+			if (!entry->directory && sscanf(entry->d_name, "%llu.spool%c", &index, &extra) == 1)
+				found.push_back(index);
+		}
+		os_closedir(dir);
+	}
+	if (found.empty())
+		return;
+	std::sort(found.begin(), found.end());
+	next_index_ = found.back() + 1;
+	// Reading them touches every page, so it is left to the worker, ahead of any segment made there
+	worker_->post([this, found] { adopt(found); });
+}
+
+AudioSpool::~AudioSpool()
+{
+	// Lets a segment being made arrive
+	worker_.reset();
+	std::lock_guard<std::mutex> lock(mutex_);
+	if (!pending_.empty())
+		obs_log(LOG_WARNING, "Audio spool: %zu chunks (%zu bytes) never reached a segment and are lost",
+			pending_.size(), pending_bytes_);
+	// Unsent audio stays on disk for the next spool in dir_; the rest is deleted
+	uint64_t kept_bytes = 0;
+	size_t kept = 0;
+	for (std::unique_ptr<Segment> &segment : segments_) {
+		if (segment->read_pos < segment->write_pos) {
+			kept_bytes += segment->write_pos - segment->read_pos;
+			++kept;
+		} else {
+			retire(std::move(segment));
+		}
+	}
+	segments_.clear();
+	retire(std::move(spare_));
+	if (kept)
+		obs_log(LOG_INFO, "Audio spool: %llu bytes in %zu segments kept in <%s> for the next session",
+			static_cast<unsigned long long>(kept_bytes), kept, dir_.c_str());
+}
+
+std::string AudioSpool::path(const uint64_t index) const
+{
+	char name[32];
+	snprintf(name, sizeof(name), "/%06llu.spool", static_cast<unsigned long long>(index));
+	return dir_ + name;
+}
+
+std::unique_ptr<AudioSpool::Segment> AudioSpool::makeSegment(const uint64_t index) const
+{
+	os_mkdirs(dir_.c_str());
+	auto segment = std::make_unique<Segment>();
+	segment->index = index;
+	segment->path = path(index);
+	if (!segment->file.open(segment->path, true) || !segment->file.resize(SEGMENT_SIZE)) {
+		segment->file.close();
+		std::remove(segment->path.c_str());
+		return nullptr;
+	}
+	segment->region = segment->file.map(0, SEGMENT_SIZE);
+	if (!segment->region) {
+		segment->file.close();
+		std::remove(segment->path.c_str());
+		return nullptr;
+	}
+	return segment;
+}
+
+// A segment file left by an earlier spool, with its chunks found again; null
+// when it cannot be mapped
+std::unique_ptr<AudioSpool::Segment> AudioSpool::openSegment(const uint64_t index) const
+{
+	auto segment = std::make_unique<Segment>();
+	segment->index = index;
+	segment->path = path(index);
+	if (!segment->file.open(segment->path, true) || segment->file.size() < SEGMENT_SIZE)
+		return nullptr;
+	segment->region = segment->file.map(0, SEGMENT_SIZE);
+	if (!segment->region)
+		return nullptr;
+
+	// Sent chunks are the leading ones: the spool is read in order
+	uint32_t pos = 0;
+	while (pos + sizeof(ChunkHeader) <= SEGMENT_SIZE) {
+		ChunkHeader header;
+		std::memcpy(&header, segment->region.data() + pos, sizeof(header));
+		if (header.length == 0 || header.length > SEGMENT_SIZE - pos - sizeof(header))
+			break;
+		pos += static_cast<uint32_t>(sizeof(header) + header.length);
+		if (header.sent && segment->read_pos + sizeof(header) + header.length == pos)
+			segment->read_pos = pos;
+	}
+	segment->write_pos = pos;
+	return segment;
+}
+
+// On worker_, before it makes any segment of this spool
+void AudioSpool::adopt(const std::vector<uint64_t> &indices)
+{
+	std::vector<std::unique_ptr<Segment>> unsent;
+	uint64_t unsent_bytes = 0;
+	for (const uint64_t index : indices) {
+		std::unique_ptr<Segment> segment = openSegment(index);
+		if (segment && segment->read_pos < segment->write_pos) {
+			unsent_bytes += segment->write_pos - segment->read_pos;
+			unsent.push_back(std::move(segment));
+			continue;
+		}
+		segment.reset();
+		std::remove(path(index).c_str());
+	}
+	if (unsent.empty())
+		return;
+	obs_log(LOG_INFO, "Audio spool: took over %llu bytes in %zu segments left in <%s>",
+		static_cast<unsigned long long>(unsent_bytes), unsent.size(), dir_.c_str());
+
+	// All at once, so nothing appended meanwhile lands between them
+	std::lock_guard<std::mutex> lock(mutex_);
+	for (std::unique_ptr<Segment> &segment : unsent) {
+		backlog_bytes_ += segment->write_pos - segment->read_pos;
+		pushSegment(std::move(segment));
+	}
+}
+
+// With mutex_ held
+void AudioSpool::requestSegment()
+{
+	if (making_ || !worker_)
+		return;
+	making_ = true;
+	const uint64_t index = next_index_++;
+	worker_->post([this, index] { installSegment(makeSegment(index)); });
+}
+
+void AudioSpool::installSegment(std::unique_ptr<Segment> segment)
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	making_ = false;
+	if (!segment) {
+		// Once per failure streak; the next append asks again
+		if (!failing_)
+			obs_log(LOG_ERROR, "Cannot create an audio spool segment in <%s>", dir_.c_str());
+		failing_ = true;
+		return;
+	}
+	failing_ = false;
+	if (pending_.empty()) {
+		spare_ = std::move(segment);
+		return;
+	}
+	pushSegment(std::move(segment));
+	for (const PendingChunk &chunk : pending_)
+		write(chunk.time_ns, chunk.pcm.data(), chunk.pcm.size());
+	pending_.clear();
+	pending_bytes_ = 0;
+}
+
+// With mutex_ held
+void AudioSpool::pushSegment(std::unique_ptr<Segment> segment)
+{
+	if (segments_.size() >= MAX_SEGMENTS) {
+		obs_log(LOG_WARNING, "Audio spool full, dropping its oldest %u MiB", SEGMENT_SIZE >> 20);
+		dropFront();
+	}
+	segments_.push_back(std::move(segment));
+}
+
+// With mutex_ held, into the last segment, which has room; backlog_bytes_ already counts it
+void AudioSpool::write(const uint64_t time_ns, const char *data, const size_t size)
+{
+	Segment &segment = *segments_.back();
+	const ChunkHeader header{static_cast<uint32_t>(size), 0, time_ns};
+	uint8_t *out = segment.region.data() + segment.write_pos;
+	std::memcpy(out, &header, sizeof(header));
+	std::memcpy(out + sizeof(header), data, size);
+	segment.write_pos += static_cast<uint32_t>(sizeof(header) + size);
+}
+
+// With mutex_ held
+void AudioSpool::dropFront()
+{
+	std::unique_ptr<Segment> segment = std::move(segments_.front());
+	segments_.pop_front();
+	backlog_bytes_ -= segment->write_pos - segment->read_pos;
+	retire(std::move(segment));
+}
+
+// Unmaps and deletes the segment's file, on worker_ while there is one
+void AudioSpool::retire(std::unique_ptr<Segment> segment)
+{
+	if (!segment)
+		return;
+	const auto remove = [](Segment &s) {
+		s.region = MappedRegion();
+		s.file.close();
+		std::remove(s.path.c_str());
+	};
+	if (!worker_) {
+		remove(*segment);
+		return;
+	}
+	// std::function wants a copyable job
+	std::shared_ptr<Segment> retired(std::move(segment));
+	worker_->post([retired, remove] { remove(*retired); });
+}
+
+bool AudioSpool::append(const uint64_t time_ns, const std::vector<char> &chunk)
+{
+	const size_t needed = sizeof(ChunkHeader) + chunk.size();
+	if (chunk.empty() || needed > SEGMENT_SIZE)
+		return false;
+
+	std::lock_guard<std::mutex> lock(mutex_);
+	// Chunks waiting for a segment go first
+	if (pending_.empty()) {
+		if ((segments_.empty() || segments_.back()->write_pos + needed > SEGMENT_SIZE) && spare_)
+			pushSegment(std::move(spare_));
+		if (!segments_.empty() && segments_.back()->write_pos + needed <= SEGMENT_SIZE) {
+			write(time_ns, chunk.data(), chunk.size());
+			backlog_bytes_ += needed;
+			// Half way through the last segment, have the next one made
+			if (!spare_ && segments_.back()->write_pos > SEGMENT_SIZE / 2)
+				requestSegment();
+			return true;
+		}
+	}
+
+	if (pending_bytes_ + chunk.size() > MAX_PENDING_BYTES) {
+		requestSegment();
+		return false;
+	}
+	pending_.push_back({time_ns, chunk});
+	pending_bytes_ += chunk.size();
+	backlog_bytes_ += needed;
+	requestSegment();
+	return true;
+}
+
+bool AudioSpool::peek(std::vector<char> &chunk, uint64_t &time_ns)
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	while (!segments_.empty()) {
+		const Segment &segment = *segments_.front();
+		if (segment.read_pos < segment.write_pos) {
+			ChunkHeader header;
+			const uint8_t *in = segment.region.data() + segment.read_pos;
+			std::memcpy(&header, in, sizeof(header));
+			chunk.assign(in + sizeof(header), in + sizeof(header) + header.length);
+			time_ns = header.time_ns;
+			peeked_ = true;
+			peeked_index_ = segment.index;
+			peeked_pos_ = segment.read_pos;
+			return true;
+		}
+		// The segment being written stays; read-out older ones go
+		if (segments_.size() == 1) {
+			if (segment.write_pos > 0)
+				dropFront();
+			return false;
+		}
+		dropFront();
+	}
+	// Chunks still waiting for a segment are read once they are in one
+	return false;
+}
+
+void AudioSpool::pop()
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	if (!peeked_)
+		return;
+	peeked_ = false;
+	if (segments_.empty())
+		return;
+	Segment &segment = *segments_.front();
+	if (segment.index != peeked_index_ || segment.read_pos != peeked_pos_)
+		return;
+	ChunkHeader header;
+	uint8_t *in = segment.region.data() + segment.read_pos;
+	std::memcpy(&header, in, sizeof(header));
+	header.sent = 1;
+	std::memcpy(in, &header, sizeof(header));
+	segment.read_pos += static_cast<uint32_t>(sizeof(header) + header.length);
+	backlog_bytes_ -= sizeof(header) + header.length;
+}
+
+bool AudioSpool::empty() const
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	return backlog_bytes_ == 0;
+}
+
+uint64_t AudioSpool::backlogBytes() const
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	return backlog_bytes_;
+}
+
+uint64_t AudioSpool::oldestTimeNs() const
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	for (const auto &segment : segments_) {
+		if (segment->read_pos < segment->write_pos) {
+			ChunkHeader header;
+			std::memcpy(&header, segment->region.data() + segment->read_pos, sizeof(header));
+			return header.time_ns;
+		}
+	}
+	return pending_.empty() ? 0 : pending_.front().time_ns;
+}
@@ -0,0 +1,90 @@
+#ifndef AUDIO_SPOOL_H
+#define AUDIO_SPOOL_H
+
+#include "background_worker.h"
+#include "mapped_file.h"
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// FIFO of audio chunks that could not be streamed, kept in memory-mapped
+// segment files so an outage costs disk space rather than heap. Chunks are
+// appended by the audio thread and drained by the catch-up stream; a
+// segment's file is deleted once it has been read. When the spool is full
+// the oldest segment is dropped. Segments still holding unsent audio when the
+// spool is destroyed stay on disk, and the next spool on the same folder
+// takes them over ahead of its own; their chunks keep their capture times.
+//
+// Segment files are created, allocated, mapped and deleted on a background
+// thread, so append() only copies: the next segment is made while the last
+// one fills, and chunks that find no room wait in memory until it is ready.
+class AudioSpool {
+public:
+	explicit AudioSpool(std::string dir);
+	AudioSpool(const AudioSpool &) = delete;
+	AudioSpool &operator=(const AudioSpool &) = delete;
+	~AudioSpool();
+
+	// False when the chunk was not kept: too large, or no segment could be made.
+	bool append(uint64_t time_ns, const std::vector<char> &chunk);
+	// Oldest chunk and the time it was captured, left spooled until pop();
+	// false when there is none.
+	bool peek(std::vector<char> &chunk, uint64_t &time_ns);
+	// Removes the chunk the last peek() returned, unless it was dropped since.
+	void pop();
+
+	[[nodiscard]] bool empty() const;
+	[[nodiscard]] uint64_t backlogBytes() const;
+	// Capture time of the oldest chunk still spooled, 0 when empty.
+	[[nodiscard]] uint64_t oldestTimeNs() const;
+
+	static constexpr uint32_t SEGMENT_SIZE = 16u << 20; // about 4 minutes of 16 kHz float audio
+	static constexpr size_t MAX_SEGMENTS = 64;
+	static constexpr size_t MAX_PENDING_BYTES = 1u << 20; // in memory while a segment is made
+
+private:
+	struct Segment {
+		uint64_t index = 0;
+		std::string path;
+		MappedFile file;
+		MappedRegion region;
+		uint32_t write_pos = 0;
+		uint32_t read_pos = 0;
+	};
+	struct PendingChunk {
+		uint64_t time_ns;
+		std::vector<char> pcm;
+	};
+
+	std::unique_ptr<Segment> makeSegment(uint64_t index) const;
+	std::unique_ptr<Segment> openSegment(uint64_t index) const;
+	void adopt(const std::vector<uint64_t> &indices);
+	void requestSegment();
+	void installSegment(std::unique_ptr<Segment> segment);
+	void pushSegment(std::unique_ptr<Segment> segment);
+	void write(uint64_t time_ns, const char *data, size_t size);
+	void dropFront();
+	void retire(std::unique_ptr<Segment> segment);
+
+	std::string path(uint64_t index) const;
+
+	std::string dir_;
+	std::deque<std::unique_ptr<Segment>> segments_;
+	std::unique_ptr<Segment> spare_; // made ahead, for when the last segment fills
+	bool making_ = false;            // a segment is being made on worker_
+	bool failing_ = false;
+	std::deque<PendingChunk> pending_;
+	size_t pending_bytes_ = 0;
+	uint64_t next_index_ = 0;
+	uint64_t backlog_bytes_ = 0;
+	bool peeked_ = false;
+	uint64_t peeked_index_ = 0;
+	uint32_t peeked_pos_ = 0;
+	mutable std::mutex mutex_;
+	std::unique_ptr<BackgroundWorker> worker_;
+};
+
+#endif
@@ -0,0 +1,37 @@
+#include "background_worker.h"
+
+BackgroundWorker::BackgroundWorker() : thread_(&BackgroundWorker::run, this) {}
+
+BackgroundWorker::~BackgroundWorker()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		stopping_ = true;
+	}
+	cv_.notify_all();
+	thread_.join();
+}
+
+void BackgroundWorker::post(std::function<void()> job)
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		jobs_.push_back(std::move(job));
+	}
+	cv_.notify_one();
+}
+
+void BackgroundWorker::run()
+{
+	std::unique_lock<std::mutex> lock(mutex_);
+	for (;;) {
+		cv_.wait(lock, [this] { return stopping_ || !jobs_.empty(); });
+		if (jobs_.empty())
+			return;
+		std::function<void()> job = std::move(jobs_.front());
+		jobs_.pop_front();
+		lock.unlock();
+		job();
+		lock.lock();
+	}
+}
@@ -0,0 +1,31 @@
+#ifndef BACKGROUND_WORKER_H
+#define BACKGROUND_WORKER_H
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+// One thread running posted jobs in order: the file work (creating, growing
+// and mapping) that must not stall the audio thread or ReceiverLoop.
+class BackgroundWorker {
+public:
+	BackgroundWorker();
+	BackgroundWorker(const BackgroundWorker &) = delete;
+	BackgroundWorker &operator=(const BackgroundWorker &) = delete;
+	~BackgroundWorker(); // runs the jobs already posted, then joins
+
+	void post(std::function<void()> job);
+
+private:
+	void run();
+
+	std::mutex mutex_;
+	std::condition_variable cv_;
+	std::deque<std::function<void()>> jobs_;
+	bool stopping_ = false;
+	std::thread thread_;
+};
+
+#endif
@@ -0,0 +1,48 @@
+#include "caption_pacer.h"
+#include "utf8.h"
+#include <algorithm>
+
+void CaptionPacer::push(std::string_view text, const uint64_t now_ns)
+{
+	size_t pos = 0;
+	while (pos < text.size()) {
+		const size_t start = text.find_first_not_of(' ', pos);
+		if (start == std::string_view::npos)
+			break;
+		const size_t end = std::min(text.find(' ', start), text.size());
+		const std::string_view word = text.substr(start, end - start);
+		pos = end;
+
+		const size_t chars = utf8::length(word);
+		if (!rows_.empty() && rows_.back().chars + 1 + chars <= ROW_CHARS) {
+			Row &row = rows_.back();
+			row.text += ' ';
+			row.text += word;
+			row.chars += 1 + chars;
+		} else {
+			rows_.push_back(Row{std::string(word), chars, now_ns});
+			if (rows_.size() > MAX_ROWS)
+				rows_.pop_front();
+		}
+	}
+}
+
+void CaptionPacer::pump(const uint64_t now_ns)
+{
+	if (rows_.empty() || now_ns < channel_free_ns_)
+		return;
+	// Only the last row can still grow
+	const Row &row = rows_.front();
+	if (rows_.size() == 1 && row.chars < ROW_CHARS && now_ns - row.started_ns < HOLD_NS)
+		return;
+
+	const double duration = static_cast<double>(row.text.size() + CONTROL_BYTES) / BYTES_PER_SECOND;
+	sink_(row.text, duration);
+	channel_free_ns_ = now_ns + static_cast<uint64_t>(duration * 1e9);
+	rows_.pop_front();
+}
+
+void CaptionPacer::clear()
+{
+	rows_.clear();
+}
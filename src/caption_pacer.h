@@ -0,0 +1,46 @@
+#ifndef CAPTION_PACER_H
+#define CAPTION_PACER_H
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <string>
+#include <string_view>
+
+// Turns the word stream into CEA-608 caption rows and hands them to an output
+// no faster than the caption channel carries them. The output shows each
+// caption for its display duration before taking the next one, so sending
+// faster only builds a backlog there; here the backlog is a few rows and the
+// oldest is dropped, which keeps native captions live.
+class CaptionPacer {
+public:
+	// Receives one row and how long it occupies the channel, in seconds.
+	using Sink = std::function<void(const std::string &text, double display_duration)>;
+
+	explicit CaptionPacer(Sink sink) : sink_(std::move(sink)) {}
+
+	void push(std::string_view text, uint64_t now_ns);
+	// Sends the next row if the channel is free; call every frame.
+	void pump(uint64_t now_ns);
+	void clear();
+	[[nodiscard]] size_t queued() const { return rows_.size(); }
+
+	static constexpr double BYTES_PER_SECOND = 60.0; // field 1: two bytes a frame at 29.97 fps
+	static constexpr size_t CONTROL_BYTES = 16;      // doubled pop-on control codes per caption
+	static constexpr size_t ROW_CHARS = 32;
+	static constexpr size_t MAX_ROWS = 4;
+	static constexpr uint64_t HOLD_NS = 1000000000;  // a short row waits this long for more words
+
+private:
+	struct Row {
+		std::string text;
+		size_t chars;
+		uint64_t started_ns;
+	};
+
+	Sink sink_;
+	std::deque<Row> rows_;
+	uint64_t channel_free_ns_ = 0;
+};
+
+#endif
@@ -0,0 +1,319 @@
+#include "caption_sidecar.h"
+#include "utf8.h"
+#include <obs-module.h>
+#include <plugin-support.h>
+#include <util/platform.h>
+#include <algorithm>
+#include <chrono>
+
+namespace {
+
+constexpr size_t FILE_BUFFER = 64 * 1024;
+
+// HH:MM:SS,mmm for SRT, HH:MM:SS.mmm for WebVTT
+void writeTime(FILE *file, const uint64_t ms, const char separator)
+{
+	fprintf(file, "%02llu:%02llu:%02llu%c%03llu", static_cast<unsigned long long>(ms / 3600000),
+		static_cast<unsigned long long>(ms / 60000 % 60), static_cast<unsigned long long>(ms / 1000 % 60),
+		separator, static_cast<unsigned long long>(ms % 1000));
+}
+
+FILE *openBuffered(const std::string &path)
+{
+	FILE *file = os_fopen(path.c_str(), "wb");
+	if (file)
+		setvbuf(file, nullptr, _IOFBF, FILE_BUFFER);
+	return file;
+}
+
+bool isSpace(const char c)
+{
+	return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+// The part of text that goes after `to`: results are joined as they came,
+// like on screen, less the spaces that would double up or start the cue
+std::string joinable(const std::string &to, const std::string &text)
+{
+	if (!to.empty() && !isSpace(to.back()))
+		return text;
+	size_t start = 0;
+	while (start < text.size() && isSpace(text[start]))
+		++start;
+	return text.substr(start);
+}
+
+// Cue text with no blank lines, which would end the cue in both formats:
+// line breaks, and the spaces after them, collapse into one break and the
+// breaks at either end go
+std::string cueLines(const std::string &text)
+{
+	std::string lines;
+	lines.reserve(text.size());
+	bool pending = false;
+	for (const char c : text) {
+		if (c == '\r' || c == '\n') {
+			pending = !lines.empty();
+			continue;
+		}
+		if (pending) {
+			if (c == ' ' || c == '\t')
+				continue;
+			lines += '\n';
+			pending = false;
+		}
+		lines += c;
+	}
+	return lines;
+}
+
+} // namespace
+
+bool CueBuilder::add(const uint64_t time_ms, const std::string &text, Cue &done)
+{
+	if (text.find_first_not_of(" \t\r\n") == std::string::npos)
+		return false;
+	const uint64_t t = std::max(time_ms, last_ms_);
+
+	bool closed = false;
+	if (open_) {
+		const std::string more = joinable(cue_.text, text);
+		if (t - last_ms_ > MAX_GAP_MS) {
+			done = std::move(cue_);
+			done.end_ms = last_ms_ + LINGER_MS;
+			closed = true;
+		} else if (utf8::length(cue_.text) + utf8::length(more) > MAX_CHARS ||
+			   t - cue_.start_ms > MAX_DURATION_MS) {
+			done = std::move(cue_);
+			done.end_ms = t;
+			closed = true;
+		} else {
+			cue_.text += more;
+			cue_.end_ms = t;
+			last_ms_ = t;
+			return false;
+		}
+	}
+
+	cue_ = Cue{t, t, joinable(std::string(), text)};
+	open_ = true;
+	last_ms_ = t;
+	return closed;
+}
+
+bool CueBuilder::finish(const uint64_t end_ms, Cue &done)
+{
+	if (!open_)
+		return false;
+	done = std::move(cue_);
+	done.end_ms = std::max(std::min(last_ms_ + LINGER_MS, end_ms), done.start_ms);
+	open_ = false;
+	return true;
+}
+
+CaptionSidecarWriter::CaptionSidecarWriter() : thread_(&CaptionSidecarWriter::run, this) {}
+
+CaptionSidecarWriter::~CaptionSidecarWriter()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		shutdown_ = true;
+	}
+	cv_.notify_one();
+	thread_.join();
+}
+
+void CaptionSidecarWriter::start(const std::string &base_path, const uint64_t start_ns)
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	recording_ = true;
+	queue_.push_back(Item{Kind::Start, start_ns, base_path});
+	wake_ = true;
+	cv_.notify_one();
+}
+
+void CaptionSidecarWriter::stop(const uint64_t stop_ns)
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	if (!recording_)
+		return;
+	recording_ = false;
+	queue_.push_back(Item{Kind::Stop, stop_ns, {}});
+	wake_ = true;
+	cv_.notify_one();
+}
+
+void CaptionSidecarWriter::pause(const uint64_t time_ns)
+{
+	queue(Kind::Pause, time_ns);
+}
+
+void CaptionSidecarWriter::resume(const uint64_t time_ns)
+{
+	queue(Kind::Resume, time_ns);
+}
+
+void CaptionSidecarWriter::queue(const Kind kind, const uint64_t time_ns)
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	if (!recording_)
+		return;
+	queue_.push_back(Item{kind, time_ns, {}});
+}
+
+void CaptionSidecarWriter::push(const uint64_t time_ns, const std::string &text)
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	if (!recording_)
+		return;
+	queue_.push_back(Item{Kind::Result, time_ns, text});
+	// Results are written in batches; the periodic wake-up picks up the rest
+	if (queue_.size() >= BATCH && !wake_) {
+		wake_ = true;
+		cv_.notify_one();
+	}
+}
+
+void CaptionSidecarWriter::run()
+{
+	std::vector<Item> batch;
+	std::unique_lock<std::mutex> lock(mutex_);
+	while (true) {
+		// Flush at least once a second while recording, sleep otherwise
+		const auto woken = [this] { return wake_ || shutdown_; };
+		if (srt_ || vtt_)
+			cv_.wait_for(lock, std::chrono::seconds(1), woken);
+		else
+			cv_.wait(lock, woken);
+		wake_ = false;
+		batch.swap(queue_);
+		const bool shutdown = shutdown_;
+		lock.unlock();
+
+		for (Item &item : batch)
+			process(item);
+		batch.clear();
+		// One write per file per batch; a crash loses about the last second
+		if (srt_)
+			fflush(srt_);
+		if (vtt_)
+			fflush(vtt_);
+
+		if (shutdown)
+			break;
+		lock.lock();
+	}
+	CueBuilder::Cue cue;
+	if ((srt_ || vtt_) && builder_.finish(UINT64_MAX, cue))
+		writeCue(cue);
+	closeFiles();
+}
+
+void CaptionSidecarWriter::process(Item &item)
+{
+	CueBuilder::Cue cue;
+	switch (item.kind) {
+	case Kind::Start:
+		closeFiles();
+		srt_ = openBuffered(item.text + ".srt");
+		vtt_ = openBuffered(item.text + ".vtt");
+		if (!srt_ || !vtt_)
+			obs_log(LOG_ERROR, "Failed to create caption files <%s>.srt/.vtt", item.text.c_str());
+		else
+			obs_log(LOG_INFO, "Writing captions to <%s>.srt/.vtt", item.text.c_str());
+		if (vtt_)
+			fputs("WEBVTT\n\n", vtt_);
+		start_ns_ = item.time_ns;
+		pauses_.clear();
+		cue_index_ = 0;
+		builder_ = CueBuilder();
+		break;
+	case Kind::Result:
+		// Results arrive after their audio, so one captured before a pause can come after it
+		if ((srt_ || vtt_) && !paused(item.time_ns) && builder_.add(toMs(item.time_ns), item.text, cue))
+			writeCue(cue);
+		break;
+	case Kind::Pause:
+		if (pauses_.empty() || pauses_.back().end_ns != UINT64_MAX)
+			pauses_.push_back(Pause{std::max(item.time_ns, start_ns_), UINT64_MAX});
+		break;
+	case Kind::Resume:
+		if (!pauses_.empty() && pauses_.back().end_ns == UINT64_MAX)
+			pauses_.back().end_ns = std::max(item.time_ns, pauses_.back().start_ns);
+		break;
+	case Kind::Stop:
+		if (builder_.finish(toMs(item.time_ns), cue))
+			writeCue(cue);
+		closeFiles();
+		break;
+	}
+}
+
+bool CaptionSidecarWriter::paused(const uint64_t time_ns) const
+{
+	for (const Pause &pause : pauses_) {
+		if (time_ns < pause.start_ns)
+			return false;
+		if (time_ns < pause.end_ns)
+			return true;
+	}
+	return false;
+}
+
+// Recording time: the time since the start less the pauses before time_ns; a
+// time inside a pause maps to where the pause is in the recording
+uint64_t CaptionSidecarWriter::toMs(uint64_t time_ns) const
+{
+	uint64_t paused_ns = 0;
+	for (const Pause &pause : pauses_) {
+		if (time_ns <= pause.start_ns)
+			break;
+		if (time_ns < pause.end_ns) {
+			time_ns = pause.start_ns;
+			break;
+		}
+		paused_ns += pause.end_ns - pause.start_ns;
+	}
+	return time_ns > start_ns_ + paused_ns ? (time_ns - start_ns_ - paused_ns) / 1000000 : 0;
+}
+
+void CaptionSidecarWriter::writeCue(const CueBuilder::Cue &cue)
+{
+	++cue_index_;
+	const std::string text = cueLines(cue.text);
+	if (srt_) {
+		fprintf(srt_, "%u\n", cue_index_);
+		writeTime(srt_, cue.start_ms, ',');
+		fputs(" --> ", srt_);
+		writeTime(srt_, cue.end_ms, ',');
+		fprintf(srt_, "\n%s\n\n", text.c_str());
+	}
+	if (vtt_) {
+		writeTime(vtt_, cue.start_ms, '.');
+		fputs(" --> ", vtt_);
+		writeTime(vtt_, cue.end_ms, '.');
+		fputc('\n', vtt_);
+		// Cue text is markup in WebVTT
+		for (const char c : text) {
+			if (c == '&')
+				fputs("&amp;", vtt_);
+			else if (c == '<')
+				fputs("&lt;", vtt_);
+			else if (c == '>')
+				fputs("&gt;", vtt_); // "-->" would end the cue text
+			else
+				fputc(c, vtt_);
+		}
+		fputs("\n\n", vtt_);
+	}
+}
+
+void CaptionSidecarWriter::closeFiles()
+{
+	if (srt_)
+		fclose(srt_);
+	if (vtt_)
+		fclose(vtt_);
+	srt_ = nullptr;
+	vtt_ = nullptr;
+}
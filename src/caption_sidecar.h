@@ -0,0 +1,98 @@
+#ifndef CAPTION_SIDECAR_H
+#define CAPTION_SIDECAR_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Groups timed results into subtitle cues.
+class CueBuilder {
+public:
+	struct Cue {
+		uint64_t start_ms;
+		uint64_t end_ms;
+		std::string text;
+	};
+
+	// Times are milliseconds from the recording start. Returns true and
+	// fills `done` when the result closes the previous cue.
+	bool add(uint64_t time_ms, const std::string &text, Cue &done);
+	// Closes the open cue, if any, at most at end_ms.
+	bool finish(uint64_t end_ms, Cue &done);
+
+	static constexpr size_t MAX_CHARS = 84;      // two lines of 42
+	static constexpr uint64_t MAX_DURATION_MS = 6000;
+	static constexpr uint64_t MAX_GAP_MS = 2000; // silence that ends a cue
+	static constexpr uint64_t LINGER_MS = 2000;  // how long the last words stay
+
+private:
+	bool open_ = false;
+	Cue cue_;
+	uint64_t last_ms_ = 0;
+};
+
+// Writes <base>.srt and <base>.vtt for one recording. Results are handed
+// over with push() and everything else, cue building and all file I/O,
+// happens on the writer's own thread in batches.
+class CaptionSidecarWriter {
+public:
+	CaptionSidecarWriter();
+	CaptionSidecarWriter(const CaptionSidecarWriter &) = delete;
+	CaptionSidecarWriter &operator=(const CaptionSidecarWriter &) = delete;
+	~CaptionSidecarWriter();
+
+	// base_path has no extension; start_ns/stop_ns/time_ns are os_gettime_ns() values.
+	void start(const std::string &base_path, uint64_t start_ns);
+	void stop(uint64_t stop_ns);
+	// The recording leaves out the time between pause() and resume(): results
+	// captured then are dropped and later cues move back by the pause.
+	void pause(uint64_t time_ns);
+	void resume(uint64_t time_ns);
+	void push(uint64_t time_ns, const std::string &text);
+
+	static constexpr size_t BATCH = 32;
+
+private:
+	enum class Kind { Start, Result, Pause, Resume, Stop };
+	struct Item {
+		Kind kind;
+		uint64_t time_ns;
+		std::string text; // result text, or the base path for Start
+	};
+
+	struct Pause {
+		uint64_t start_ns;
+		uint64_t end_ns; // UINT64_MAX until resumed
+	};
+
+	void queue(Kind kind, uint64_t time_ns);
+	void run();
+	void process(Item &item);
+	[[nodiscard]] bool paused(uint64_t time_ns) const;
+	[[nodiscard]] uint64_t toMs(uint64_t time_ns) const;
+	void writeCue(const CueBuilder::Cue &cue);
+	void closeFiles();
+
+	std::mutex mutex_;
+	std::condition_variable cv_;
+	std::vector<Item> queue_;
+	bool recording_ = false; // guarded by mutex_, filters results between recordings
+	bool wake_ = false;
+	bool shutdown_ = false;
+
+	// Writer thread only
+	FILE *srt_ = nullptr;
+	FILE *vtt_ = nullptr;
+	uint64_t start_ns_ = 0;
+	std::vector<Pause> pauses_; // of this recording, in order
+	unsigned cue_index_ = 0;
+	CueBuilder builder_;
+
+	std::thread thread_; // last, so it starts after everything it uses
+};
+
+#endif
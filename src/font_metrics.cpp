@@ -0,0 +1,131 @@
+#include "font_metrics.h"
+#include "utf8.h"
+#include <obs-module.h>
+#include <plugin-support.h>
+#include <algorithm>
+#include <map>
+
+#include <ft2build.h>
+#include FT_FREETYPE_H
+
+#ifdef HAVE_FONTCONFIG
+#include <fontconfig/fontconfig.h>
+#endif
+
+namespace {
+
+std::mutex library_mutex;
+FT_Library library = nullptr;
+std::map<std::string, std::weak_ptr<FontAdvanceTable>> tables;
+
+// text_ft2_source picks the font file by face and style; fontconfig gives the
+// same answer on Linux. Other platforms fall back to character counting.
+std::string find_font_file([[maybe_unused]] const std::string &face, [[maybe_unused]] const std::string &style,
+			   [[maybe_unused]] int flags)
+{
+	std::string path;
+#ifdef HAVE_FONTCONFIG
+	FcPattern *pattern = FcPatternCreate();
+	FcPatternAddString(pattern, FC_FAMILY, reinterpret_cast<const FcChar8 *>(face.c_str()));
+	if (!style.empty())
+		FcPatternAddString(pattern, FC_STYLE, reinterpret_cast<const FcChar8 *>(style.c_str()));
+	if (flags & OBS_FONT_BOLD)
+		FcPatternAddInteger(pattern, FC_WEIGHT, FC_WEIGHT_BOLD);
+	if (flags & OBS_FONT_ITALIC)
+		FcPatternAddInteger(pattern, FC_SLANT, FC_SLANT_ITALIC);
+	FcConfigSubstitute(nullptr, pattern, FcMatchPattern);
+	FcDefaultSubstitute(pattern);
+
+	FcResult result;
+	if (FcPattern *match = FcFontMatch(nullptr, pattern, &result)) {
+		FcChar8 *file = nullptr;
+		if (FcPatternGetString(match, FC_FILE, 0, &file) == FcResultMatch)
+			path = reinterpret_cast<const char *>(file);
+		FcPatternDestroy(match);
+	}
+	FcPatternDestroy(pattern);
+#endif
+	return path;
+}
+
+} // namespace
+
+FontAdvanceTable::FontAdvanceTable(FT_Face face) : face_(face)
+{
+	low_.fill(NOT_LOADED);
+
+	size_t total = advance(U' ');
+	for (char32_t cp = U'a'; cp <= U'z'; ++cp)
+		total += advance(cp);
+	average_advance_ = std::max<size_t>(total / 27, 1);
+}
+
+FontAdvanceTable::~FontAdvanceTable()
+{
+	std::lock_guard<std::mutex> lock(library_mutex);
+	FT_Done_Face(face_);
+}
+
+std::shared_ptr<FontAdvanceTable> FontAdvanceTable::get(const std::string &face, const std::string &style,
+							 const int size, const int flags)
+{
+	if (face.empty() || size <= 0)
+		return nullptr;
+
+	const std::string key = face + "|" + style + "|" + std::to_string(size) + "|" + std::to_string(flags);
+
+	std::lock_guard<std::mutex> lock(library_mutex);
+	if (auto cached = tables[key].lock())
+		return cached;
+
+	if (!library && FT_Init_FreeType(&library) != 0) {
+		obs_log(LOG_ERROR, "Failed to initialise FreeType");
+		library = nullptr;
+		return nullptr;
+	}
+
+	const std::string path = find_font_file(face, style, flags);
+	FT_Face ft_face = nullptr;
+	if (path.empty() || FT_New_Face(library, path.c_str(), 0, &ft_face) != 0) {
+		obs_log(LOG_WARNING, "Font <%s %s> not found, wrapping by character count", face.c_str(),
+			style.c_str());
+		return nullptr;
+	}
+	FT_Set_Pixel_Sizes(ft_face, 0, static_cast<FT_UInt>(size));
+
+	std::shared_ptr<FontAdvanceTable> table(new FontAdvanceTable(ft_face));
+	tables[key] = table;
+	obs_log(LOG_INFO, "Font advance table loaded: %s (%dpx)", path.c_str(), size);
+	return table;
+}
+
+uint16_t FontAdvanceTable::loadAdvance(const char32_t cp)
+{
+	// Called with mutex_ held: a single FT_Face must not be used from two threads
+	if (FT_Load_Char(face_, cp, FT_LOAD_DEFAULT | FT_LOAD_NO_BITMAP) != 0)
+		return 0;
+	return static_cast<uint16_t>(std::min<FT_Pos>(face_->glyph->advance.x >> 6, NOT_LOADED - 1));
+}
+
+uint16_t FontAdvanceTable::advance(const char32_t cp)
+{
+	if (cp < low_.size()) {
+		if (low_[cp] == NOT_LOADED)
+			low_[cp] = loadAdvance(cp);
+		return low_[cp];
+	}
+
+	const auto it = high_.find(cp);
+	if (it != high_.end())
+		return it->second;
+	return high_.emplace(cp, loadAdvance(cp)).first->second;
+}
+
+size_t FontAdvanceTable::measure(const std::string_view text)
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	size_t width = 0;
+	for (size_t i = 0; i < text.size();)
+		width += advance(utf8::decode(text, i));
+	return width;
+}
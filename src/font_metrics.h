@@ -0,0 +1,44 @@
+#ifndef FONT_METRICS_H
+#define FONT_METRICS_H
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+typedef struct FT_FaceRec_ *FT_Face;
+
+// Horizontal glyph advances of one font at one pixel size, loaded lazily
+// through FreeType and cached for the lifetime of the table. Tables are
+// shared between all sources that select the same font.
+class FontAdvanceTable {
+public:
+	~FontAdvanceTable();
+
+	// Returns nullptr when the font file cannot be resolved or loaded.
+	static std::shared_ptr<FontAdvanceTable> get(const std::string &face, const std::string &style, int size,
+						     int flags);
+
+	// Pixel width of a UTF-8 run, without kerning.
+	size_t measure(std::string_view text);
+	// Mean advance of the lowercase Latin letters and the space.
+	[[nodiscard]] size_t averageAdvance() const { return average_advance_; }
+
+private:
+	explicit FontAdvanceTable(FT_Face face);
+	uint16_t advance(char32_t cp);
+	uint16_t loadAdvance(char32_t cp);
+
+	static constexpr uint16_t NOT_LOADED = 0xFFFF;
+
+	FT_Face face_;
+	size_t average_advance_ = 1;
+	std::array<uint16_t, 0x800> low_; // Latin, Greek, Cyrillic, Hebrew, Arabic
+	std::unordered_map<char32_t, uint16_t> high_;
+	std::mutex mutex_;
+};
+
+#endif
@@ -0,0 +1,99 @@
+#include "keyword_triggers.h"
+#include "text_normalize.h"
+#include <obs-module.h>
+#include <plugin-support.h>
+#include <unordered_map>
+
+namespace {
+
+std::string_view trim(std::string_view text)
+{
+	const size_t first = text.find_first_not_of(" \t\r");
+	if (first == std::string_view::npos)
+		return {};
+	const size_t last = text.find_last_not_of(" \t\r");
+	return text.substr(first, last - first + 1);
+}
+
+} // namespace
+
+std::shared_ptr<const KeywordTriggers> KeywordTriggers::parse(std::string_view spec)
+{
+	auto result = std::make_shared<KeywordTriggers>();
+	std::vector<std::string> patterns;
+	std::unordered_map<std::string, uint32_t> pattern_index;
+
+	size_t line_number = 0;
+	while (!spec.empty()) {
+		const size_t newline = spec.find('\n');
+		const std::string_view line = trim(spec.substr(0, newline));
+		spec = newline == std::string_view::npos ? std::string_view() : spec.substr(newline + 1);
+		++line_number;
+		if (line.empty() || line[0] == '#')
+			continue;
+
+		const size_t arrow = line.find("=>");
+		const size_t colon = arrow == std::string_view::npos ? arrow : line.find(':', arrow);
+		if (colon == std::string_view::npos) {
+			obs_log(LOG_WARNING, "Keyword trigger line %zu: expected \"phrase => scene: name\" or \"phrase => hotkey: name\"",
+				line_number);
+			continue;
+		}
+		KeywordTrigger trigger;
+		trigger.phrase = std::string(trim(line.substr(0, arrow)));
+		const std::string_view kind = trim(line.substr(arrow + 2, colon - arrow - 2));
+		trigger.target = std::string(trim(line.substr(colon + 1)));
+		if (kind == "scene") {
+			trigger.action = KeywordTrigger::Action::Scene;
+		} else if (kind == "hotkey") {
+			trigger.action = KeywordTrigger::Action::Hotkey;
+		} else {
+			obs_log(LOG_WARNING, "Keyword trigger line %zu: unknown action \"%.*s\"", line_number,
+				static_cast<int>(kind.size()), kind.data());
+			continue;
+		}
+
+		// " word word " so the phrase only matches whole words
+		std::string pattern = " ";
+		text_normalize::append(trigger.phrase, pattern);
+		if (pattern.size() == 1 || trigger.target.empty()) {
+			obs_log(LOG_WARNING, "Keyword trigger line %zu: empty phrase or target", line_number);
+			continue;
+		}
+
+		const auto [it, inserted] = pattern_index.emplace(pattern, static_cast<uint32_t>(patterns.size()));
+		if (inserted) {
+			patterns.push_back(std::move(pattern));
+			result->actions_.emplace_back();
+		}
+		result->actions_[it->second].push_back(static_cast<uint32_t>(result->triggers_.size()));
+		result->triggers_.push_back(std::move(trigger));
+	}
+
+	result->automaton_ = AhoCorasick(patterns);
+	return result;
+}
+
+void KeywordMatcher::feed(const std::shared_ptr<const KeywordTriggers> &triggers, std::string_view text,
+			  const std::function<void(const KeywordTrigger &)> &fn)
+{
+	if (triggers != triggers_) {
+		triggers_ = triggers;
+		state_ = AhoCorasick::ROOT;
+		if (triggers_)
+			state_ = triggers_->automaton().step(state_, ' ');
+	}
+	if (!triggers_ || triggers_->triggers().empty())
+		return;
+
+	normalized_.clear();
+	text_normalize::append(text, normalized_);
+	const AhoCorasick &automaton = triggers_->automaton();
+	for (const char c : normalized_) {
+		state_ = automaton.step(state_, static_cast<uint8_t>(c));
+		automaton.matches(state_, [&](const uint32_t pattern) {
+			for (const uint32_t index : triggers_->actions(pattern))
+				fn(triggers_->triggers()[index]);
+		});
+	}
+}
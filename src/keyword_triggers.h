@@ -0,0 +1,55 @@
+#ifndef KEYWORD_TRIGGERS_H
+#define KEYWORD_TRIGGERS_H
+
+#include "aho_corasick.h"
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+struct KeywordTrigger {
+	enum class Action { Scene, Hotkey };
+
+	std::string phrase; // as written in the settings
+	Action action;
+	std::string target; // scene name, or hotkey name or description
+};
+
+// A compiled trigger list: every phrase, normalised by text_normalize, in one
+// automaton. Immutable once built, so the thread delivering results can keep
+// using one while the settings swap in the next.
+class KeywordTriggers {
+public:
+	// One trigger per line, "phrase => scene: Scene name" or
+	// "phrase => hotkey: Hotkey name". Blank lines and lines starting with #
+	// are skipped; lines that do not parse are logged and skipped.
+	static std::shared_ptr<const KeywordTriggers> parse(std::string_view spec);
+
+	[[nodiscard]] const std::vector<KeywordTrigger> &triggers() const { return triggers_; }
+	[[nodiscard]] const AhoCorasick &automaton() const { return automaton_; }
+	// Indices into triggers() of every trigger on a pattern; a phrase can have several actions.
+	[[nodiscard]] const std::vector<uint32_t> &actions(const uint32_t pattern) const { return actions_[pattern]; }
+
+private:
+	std::vector<KeywordTrigger> triggers_;
+	std::vector<std::vector<uint32_t>> actions_;
+	AhoCorasick automaton_;
+};
+
+// Match state over successive results of one source, so a phrase split
+// between two results still fires. Used by one thread at a time.
+class KeywordMatcher {
+public:
+	// Calls fn for every trigger whose phrase ends within text. A different
+	// list than the previous call starts matching afresh.
+	void feed(const std::shared_ptr<const KeywordTriggers> &triggers, std::string_view text,
+		  const std::function<void(const KeywordTrigger &)> &fn);
+
+private:
+	std::shared_ptr<const KeywordTriggers> triggers_;
+	uint32_t state_ = AhoCorasick::ROOT;
+	std::string normalized_;
+};
+
+#endif
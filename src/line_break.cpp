@@ -0,0 +1,172 @@
+#include "line_break.h"
+#include "utf8.h"
+
+namespace line_break {
+
+namespace {
+
+using C = BreakClass;
+
+template<typename... Classes> bool isOneOf(const C c, const Classes... classes)
+{
+	return ((c == classes) || ...);
+}
+
+bool isTerminator(const C c)
+{
+	return isOneOf(c, C::BK, C::CR, C::LF, C::NL);
+}
+
+// LB1: complex-context letters without a dictionary behave like AL;
+// conditional Japanese starters are treated strictly, as NS.
+C resolve(const C c)
+{
+	switch (c) {
+	case C::SA:
+		return C::AL;
+	case C::CJ:
+		return C::NS;
+	default:
+		return c;
+	}
+}
+
+// LB11-LB31 for the pair (before, after). `before` is the last non-space
+// class; `spaced` says whether spaces separate the two.
+bool prohibited(const C before, const C after, const bool spaced, const C before2, const unsigned ri_run)
+{
+	if (after == C::WJ || (!spaced && before == C::WJ))
+		return true; // LB11
+	if (!spaced && before == C::GL)
+		return true; // LB12
+	if (!spaced && after == C::GL && !isOneOf(before, C::BA, C::HY))
+		return true; // LB12a
+	if (isOneOf(after, C::CL, C::CP, C::EX, C::IS, C::SY))
+		return true; // LB13
+	if (before == C::OP)
+		return true; // LB14
+	if (before == C::QU && after == C::OP)
+		return true; // LB15
+	if (isOneOf(before, C::CL, C::CP) && after == C::NS)
+		return true; // LB16
+	if (before == C::B2 && after == C::B2)
+		return true; // LB17
+	if (spaced)
+		return false; // LB18
+
+	if (before == C::QU || after == C::QU)
+		return true; // LB19
+	if (before == C::CB || after == C::CB)
+		return false; // LB20
+	if (isOneOf(after, C::BA, C::HY, C::NS) || before == C::BB)
+		return true; // LB21
+	if (before2 == C::HL && isOneOf(before, C::HY, C::BA))
+		return true; // LB21a
+	if (before == C::SY && after == C::HL)
+		return true; // LB21b
+	if (after == C::IN)
+		return true; // LB22
+	if ((isOneOf(before, C::AL, C::HL) && after == C::NU) || (before == C::NU && isOneOf(after, C::AL, C::HL)))
+		return true; // LB23
+	if ((before == C::PR && isOneOf(after, C::ID, C::EB, C::EM)) ||
+	    (isOneOf(before, C::ID, C::EB, C::EM) && after == C::PO))
+		return true; // LB23a
+	if ((isOneOf(before, C::PR, C::PO) && isOneOf(after, C::AL, C::HL)) ||
+	    (isOneOf(before, C::AL, C::HL) && isOneOf(after, C::PR, C::PO)))
+		return true; // LB24
+	if ((isOneOf(before, C::CL, C::CP, C::NU) && isOneOf(after, C::PO, C::PR)) ||
+	    (isOneOf(before, C::PO, C::PR) && isOneOf(after, C::OP, C::NU)) ||
+	    (isOneOf(before, C::HY, C::IS, C::NU, C::SY) && after == C::NU))
+		return true; // LB25, without the regex lookahead
+	if ((before == C::JL && isOneOf(after, C::JL, C::JV, C::H2, C::H3)) ||
+	    (isOneOf(before, C::JV, C::H2) && isOneOf(after, C::JV, C::JT)) ||
+	    (isOneOf(before, C::JT, C::H3) && after == C::JT))
+		return true; // LB26
+	if ((isOneOf(before, C::JL, C::JV, C::JT, C::H2, C::H3) && after == C::PO) ||
+	    (before == C::PR && isOneOf(after, C::JL, C::JV, C::JT, C::H2, C::H3)))
+		return true; // LB27
+	if (isOneOf(before, C::AL, C::HL) && isOneOf(after, C::AL, C::HL))
+		return true; // LB28
+	if (before == C::IS && isOneOf(after, C::AL, C::HL))
+		return true; // LB29
+	if ((isOneOf(before, C::AL, C::HL, C::NU) && after == C::OP) ||
+	    (before == C::CP && isOneOf(after, C::AL, C::HL, C::NU)))
+		return true; // LB30
+	if (before == C::RI && after == C::RI && ri_run % 2 == 1)
+		return true; // LB30a
+	if (before == C::EB && after == C::EM)
+		return true; // LB30b
+	return false;    // LB31
+}
+
+} // namespace
+
+bool Segmenter::next(Segment &segment)
+{
+	if (pos_ >= text_.size())
+		return false;
+
+	const size_t start = pos_;
+	size_t content_end = start;
+	size_t trailing_end = start;
+	bool mandatory = false;
+
+	for (bool first = true; pos_ < text_.size(); first = false) {
+		size_t after = pos_;
+		const C raw = resolve(classOf(utf8::decode(text_, after)));
+
+		if (!first) {
+			// LB4, LB5: always break after a line terminator (CR × LF)
+			if (isOneOf(prev_raw_, C::BK, C::LF, C::NL) || (prev_raw_ == C::CR && raw != C::LF)) {
+				mandatory = true;
+				break;
+			}
+			bool allowed;
+			if (isTerminator(raw) || isOneOf(raw, C::SP, C::ZW))
+				allowed = false; // LB6, LB7
+			else if (zw_)
+				allowed = true; // LB8
+			else if (prev_raw_ == C::ZWJ)
+				allowed = false; // LB8a
+			else if (isOneOf(raw, C::CM, C::ZWJ) && prev_raw_ != C::SP)
+				allowed = false; // LB9
+			else
+				allowed = !prohibited(prev_, isOneOf(raw, C::CM, C::ZWJ) ? C::AL : raw, spaced_, prev2_,
+						      ri_run_);
+			if (allowed)
+				break;
+		}
+
+		// Advance the state past this code point
+		pos_ = after;
+		if (raw == C::SP) {
+			spaced_ = true;
+			trailing_end = after;
+		} else if (isTerminator(raw)) {
+			spaced_ = false;
+		} else {
+			content_end = trailing_end = after;
+			if (isOneOf(raw, C::CM, C::ZWJ) && prev_raw_ != C::SP && !isTerminator(prev_raw_)) {
+				// LB9: marks take the class of their base character
+				prev_raw_ = raw;
+				continue;
+			}
+			prev2_ = prev_;
+			prev_ = isOneOf(raw, C::CM, C::ZWJ) ? C::AL : raw; // LB10
+			spaced_ = false;
+			zw_ = raw == C::ZW;
+			ri_run_ = raw == C::RI ? ri_run_ + 1 : 0;
+		}
+		prev_raw_ = raw;
+	}
+
+	if (pos_ >= text_.size() && isTerminator(prev_raw_))
+		mandatory = true;
+
+	segment.text = text_.substr(start, content_end - start);
+	segment.trailing = text_.substr(content_end, trailing_end - content_end);
+	segment.mandatory = mandatory;
+	return true;
+}
+
+} // namespace line_break
@@ -0,0 +1,59 @@
+#ifndef LINE_BREAK_H
+#define LINE_BREAK_H
+
+#include "line_break_table.h"
+#include <cstdint>
+#include <string_view>
+
+// UAX #14 line breaking for caption text. Classes come from the generated
+// two-stage table in line_break_table.h (build-aux/gen-line-break-table.py);
+// the pair rules are evaluated inline, so segmenting a word costs one table
+// lookup and a handful of comparisons per code point.
+namespace line_break {
+
+// Order must match CLASSES in build-aux/gen-line-break-table.py
+enum class BreakClass : uint8_t {
+	AL, BA, BB, B2, BK, CB, CJ, CL, CM, CP, CR, EB, EM, EX,
+	GL, H2, H3, HL, HY, ID, IN, IS, JL, JT, JV, LF, NL, NS,
+	NU, OP, PO, PR, QU, RI, SA, SP, SY, WJ, ZW, ZWJ,
+};
+
+inline BreakClass classOf(const char32_t cp)
+{
+	if (cp >= table::LIMIT)
+		return BreakClass::AL;
+	const unsigned block = table::stage1[cp >> table::BLOCK_SHIFT];
+	return static_cast<BreakClass>(table::stage2[(block << table::BLOCK_SHIFT) | (cp & ((1u << table::BLOCK_SHIFT) - 1))]);
+}
+
+struct Segment {
+	std::string_view text;     // up to the last visible character
+	std::string_view trailing; // spaces after it
+	bool mandatory = false;    // ended by a line terminator
+};
+
+// Splits UTF-8 text into segments that end at break opportunities. Segments
+// never split a code point or a base character from its combining marks.
+class Segmenter {
+public:
+	explicit Segmenter(std::string_view text) : text_(text) {}
+
+	bool next(Segment &segment);
+
+private:
+	std::string_view text_;
+	size_t pos_ = 0;
+
+	// Rule state carried across segments. Start of text acts like a preceding
+	// space: no break before the first character (LB2), marks there become AL.
+	BreakClass prev_ = BreakClass::WJ;     // last non-space class after LB9/LB10
+	BreakClass prev2_ = BreakClass::WJ;    // the one before it, for LB21a
+	BreakClass prev_raw_ = BreakClass::SP; // class of the previous code point
+	bool spaced_ = false;                  // spaces since prev_
+	bool zw_ = false;                      // ZW SP* pending (LB8)
+	unsigned ri_run_ = 0;                  // consecutive regional indicators
+};
+
+} // namespace line_break
+
+#endif
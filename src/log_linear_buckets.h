@@ -0,0 +1,59 @@
+#ifndef LOG_LINEAR_BUCKETS_H
+#define LOG_LINEAR_BUCKETS_H
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+// Bucket arithmetic shared by the log-linear histograms (DurationHistogram
+// here, LatencyHistogram in the benchmark harness). Values below 2^SUB_BITS
+// have a bucket each; above that every power of two is split into 2^SUB_BITS
+// buckets, so a bucket is never wider than 1/2^SUB_BITS of its values. Values
+// of 2^MAX_EXPONENT and more count in the last bucket.
+template<int SUB_BITS, int MAX_EXPONENT = 64> struct LogLinearBuckets {
+	static_assert(SUB_BITS > 0 && SUB_BITS < MAX_EXPONENT && MAX_EXPONENT <= 64);
+
+	static constexpr size_t COUNT = static_cast<size_t>(MAX_EXPONENT - SUB_BITS + 1) << SUB_BITS;
+	using Counts = std::array<uint64_t, COUNT>;
+
+	static size_t of(uint64_t value)
+	{
+		if (value < (uint64_t{1} << SUB_BITS))
+			return static_cast<size_t>(value);
+		if constexpr (MAX_EXPONENT < 64)
+			value = std::min<uint64_t>(value, (uint64_t{1} << MAX_EXPONENT) - 1);
+		int exponent = MAX_EXPONENT - 1;
+		while (!(value >> exponent))
+			--exponent;
+		const uint64_t mantissa = (value >> (exponent - SUB_BITS)) & ((uint64_t{1} << SUB_BITS) - 1);
+		return (static_cast<size_t>(exponent - SUB_BITS + 1) << SUB_BITS) + static_cast<size_t>(mantissa);
+	}
+
+	// The largest value that lands in bucket.
+	static uint64_t upperEdge(const size_t bucket)
+	{
+		if (bucket < (size_t{1} << SUB_BITS))
+			return bucket;
+		const int shift = static_cast<int>(bucket >> SUB_BITS) - 1;
+		const uint64_t lower = ((uint64_t{1} << SUB_BITS) + (bucket & ((size_t{1} << SUB_BITS) - 1))) << shift;
+		return lower + (uint64_t{1} << shift) - 1;
+	}
+
+	// The bucket holding rank ceil(p * count) of the count values in counts,
+	// p in [0, 1]; the last bucket when count is more than counts holds.
+	static size_t percentile(const Counts &counts, const uint64_t count, const double p)
+	{
+		const auto rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(p * static_cast<double>(count))));
+		uint64_t seen = 0;
+		for (size_t i = 0; i < COUNT; ++i) {
+			seen += counts[i];
+			if (seen >= rank)
+				return i;
+		}
+		return COUNT - 1;
+	}
+};
+
+#endif
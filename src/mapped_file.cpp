@@ -0,0 +1,134 @@
+#include "mapped_file.h"
+#include <utility>
+
+#ifndef _WIN32
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedRegion::MappedRegion(MappedRegion &&other) noexcept
+	: data_(std::exchange(other.data_, nullptr)),
+	  size_(std::exchange(other.size_, 0))
+{
+}
+
+MappedRegion &MappedRegion::operator=(MappedRegion &&other) noexcept
+{
+	if (this != &other) {
+		reset();
+		data_ = std::exchange(other.data_, nullptr);
+		size_ = std::exchange(other.size_, 0);
+	}
+	return *this;
+}
+
+MappedRegion::~MappedRegion()
+{
+	reset();
+}
+
+void MappedRegion::reset()
+{
+#ifndef _WIN32
+	if (data_)
+		munmap(data_, size_);
+#endif
+	data_ = nullptr;
+	size_ = 0;
+}
+
+MappedFile::~MappedFile()
+{
+	close();
+}
+
+#ifndef _WIN32
+
+bool MappedFile::open(const std::string &path, const bool writable)
+{
+	close();
+	fd_ = ::open(path.c_str(), writable ? O_RDWR | O_CREAT | O_CLOEXEC : O_RDONLY | O_CLOEXEC, 0644);
+	writable_ = writable;
+	return fd_ >= 0;
+}
+
+void MappedFile::close()
+{
+	if (fd_ >= 0)
+		::close(fd_);
+	fd_ = -1;
+}
+
+uint64_t MappedFile::size() const
+{
+	struct stat st {};
+	if (fd_ < 0 || fstat(fd_, &st) != 0)
+		return 0;
+	return static_cast<uint64_t>(st.st_size);
+}
+
+bool MappedFile::resize(const uint64_t new_size)
+{
+	if (fd_ < 0 || !writable_)
+		return false;
+	const uint64_t old_size = size();
+	if (new_size <= old_size)
+		return true;
+#ifdef __APPLE__
+	return ftruncate(fd_, static_cast<off_t>(new_size)) == 0;
+#else
+	const int error = posix_fallocate(fd_, static_cast<off_t>(old_size), static_cast<off_t>(new_size - old_size));
+	// File systems that cannot allocate ahead still get a sparse file
+	if (error == EINVAL || error == EOPNOTSUPP)
+		return ftruncate(fd_, static_cast<off_t>(new_size)) == 0;
+	return error == 0;
+#endif
+}
+
+MappedRegion MappedFile::map(const uint64_t offset, const size_t length) const
+{
+	if (fd_ < 0 || length == 0)
+		return {};
+	const int prot = writable_ ? PROT_READ | PROT_WRITE : PROT_READ;
+	void *data = mmap(nullptr, length, prot, MAP_SHARED, fd_, static_cast<off_t>(offset));
+	if (data == MAP_FAILED)
+		return {};
+	return {static_cast<uint8_t *>(data), length};
+}
+
+void MappedFile::flushAsync(const MappedRegion &region)
+{
+	if (region)
+		msync(region.data(), region.size(), MS_ASYNC);
+}
+
+#else
+
+bool MappedFile::open(const std::string &, bool)
+{
+	return false;
+}
+
+void MappedFile::close() {}
+
+uint64_t MappedFile::size() const
+{
+	return 0;
+}
+
+bool MappedFile::resize(uint64_t)
+{
+	return false;
+}
+
+MappedRegion MappedFile::map(uint64_t, size_t) const
+{
+	return {};
+}
+
+void MappedFile::flushAsync(const MappedRegion &) {}
+
+#endif
@@ -0,0 +1,64 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// One mmap()ed window of a file. Unmapped on destruction.
+class MappedRegion {
+public:
+	MappedRegion() = default;
+	MappedRegion(MappedRegion &&other) noexcept;
+	MappedRegion &operator=(MappedRegion &&other) noexcept;
+	MappedRegion(const MappedRegion &) = delete;
+	MappedRegion &operator=(const MappedRegion &) = delete;
+	~MappedRegion();
+
+	[[nodiscard]] uint8_t *data() const { return data_; }
+	[[nodiscard]] size_t size() const { return size_; }
+	explicit operator bool() const { return data_ != nullptr; }
+
+private:
+	friend class MappedFile;
+	MappedRegion(uint8_t *data, size_t size) : data_(data), size_(size) {}
+	void reset();
+
+	uint8_t *data_ = nullptr;
+	size_t size_ = 0;
+};
+
+// File that is extended in large steps and accessed through mappings, so
+// appends are plain memory stores and never wait on the disk. POSIX only;
+// on other platforms open() fails and callers run without the file.
+class MappedFile {
+public:
+	MappedFile() = default;
+	MappedFile(const MappedFile &) = delete;
+	MappedFile &operator=(const MappedFile &) = delete;
+	~MappedFile();
+
+	bool open(const std::string &path, bool writable);
+	void close();
+	[[nodiscard]] bool isOpen() const { return fd_ >= 0; }
+
+	// Current size on disk, re-read from the file system.
+	[[nodiscard]] uint64_t size() const;
+	// Extends the file with zeroes; never shrinks it. Where the system can, the
+	// disk blocks are allocated too, so a full disk fails here rather than with
+	// SIGBUS on a later store to a mapping. Can take a while: keep it off the
+	// audio thread.
+	bool resize(uint64_t new_size);
+	// offset must be a multiple of PAGE.
+	[[nodiscard]] MappedRegion map(uint64_t offset, size_t length) const;
+	// Schedules write-back of a region without waiting for it.
+	static void flushAsync(const MappedRegion &region);
+
+	static constexpr size_t PAGE = 4096;
+
+private:
+	int fd_ = -1;
+	bool writable_ = false;
+};
+
+#endif
@@ -1,11 +1,32 @@
 #include <obs-module.h>
 #include <plugin-support.h>
+#include <util/platform.h>
 #include <string>
 #include <atomic>
+#include <chrono>
+#include <ctime>
 #include <vector>
 #include <samplerate.h>
 #include "server_gRPC/grpc_client.h"
+#include "audio_pipeline.h"
 #include "subtitle_buffer.h"
+#include "font_metrics.h"
+#include "transcript_log.h"
+#include "caption_sidecar.h"
+#include "caption_pacer.h"
+#include "transcript_history.h"
+#include "transcript_index.h"
+#include "transcript_ring.h"
+#include "session_capture.h"
+#include "audio_spool.h"
+#include "keyword_triggers.h"
+#include "profanity_filter.h"
+#include "probes.h"
+#include "source_metrics.h"
+#include "trace.h"
+#ifdef ENABLE_FRONTEND_API
+#include <obs-frontend-api.h>
+#endif
 
 OBS_DECLARE_MODULE()
 OBS_MODULE_USE_DEFAULT_LOCALE(PLUGIN_NAME, "en-US")
@@ -20,6 +41,18 @@ namespace asr_defaults {
 	constexpr int SERVER_PORT = 50051;
 	constexpr int MAX_LINES = 2;
 	constexpr int MAX_CHARS_PER_LINE = 60;
+	constexpr double CAPTION_EXPIRY = 0.0; // seconds, 0 = keep until pushed out
+	constexpr bool TRANSCRIPT_LOG = true;
+	constexpr bool TRANSCRIPT_RING = false;
+	constexpr bool SESSION_CAPTURE = false;
+	constexpr bool AUDIO_SPOOL = false;
+	constexpr bool CAPTION_SIDECAR = true;
+	constexpr bool NATIVE_CAPTIONS = false;
+	constexpr bool BURN_IN = true;
+	constexpr char KEYWORD_TRIGGERS[] = "";
+	constexpr bool PROFANITY_FILTER = false;
+	constexpr char METRICS_DIR[] = ""; // no stats file
+	constexpr bool TRACE_PIPELINE = false;
 }
 
 struct asr_source {
@@ -47,9 +80,48 @@ struct asr_source {
 	int server_port = asr_defaults::SERVER_PORT;
 	int max_lines = asr_defaults::MAX_LINES;
 	int max_chars_per_line = asr_defaults::MAX_CHARS_PER_LINE;
+	double caption_expiry = asr_defaults::CAPTION_EXPIRY;
 
 	SubtitlesBuffer* subtitles_buffer = nullptr;
 
+	bool transcript_log_enabled = asr_defaults::TRANSCRIPT_LOG;
+	std::string transcript_dir;
+	TranscriptLog* transcript_log = nullptr; // one file per connection, written by ReceiverLoop
+	bool transcript_ring_enabled = asr_defaults::TRANSCRIPT_RING;
+	TranscriptRingWriter* transcript_ring = nullptr; // same lifetime as transcript_log
+	bool session_capture_enabled = asr_defaults::SESSION_CAPTURE;
+	SessionCaptureWriter* session_capture = nullptr; // same lifetime as transcript_log
+	std::atomic<bool> audio_spool_enabled{asr_defaults::AUDIO_SPOOL};
+	AudioSpool* audio_spool = nullptr; // audio that could not be streamed, drained after reconnecting
+	bool session_started = false; // under grpc_mutex: a stream has been started, so an outage is spooled
+	TranscriptLog* backlog_log = nullptr; // results for spooled audio, written by the catch-up stream
+	bool caption_sidecar_enabled = asr_defaults::CAPTION_SIDECAR;
+	CaptionSidecarWriter* caption_sidecar = nullptr; // .srt/.vtt next to the current recording
+	std::atomic<bool> native_captions{asr_defaults::NATIVE_CAPTIONS};
+	CaptionPacer* caption_pacer = nullptr; // CEA-608 to the streaming output, tick thread only
+	std::atomic<bool> burn_in{asr_defaults::BURN_IN};
+	TranscriptIndex* transcript_index = nullptr; // every result since the source was created
+	TranscriptHistory* transcript_history = nullptr; // recent results for get_transcript_history
+	std::string keyword_triggers_text; // what keyword_triggers was parsed from
+	std::shared_ptr<const KeywordTriggers> keyword_triggers; // swapped by asr_update, read by ReceiverLoop
+	KeywordMatcher keyword_matcher; // ReceiverLoop only
+	std::mutex trigger_mutex;
+	std::vector<KeywordTrigger> fired_triggers; // run by the next tick
+	std::string profanity_list; // path of the compiled list, empty when the filter is off
+	std::shared_ptr<const ProfanityFilter> profanity_filter; // swapped by the UI thread, read with result_mutex
+	std::mutex result_mutex; // ReceiverLoop and the tick's flush: the masker and the results it lets out
+	ProfanityMasker profanity_masker;
+	uint64_t last_result_ns = 0;
+	std::shared_ptr<FontAdvanceTable> font_metrics;
+	std::string font_key;
+	SourceMetrics metrics;
+	std::mutex gauges_mutex;
+	SourceMetrics::Gauges last_gauges; // reported while grpc_mutex is busy
+	std::string metrics_dir;
+	MetricsFileWriter *metrics_file = nullptr; // sayo_<source>.prom in metrics_dir
+	bool tracing = false; // holds trace recording on
+	bool silent = false;  // audio thread: the last block was digital silence
+
 	std::mutex grpc_mutex;
 };
 
@@ -58,57 +130,42 @@ static const char *asr_get_name([[maybe_unused]] void *unused)
 	return "ASR Text Source";
 }
 
-size_t resample_audio(asr_source *ctx, const float *in, size_t in_frames)
-{
-	size_t max_out_frames = static_cast<size_t>(static_cast<float>(in_frames) * ctx->resample_ratio) + 1;
-	ctx->resample_output_buffer.resize(max_out_frames);
-
-	SRC_DATA src_data;
-	src_data.data_in = in;
-	src_data.input_frames = static_cast<long>(in_frames);
-	src_data.data_out = ctx->resample_output_buffer.data();
-	src_data.output_frames = static_cast<long>(max_out_frames);
-	src_data.src_ratio = ctx->resample_ratio;
-	src_data.end_of_input = 0;
-
-
-	if (int err = src_process(ctx->resampler, &src_data) != 0) {
-		obs_log(LOG_ERROR, "Resample error: %s", src_strerror(err));
-		return 0;
-	}
-
-	return src_data.output_frames_gen;
-}
-
-bool is_empty_chunk(const float* buffer) {
-	static constexpr float zeros[1200] = {0.0f};
-	return memcmp(buffer, zeros, 1200 * sizeof(float)) == 0;
-}
-
 void audio_callback(void *param, [[maybe_unused]] obs_source_t *source, const struct audio_data *audio_data, bool muted)
 {
 	auto *ctx = static_cast<asr_source *>(param);
 
 	if (!ctx || muted) return;
+	TRACE_SPAN("audio_callback");
+	const uint64_t start = os_gettime_ns();
 	{
 		std::lock_guard<std::mutex> lock(ctx->grpc_mutex);
-		if (!ctx->grpc_client || !ctx->grpc_client->IsRunning()) return;
-
-		if (audio_data->frames == 1200 and is_empty_chunk(reinterpret_cast<float*>(audio_data->data[0]))) return;
+		const bool streaming = ctx->grpc_client && ctx->grpc_client->IsRunning();
+		// Only once Connect has started a session: before that there is nothing to catch up with
+		const bool spooling = ctx->audio_spool && ctx->audio_spool_enabled && ctx->session_started;
+		if (!streaming && !spooling) return;
 
 		const size_t frames = audio_data->frames;
-		std::vector<float> mono(frames);
+		const float *planes[2] = {reinterpret_cast<const float *>(audio_data->data[0]),
+					  reinterpret_cast<const float *>(audio_data->data[1])};
+		const bool silent = frames == 1200 && audio_pipeline::is_empty_chunk(planes[0], frames);
+		if (silent != ctx->silent) {
+			ctx->silent = silent;
+			SAYO_PROBE3(vad_transition, ctx, silent, audio_data->timestamp);
+		}
+		if (silent) return;
 
-		const auto *left = reinterpret_cast<float*>(audio_data->data[0]);
-		if (audio_data->data[1]) {
-			const auto *right = reinterpret_cast<const float *>(audio_data->data[1]);
-			for (size_t i = 0; i < frames; ++i) {
-				mono[i] = (left[i] + right[i]) * 0.5f;
-			}
-		} else {
-			std::memcpy(mono.data(), left,  frames * sizeof(float));
+		audio_pipeline::downmix(planes, planes[1] ? 2 : 1, frames, ctx->resample_input_buffer);
+		int err = 0;
+		size_t out_frames;
+		{
+			TRACE_SPAN("resample_audio");
+			const uint64_t resample_start = os_gettime_ns();
+			out_frames = audio_pipeline::resample_audio(ctx->resampler, ctx->resample_ratio,
+				ctx->resample_input_buffer.data(), frames, ctx->resample_output_buffer, err);
+			ctx->metrics.resample.record(os_gettime_ns() - resample_start);
 		}
-		const size_t out_frames = resample_audio(ctx, mono.data(), frames);
+		if (err != 0)
+			obs_log(LOG_ERROR, "Resample error: %s", src_strerror(err));
 
 		if (ctx->resampler_warmed_up != 0) {
 			ctx->resampler_warmed_up--;
@@ -116,29 +173,490 @@ void audio_callback(void *param, [[maybe_unused]] obs_source_t *source, const st
 		}
 
 		const auto data = reinterpret_cast<const char *>(ctx->resample_output_buffer.data());
+		audio_pipeline::cut_chunks(ctx->send_buffer, data, out_frames * sizeof(float), ctx->audio_chunk_size,
+			[&](const std::vector<char> &chunk) {
+				if (streaming && ctx->grpc_client->SendChunk(chunk)) {
+					ctx->metrics.last_chunk_ns = os_gettime_ns();
+				} else if (spooling && ctx->audio_spool->append(os_gettime_ns(), chunk)) {
+					++ctx->metrics.chunks_spooled;
+				} else {
+					++ctx->metrics.chunks_dropped;
+				}
+			});
+	}
+	ctx->metrics.callback.record(os_gettime_ns() - start);
+}
 
-		ctx->send_buffer.insert(
-			ctx->send_buffer.end(),
-			data,
-			data + out_frames * sizeof(float)
-		);
+std::string file_safe_name(asr_source *ctx)
+{
+	std::string name = obs_source_get_name(ctx->source);
+	for (char &c : name) {
+		if (!isalnum(static_cast<unsigned char>(c)) && c != '-' && c != '_') c = '_';
+	}
+	return name;
+}
+
+// <transcript_dir>/<source name>-<local time><extension>
+std::string session_file_path(asr_source *ctx, const char *extension)
+{
+	char stamp[32];
+	const time_t now = time(nullptr);
+	strftime(stamp, sizeof(stamp), "%Y%m%d-%H%M%S", localtime(&now));
+
+	os_mkdirs(ctx->transcript_dir.c_str());
+	return ctx->transcript_dir + "/" + file_safe_name(ctx) + "-" + stamp + extension;
+}
+
+// Called with grpc_mutex held and no client streaming
+void open_transcript_log(asr_source *ctx)
+{
+	delete ctx->transcript_log;
+	ctx->transcript_log = nullptr;
+	if (!ctx->transcript_log_enabled || ctx->transcript_dir.empty()) return;
+
+	const std::string path = session_file_path(ctx, ".sayolog");
+	auto *log = new TranscriptLog;
+	if (log->open(path, os_gettime_ns())) {
+		ctx->transcript_log = log;
+		obs_log(LOG_INFO, "Transcript log: %s", path.c_str());
+	} else {
+		delete log;
+		obs_log(LOG_ERROR, "Failed to open transcript log <%s>", path.c_str());
+	}
+}
 
-		while (ctx->send_buffer.size() >= ctx->audio_chunk_size) {
-			std::vector<char> chunk(ctx->send_buffer.begin(), ctx->send_buffer.begin() + ctx->audio_chunk_size);
-			ctx->send_buffer.erase(ctx->send_buffer.begin(), ctx->send_buffer.begin() + ctx->audio_chunk_size);
+// Called with grpc_mutex held and no client streaming
+void open_session_capture(asr_source *ctx)
+{
+	delete ctx->session_capture;
+	ctx->session_capture = nullptr;
+	if (!ctx->session_capture_enabled || ctx->transcript_dir.empty()) return;
+
+	const std::string path = session_file_path(ctx, ".sayocap");
+	auto *capture = new SessionCaptureWriter;
+	if (capture->open(path, ctx->target_sample_rate)) {
+		ctx->session_capture = capture;
+		obs_log(LOG_INFO, "Session capture: %s", path.c_str());
+	} else {
+		delete capture;
+		obs_log(LOG_ERROR, "Failed to open session capture <%s>", path.c_str());
+	}
+}
+
+// Called with grpc_mutex held and no client streaming
+void open_transcript_ring(asr_source *ctx)
+{
+	delete ctx->transcript_ring;
+	ctx->transcript_ring = nullptr;
+	if (!ctx->transcript_ring_enabled) return;
+
+	const std::string name = transcript_ring::name(obs_source_get_name(ctx->source));
+	auto *ring = new TranscriptRingWriter;
+	if (ring->open(name)) {
+		ctx->transcript_ring = ring;
+		obs_log(LOG_INFO, "Transcript ring: %s", ring->name().c_str());
+	} else {
+		delete ring;
+		obs_log(LOG_ERROR, "Failed to create transcript ring <%s>", name.c_str());
+	}
+}
 
-			ctx->grpc_client->SendChunk(chunk);
+int64_t unix_ms_from_monotonic(const uint64_t time_ns)
+{
+	const auto unix_now_ns = static_cast<int64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::system_clock::now().time_since_epoch()).count());
+	const auto mono_now_ns = static_cast<int64_t>(os_gettime_ns());
+	return (unix_now_ns - mono_now_ns + static_cast<int64_t>(time_ns)) / 1000000;
+}
+
+// signal "transcript_result", once per result on ReceiverLoop's thread, or on
+// the tick's for words the profanity masker held back.
+// "entry" points to a TranscriptEntryPtr that is valid during the call; copy
+// the shared_ptr to keep the entry without copying its text.
+void emit_transcript_result(asr_source *ctx, const TranscriptEntryPtr &entry)
+{
+	calldata_t cd;
+	calldata_init(&cd);
+	calldata_set_ptr(&cd, "source", ctx->source);
+	calldata_set_string(&cd, "text", entry->text.c_str());
+	calldata_set_bool(&cd, "final", entry->final);
+	calldata_set_int(&cd, "seq", static_cast<long long>(entry->seq));
+	calldata_set_int(&cd, "time_ns", static_cast<long long>(entry->time_ns));
+	calldata_set_int(&cd, "unix_ms", entry->unix_ms);
+	calldata_set_ptr(&cd, "entry", const_cast<TranscriptEntryPtr *>(&entry));
+	signal_handler_signal(obs_source_get_signal_handler(ctx->source), "transcript_result", &cd);
+	calldata_free(&cd);
+}
+
+// Called with grpc_mutex held and no client streaming. Backlog results get
+// their own log: their times run behind the live session's.
+void open_backlog_log(asr_source *ctx)
+{
+	delete ctx->backlog_log;
+	ctx->backlog_log = nullptr;
+	if (ctx->audio_spool->empty() || ctx->transcript_dir.empty()) return;
+
+	const std::string path = session_file_path(ctx, ".backlog.sayolog");
+	auto *log = new TranscriptLog;
+	if (log->open(path, ctx->audio_spool->oldestTimeNs())) {
+		ctx->backlog_log = log;
+		obs_log(LOG_INFO, "Backlog transcript log: %s", path.c_str());
+	} else {
+		delete log;
+		obs_log(LOG_ERROR, "Failed to open backlog transcript log <%s>", path.c_str());
+	}
+}
+
+// Catch-up stream only; these results go to the archive, never on screen
+void on_backlog_result(asr_source *ctx, const std::string &text, const uint64_t audio_time_ns)
+{
+	if (ctx->backlog_log)
+		ctx->backlog_log->append(audio_time_ns, text, transcript_flags::FINAL | transcript_flags::BACKLOG);
+}
+
+// Called with result_mutex held, with masked text only
+void publish_result(asr_source *ctx, const uint64_t now, const std::string &text)
+{
+	if (ctx->transcript_ring)
+		ctx->transcript_ring->publish(now, text);
+	const uint32_t seq = ctx->transcript_index->add(now, text);
+
+	auto entry = std::make_shared<const TranscriptEntry>(TranscriptEntry{seq, now, unix_ms_from_monotonic(now), true, text});
+	ctx->transcript_history->push(entry);
+	emit_transcript_result(ctx, entry);
+	if (ctx->caption_sidecar)
+		ctx->caption_sidecar->push(now, text);
+}
+
+// Only the transcript log, the backlog log and the session capture keep the
+// raw text; the ring, the index, the history, the signal, the sidecar and the
+// screen get it masked. Returns what the tick shows.
+std::string on_asr_result(asr_source *ctx, const std::string &text)
+{
+	const uint64_t now = os_gettime_ns();
+	const uint64_t last_chunk = ctx->metrics.last_chunk_ns;
+	if (last_chunk && last_chunk < now)
+		ctx->metrics.result_latency.record(now - last_chunk);
+	++ctx->metrics.results;
+	ctx->metrics.result_rate.add(now);
+	if (ctx->transcript_log)
+		ctx->transcript_log->append(now, text);
+
+	// Spoken commands are matched as said
+	ctx->keyword_matcher.feed(std::atomic_load(&ctx->keyword_triggers), text, [ctx](const KeywordTrigger &trigger) {
+		std::lock_guard<std::mutex> lock(ctx->trigger_mutex);
+		ctx->fired_triggers.push_back(trigger);
+	});
+
+	// A phrase can be split between results, so the masker may hold the last
+	// words back; they go out with the next result or from the tick once none
+	// has come for a while
+	std::lock_guard<std::mutex> lock(ctx->result_mutex);
+	std::string shown = ctx->profanity_masker.feed(std::atomic_load(&ctx->profanity_filter).get(), text);
+	ctx->last_result_ns = now;
+	if (!shown.empty())
+		publish_result(ctx, now, shown);
+	return shown;
+}
+
+// UI thread: the frontend calls and hotkey callbacks expect it
+void run_keyword_trigger(void *param)
+{
+	std::unique_ptr<KeywordTrigger> trigger(static_cast<KeywordTrigger *>(param));
+	if (trigger->action == KeywordTrigger::Action::Scene) {
+#ifdef ENABLE_FRONTEND_API
+		obs_source_t *scene = obs_get_source_by_name(trigger->target.c_str());
+		if (scene && obs_source_get_type(scene) == OBS_SOURCE_TYPE_SCENE) {
+			obs_frontend_set_current_scene(scene);
+			obs_log(LOG_INFO, "\"%s\" switched to scene <%s>", trigger->phrase.c_str(), trigger->target.c_str());
+		} else {
+			obs_log(LOG_WARNING, "\"%s\": no scene named <%s>", trigger->phrase.c_str(), trigger->target.c_str());
 		}
+		obs_source_release(scene);
+#endif
+		return;
+	}
+
+	struct Lookup {
+		const std::string &name;
+		obs_hotkey_id id;
+		bool found;
+	} lookup{trigger->target, 0, false};
+	obs_enum_hotkeys([](void *data, obs_hotkey_id id, obs_hotkey_t *key) {
+		auto *lookup = static_cast<Lookup *>(data);
+		const char *description = obs_hotkey_get_description(key);
+		if (lookup->name != obs_hotkey_get_name(key) && (!description || lookup->name != description))
+			return true;
+		lookup->id = id;
+		lookup->found = true;
+		return false;
+	}, &lookup);
+	if (!lookup.found) {
+		obs_log(LOG_WARNING, "\"%s\": no hotkey named <%s>", trigger->phrase.c_str(), trigger->target.c_str());
+		return;
+	}
+	obs_hotkey_trigger_routed_callback(lookup.id, true);
+	obs_hotkey_trigger_routed_callback(lookup.id, false);
+	obs_log(LOG_INFO, "\"%s\" pressed hotkey <%s>", trigger->phrase.c_str(), trigger->target.c_str());
+}
+
+#ifdef ENABLE_FRONTEND_API
+// <recording without extension>.<source name>, so several caption sources can share a recording
+std::string caption_sidecar_base(asr_source *ctx)
+{
+	obs_output_t *output = obs_frontend_get_recording_output();
+	if (!output) return {};
+	obs_data_t *settings = obs_output_get_settings(output);
+	std::string path = obs_data_get_string(settings, "path");
+	if (path.empty())
+		path = obs_data_get_string(settings, "url"); // custom FFmpeg output
+	obs_data_release(settings);
+	obs_output_release(output);
+	if (path.empty() || path.find("://") != std::string::npos) return {};
+
+	const size_t dot = path.find_last_of('.');
+	const size_t slash = path.find_last_of("/\\");
+	if (dot != std::string::npos && (slash == std::string::npos || dot > slash))
+		path.resize(dot);
+	return path + "." + file_safe_name(ctx);
+}
+
+// Runs on the UI thread. The recording start event is the zero point of the cue times.
+void asr_frontend_event(enum obs_frontend_event event, void *data)
+{
+	auto *ctx = static_cast<asr_source *>(data);
+	if (event == OBS_FRONTEND_EVENT_RECORDING_STARTED) {
+		const uint64_t start = os_gettime_ns();
+		if (!ctx->caption_sidecar_enabled) return;
+		const std::string base = caption_sidecar_base(ctx);
+		if (!base.empty())
+			ctx->caption_sidecar->start(base, start);
+	} else if (event == OBS_FRONTEND_EVENT_RECORDING_PAUSED) {
+		ctx->caption_sidecar->pause(os_gettime_ns());
+	} else if (event == OBS_FRONTEND_EVENT_RECORDING_UNPAUSED) {
+		ctx->caption_sidecar->resume(os_gettime_ns());
+	} else if (event == OBS_FRONTEND_EVENT_RECORDING_STOPPED) {
+		ctx->caption_sidecar->stop(os_gettime_ns());
 	}
 }
 
+// Graphics thread; the output embeds the caption into the next video packets
+void send_native_caption(const std::string &text, double display_duration)
+{
+	obs_output_t *output = obs_frontend_get_streaming_output();
+	if (!output) return;
+	if (obs_output_active(output))
+		obs_output_output_caption_text2(output, text.c_str(), display_duration);
+	obs_output_release(output);
+}
+#endif
+
+// UI thread. Compiling a long list takes a while, but the tick keeps masking with the previous
+// filter until the new one is swapped in.
+// A new set restarts the matcher, so an unchanged one is kept: a phrase being
+// said is not lost, and bad lines are not logged again, on every settings update
+void load_keyword_triggers(asr_source *ctx, obs_data_t *settings)
+{
+	const std::string text = obs_data_get_string(settings, "keyword_triggers");
+	if (ctx->keyword_triggers && text == ctx->keyword_triggers_text)
+		return;
+	ctx->keyword_triggers_text = text;
+	std::atomic_store(&ctx->keyword_triggers, KeywordTriggers::parse(text));
+}
+
+void load_profanity_filter(asr_source *ctx, obs_data_t *settings, const bool force)
+{
+	const std::string path = obs_data_get_bool(settings, "profanity_filter")
+		? obs_data_get_string(settings, "profanity_list")
+		: "";
+	if (path == ctx->profanity_list && !force)
+		return;
+	ctx->profanity_list = path;
+
+	std::shared_ptr<const ProfanityFilter> filter;
+	if (!path.empty()) {
+		filter = ProfanityFilter::load(path);
+		if (filter)
+			obs_log(LOG_INFO, "Profanity filter: %zu words from %s", filter->wordCount(), path.c_str());
+		else
+			obs_log(LOG_WARNING, "Profanity filter: cannot read %s", path.c_str());
+	}
+	std::atomic_store(&ctx->profanity_filter, filter);
+}
+
 void update_internal_text(asr_source * ctx) {
+	TRACE_SPAN("update_internal_text");
 	obs_data_t *settings = obs_source_get_settings(ctx->internal_text_source);
-	obs_data_set_string(settings, "text", ctx->subtitles_buffer->getBufferContent().c_str());
+	const std::string &text = ctx->subtitles_buffer->getBufferContent();
+	SAYO_PROBE2(subtitle_update, ctx, text.size());
+	obs_data_set_string(settings, "text", text.c_str());
 	obs_source_update(ctx->internal_text_source, settings);
 	obs_data_release(settings);
 }
 
+void update_text_metrics(asr_source *ctx)
+{
+	// The internal source's settings carry text_ft2_source's default font when none was picked
+	obs_data_t *text_settings = obs_source_get_settings(ctx->internal_text_source);
+	obs_data_t *font = obs_data_get_obj(text_settings, "font");
+	obs_data_release(text_settings);
+	if (!font) return;
+
+	const std::string face = obs_data_get_string(font, "face");
+	const std::string style = obs_data_get_string(font, "style");
+	const auto size = static_cast<int>(obs_data_get_int(font, "size"));
+	const auto flags = static_cast<int>(obs_data_get_int(font, "flags"));
+	obs_data_release(font);
+
+	std::string key = face + "|" + style + "|" + std::to_string(size) + "|" + std::to_string(flags);
+	if (key == ctx->font_key) return;
+	ctx->font_key = std::move(key);
+
+	ctx->font_metrics = FontAdvanceTable::get(face, style, size, flags);
+	if (ctx->font_metrics) {
+		ctx->subtitles_buffer->setWidthFunction(
+			[table = ctx->font_metrics](std::string_view text) { return table->measure(text); },
+			ctx->font_metrics->averageAdvance());
+	} else {
+		ctx->subtitles_buffer->setWidthFunction(nullptr, 1);
+	}
+	update_internal_text(ctx);
+}
+
+// proc "search_transcript": in string query, in int limit, out string results.
+// results is JSON: {"hits": [{"seq", "unix_ms", "text"}, ...]}, newest first.
+static void asr_search_transcript(void *data, calldata_t *cd)
+{
+	auto *ctx = static_cast<asr_source *>(data);
+	const char *query = calldata_string(cd, "query");
+	long long limit = calldata_int(cd, "limit");
+	if (limit <= 0) limit = 20;
+
+	const auto hits = ctx->transcript_index->search(query ? query : "", static_cast<size_t>(limit));
+
+	obs_data_array_t *array = obs_data_array_create();
+	for (const TranscriptHit &hit : hits) {
+		obs_data_t *item = obs_data_create();
+		obs_data_set_int(item, "seq", hit.seq);
+		obs_data_set_int(item, "unix_ms", unix_ms_from_monotonic(hit.time_ns));
+		obs_data_set_string(item, "text", hit.text.c_str());
+		obs_data_array_push_back(array, item);
+		obs_data_release(item);
+	}
+	obs_data_t *results = obs_data_create();
+	obs_data_set_array(results, "hits", array);
+	calldata_set_string(cd, "results", obs_data_get_json(results));
+	obs_data_array_release(array);
+	obs_data_release(results);
+}
+
+// proc "get_transcript_history": in int count, out string history.
+// history is JSON: {"entries": [{"seq", "unix_ms", "final", "text"}, ...]}, oldest first.
+static void asr_get_transcript_history(void *data, calldata_t *cd)
+{
+	auto *ctx = static_cast<asr_source *>(data);
+	long long count = calldata_int(cd, "count");
+	if (count <= 0) count = TranscriptHistory::CAPACITY;
+
+	obs_data_array_t *array = obs_data_array_create();
+	for (const TranscriptEntryPtr &entry : ctx->transcript_history->recent(static_cast<size_t>(count))) {
+		obs_data_t *item = obs_data_create();
+		obs_data_set_int(item, "seq", static_cast<long long>(entry->seq));
+		obs_data_set_int(item, "unix_ms", entry->unix_ms);
+		obs_data_set_bool(item, "final", entry->final);
+		obs_data_set_string(item, "text", entry->text.c_str());
+		obs_data_array_push_back(array, item);
+		obs_data_release(item);
+	}
+	obs_data_t *history = obs_data_create();
+	obs_data_set_array(history, "entries", array);
+	calldata_set_string(cd, "history", obs_data_get_json(history));
+	obs_data_array_release(array);
+	obs_data_release(history);
+}
+
+// Called from the UI thread and the metrics file thread, which must not wait
+// out a connection attempt holding grpc_mutex: they get the last values then
+SourceMetrics::Gauges metrics_gauges(asr_source *ctx)
+{
+	std::unique_lock<std::mutex> lock(ctx->grpc_mutex, std::try_to_lock);
+	std::lock_guard<std::mutex> lockg(ctx->gauges_mutex);
+	if (!lock.owns_lock())
+		return ctx->last_gauges;
+	SourceMetrics::Gauges gauges;
+	gauges.send_buffer_bytes = ctx->send_buffer.size();
+	if (ctx->grpc_client) {
+		gauges.audio_queue = ctx->grpc_client->QueuedChunks();
+		gauges.results_queue = ctx->grpc_client->QueuedResults();
+		gauges.connected = ctx->grpc_client->IsRunning();
+	}
+	ctx->last_gauges = gauges;
+	return gauges;
+}
+
+// Starts, moves or stops the stats file; never called with grpc_mutex held
+void update_metrics_file(asr_source *ctx, const std::string &dir)
+{
+	if (dir == ctx->metrics_dir) return;
+	delete ctx->metrics_file;
+	ctx->metrics_file = nullptr;
+	ctx->metrics_dir = dir;
+	if (dir.empty()) return;
+
+	os_mkdirs(dir.c_str());
+	const std::string path = dir + "/sayo_" + file_safe_name(ctx) + ".prom";
+	ctx->metrics_file = new MetricsFileWriter(path, [ctx]() {
+		return ctx->metrics.prometheus(obs_source_get_name(ctx->source), metrics_gauges(ctx), os_gettime_ns());
+	});
+	obs_log(LOG_INFO, "Metrics file: %s", path.c_str());
+}
+
+void set_tracing(asr_source *ctx, const bool tracing)
+{
+	if (tracing == ctx->tracing) return;
+	ctx->tracing = tracing;
+	if (tracing)
+		trace::acquire();
+	else
+		trace::release();
+}
+
+// Spans of every source and thread, not just this one's
+void save_trace(asr_source *ctx)
+{
+	if (!trace::recording) {
+		obs_log(LOG_WARNING, "No pipeline trace to save: turn on \"Record pipeline trace\" first");
+		return;
+	}
+	if (ctx->transcript_dir.empty()) {
+		obs_log(LOG_ERROR, "No transcript folder to save the pipeline trace in");
+		return;
+	}
+	const std::string path = session_file_path(ctx, ".trace.json");
+	if (trace::save(path))
+		obs_log(LOG_INFO, "Pipeline trace: %s", path.c_str());
+	else
+		obs_log(LOG_ERROR, "Failed to save pipeline trace <%s>", path.c_str());
+}
+
+void on_save_trace_hotkey(void *data, [[maybe_unused]] obs_hotkey_id id, [[maybe_unused]] obs_hotkey_t *hotkey,
+			  bool pressed)
+{
+	if (pressed)
+		save_trace(static_cast<asr_source *>(data));
+}
+
+// proc "get_queue_depths": out int send_buffer, out int audio_queue, out int results_queue.
+// Bytes of audio waiting to fill a chunk, chunks waiting to be sent and results waiting to be shown.
+static void asr_get_queue_depths(void *data, calldata_t *cd)
+{
+	auto *ctx = static_cast<asr_source *>(data);
+	const SourceMetrics::Gauges gauges = metrics_gauges(ctx);
+	calldata_set_int(cd, "send_buffer", static_cast<long long>(gauges.send_buffer_bytes));
+	calldata_set_int(cd, "audio_queue", static_cast<long long>(gauges.audio_queue));
+	calldata_set_int(cd, "results_queue", static_cast<long long>(gauges.results_queue));
+}
+
 static void asr_update(void *data, obs_data_t *settings)
 {
 	auto *ctx = static_cast<asr_source *>(data);
@@ -156,6 +674,29 @@ static void asr_update(void *data, obs_data_t *settings)
 		update_internal_text(ctx);
 	}
 
+	ctx->caption_expiry = obs_data_get_double(settings, "caption_expiry");
+	ctx->subtitles_buffer->setExpiry(static_cast<uint64_t>(ctx->caption_expiry * 1e9));
+
+	// Takes effect on the next connection
+	ctx->transcript_log_enabled = obs_data_get_bool(settings, "transcript_log");
+	ctx->transcript_dir = obs_data_get_string(settings, "transcript_dir");
+	ctx->transcript_ring_enabled = obs_data_get_bool(settings, "transcript_ring");
+	ctx->session_capture_enabled = obs_data_get_bool(settings, "session_capture");
+	ctx->audio_spool_enabled = obs_data_get_bool(settings, "audio_spool");
+
+	// Switching off ends the files of the current recording; switching on waits for the next one
+	ctx->caption_sidecar_enabled = obs_data_get_bool(settings, "caption_sidecar");
+	if (!ctx->caption_sidecar_enabled && ctx->caption_sidecar)
+		ctx->caption_sidecar->stop(os_gettime_ns());
+
+	ctx->native_captions = obs_data_get_bool(settings, "native_captions");
+	ctx->burn_in = obs_data_get_bool(settings, "burn_in");
+
+	load_keyword_triggers(ctx, settings);
+	load_profanity_filter(ctx, settings, false);
+	update_metrics_file(ctx, obs_data_get_string(settings, "metrics_dir"));
+	set_tracing(ctx, obs_data_get_bool(settings, "trace_pipeline"));
+
 	// Update audio source
 	const char *audio_name = obs_data_get_string(settings, "audio_source");
 	if (ctx->selected_audio_source.empty() || (ctx->selected_audio_source != audio_name)) {
@@ -181,8 +722,10 @@ static void asr_update(void *data, obs_data_t *settings)
 
 
 	// Update text box
-	if (ctx->internal_text_source)
+	if (ctx->internal_text_source) {
 		obs_source_update(ctx->internal_text_source, settings);
+		update_text_metrics(ctx);
+	}
 }
 
 static void *asr_create([[maybe_unused]] obs_data_t *settings, obs_source_t *source)
@@ -234,14 +777,58 @@ static void *asr_create([[maybe_unused]] obs_data_t *settings, obs_source_t *sou
 	// Prepare audio buffer
 	ctx->send_buffer.reserve(ctx->audio_chunk_size);
 
+	ctx->caption_expiry = obs_data_get_double(settings, "caption_expiry");
+	ctx->transcript_log_enabled = obs_data_get_bool(settings, "transcript_log");
+	ctx->transcript_dir = obs_data_get_string(settings, "transcript_dir");
+	ctx->transcript_ring_enabled = obs_data_get_bool(settings, "transcript_ring");
+	ctx->session_capture_enabled = obs_data_get_bool(settings, "session_capture");
+	ctx->audio_spool_enabled = obs_data_get_bool(settings, "audio_spool");
+	ctx->caption_sidecar_enabled = obs_data_get_bool(settings, "caption_sidecar");
+	ctx->native_captions = obs_data_get_bool(settings, "native_captions");
+	ctx->burn_in = obs_data_get_bool(settings, "burn_in");
+	load_keyword_triggers(ctx, settings);
+	load_profanity_filter(ctx, settings, false);
+	update_metrics_file(ctx, obs_data_get_string(settings, "metrics_dir"));
+	set_tracing(ctx, obs_data_get_bool(settings, "trace_pipeline"));
+	// Unregistered by libobs with the source
+	obs_hotkey_register_source(source, "asr_save_trace", "Save caption pipeline trace", on_save_trace_hotkey, ctx);
+
+#ifdef ENABLE_FRONTEND_API
+	ctx->caption_sidecar = new CaptionSidecarWriter;
+	obs_frontend_add_event_callback(asr_frontend_event, ctx);
+	ctx->caption_pacer = new CaptionPacer(send_native_caption);
+#endif
+
+	if (char *spool_dir = obs_module_config_path("spool")) {
+		ctx->audio_spool = new AudioSpool(std::string(spool_dir) + "/" + file_safe_name(ctx));
+		bfree(spool_dir);
+	}
+
+	ctx->transcript_index = new TranscriptIndex;
+	ctx->transcript_history = new TranscriptHistory;
+	proc_handler_t *ph = obs_source_get_proc_handler(source);
+	proc_handler_add(ph, "void search_transcript(in string query, in int limit, out string results)",
+			 asr_search_transcript, ctx);
+	proc_handler_add(ph, "void get_transcript_history(in int count, out string history)",
+			 asr_get_transcript_history, ctx);
+	proc_handler_add(ph, "void get_queue_depths(out int send_buffer, out int audio_queue, out int results_queue)",
+			 asr_get_queue_depths, ctx);
+	signal_handler_add(obs_source_get_signal_handler(source),
+			   "void transcript_result(ptr source, string text, bool final, int seq, int time_ns, int unix_ms, ptr entry)");
+
 	// Create subtitle buffer
 	ctx->subtitles_buffer = new SubtitlesBuffer(ctx->max_lines, ctx->max_chars_per_line);
+	ctx->subtitles_buffer->setExpiry(static_cast<uint64_t>(ctx->caption_expiry * 1e9));
+	if (ctx->internal_text_source)
+		update_text_metrics(ctx);
 	return ctx;
 }
 
 static void asr_destroy(void *data)
 {
 	auto *ctx = static_cast<asr_source *>(data);
+	update_metrics_file(ctx, ""); // writes a last report while the client is still there
+	set_tracing(ctx, false);
 
 	if (!ctx->selected_audio_source.empty()) {
 		if (obs_source_t *audio_src = obs_get_source_by_name(ctx->selected_audio_source.c_str())) {
@@ -256,8 +843,27 @@ static void asr_destroy(void *data)
 			delete ctx->grpc_client;
 			ctx->grpc_client = nullptr;
 		}
+		delete ctx->transcript_log;
+		ctx->transcript_log = nullptr;
+		delete ctx->transcript_ring;
+		ctx->transcript_ring = nullptr;
+		delete ctx->session_capture;
+		ctx->session_capture = nullptr;
+		delete ctx->backlog_log;
+		ctx->backlog_log = nullptr;
+		delete ctx->audio_spool;
+		ctx->audio_spool = nullptr;
 	}
 
+	// After the client: ReceiverLoop pushes into the writer
+#ifdef ENABLE_FRONTEND_API
+	obs_frontend_remove_event_callback(asr_frontend_event, ctx);
+#endif
+	delete ctx->caption_sidecar; // writes out the open cue and closes the files
+	delete ctx->caption_pacer;
+	delete ctx->transcript_index;
+	delete ctx->transcript_history;
+
 	if (ctx->internal_text_source)
 		obs_source_release(ctx->internal_text_source);
 	if (ctx->resampler)
@@ -299,6 +905,31 @@ bool on_check_button_clicked(obs_properties_t* props, obs_property_t* property,
 	return true;
 }
 
+bool on_reload_profanity_clicked([[maybe_unused]] obs_properties_t *props, [[maybe_unused]] obs_property_t *property,
+				 void *data)
+{
+	auto *ctx = static_cast<asr_source *>(data);
+	obs_data_t *settings = obs_source_get_settings(ctx->source);
+	load_profanity_filter(ctx, settings, true); // the file may have changed under the same path
+	obs_data_release(settings);
+	return false;
+}
+
+bool on_refresh_metrics_clicked(obs_properties_t *props, [[maybe_unused]] obs_property_t *property, void *data)
+{
+	auto *ctx = static_cast<asr_source *>(data);
+	obs_property_set_description(obs_properties_get(props, "metrics"),
+				     ctx->metrics.summary(metrics_gauges(ctx), os_gettime_ns()).c_str());
+	return true;
+}
+
+bool on_save_trace_clicked([[maybe_unused]] obs_properties_t *props, [[maybe_unused]] obs_property_t *property,
+			   void *data)
+{
+	save_trace(static_cast<asr_source *>(data));
+	return false;
+}
+
 bool on_connect_button_clicked(obs_properties_t* props, obs_property_t* property, void* data)
 {
 	auto *ctx = static_cast<asr_source *>(data);
@@ -325,6 +956,7 @@ bool on_connect_button_clicked(obs_properties_t* props, obs_property_t* property
 				ctx->grpc_client = nullptr;
 			}
 			ctx->grpc_client = new ASRGrpcClient(ctx->server_address, ctx->server_port, ctx);
+			ctx->grpc_client->SetMetrics(&ctx->metrics);
 
 			while (try_attempts-- > 0) {
 				if (!ctx || !ctx->grpc_client) break;
@@ -338,8 +970,21 @@ bool on_connect_button_clicked(obs_properties_t* props, obs_property_t* property
 
 			if (!ctx) return;
 
-			if (connected && ctx->grpc_client && !ctx->grpc_client->IsRunning())
+			if (connected && ctx->grpc_client && !ctx->grpc_client->IsRunning()) {
+				open_transcript_log(ctx);
+				open_transcript_ring(ctx);
+				open_session_capture(ctx);
+				ctx->grpc_client->SetCapture(ctx->session_capture);
+				ctx->grpc_client->SetResultHandler([ctx](const std::string &text) { return on_asr_result(ctx, text); });
 				ctx->grpc_client->Start();
+				ctx->session_started = true;
+				if (ctx->audio_spool && !ctx->audio_spool->empty()) {
+					open_backlog_log(ctx);
+					ctx->grpc_client->StartCatchUp(ctx->audio_spool, [ctx](const std::string &text, uint64_t time_ns) {
+						on_backlog_result(ctx, text, time_ns);
+					});
+				}
+			}
 		}
 		update_ui_args->connected = connected;
 		update_ui_args->ctx = ctx;
@@ -387,9 +1032,58 @@ static obs_properties_t *asr_get_properties(void *data)
 		obs_property_set_enabled(server_port, false);
 		obs_property_set_description(conn_status, ("Connection status: " + ctx->connect_status + " Waiting 1-20s" + "...").c_str());
 	}
+	obs_properties_add_text(props, "metrics", ctx->metrics.summary(metrics_gauges(ctx), os_gettime_ns()).c_str(),
+				OBS_TEXT_INFO);
+	obs_properties_add_button(props, "refresh_metrics", "Refresh statistics", on_refresh_metrics_clicked);
+	const auto metrics_dir = obs_properties_add_path(props, "metrics_dir", "Statistics folder", OBS_PATH_DIRECTORY,
+							 nullptr, nullptr);
+	obs_property_set_long_description(metrics_dir, ("Every 10 s the statistics are written to sayo_" + file_safe_name(ctx) +
+							".prom here, for node_exporter's textfile collector. Empty turns it off.").c_str());
+	const auto trace_pipeline = obs_properties_add_bool(props, "trace_pipeline", "Record pipeline trace");
+	obs_property_set_long_description(trace_pipeline, "Keeps the last few seconds of audio, network and rendering spans "
+							  "of every ASR source in memory, to save when captions stutter.");
+	const auto save_trace_btn = obs_properties_add_button(props, "save_trace", "Save pipeline trace", on_save_trace_clicked);
+	obs_property_set_long_description(save_trace_btn, "Writes a .trace.json file to the transcript folder for chrome://tracing "
+							  "or ui.perfetto.dev. The \"Save caption pipeline trace\" hotkey does the same.");
 
 	obs_properties_add_int(props, "max_lines", "Max lines", 1, 10, 1);
 	obs_properties_add_int(props, "max_chars_per_line", "Max chars per line", 16, 100, 1);
+	const auto expiry = obs_properties_add_float(props, "caption_expiry", "Clear captions after", 0.0, 120.0, 0.5);
+	obs_property_float_set_suffix(expiry, " s");
+	obs_property_set_long_description(expiry, "Lines disappear this long after their last word. 0 keeps them until pushed out.");
+
+	obs_properties_add_bool(props, "transcript_log", "Keep transcript log");
+	obs_properties_add_path(props, "transcript_dir", "Transcript folder", OBS_PATH_DIRECTORY, nullptr, nullptr);
+	const auto ring = obs_properties_add_bool(props, "transcript_ring", "Publish transcript to shared memory");
+	obs_property_set_long_description(ring, ("Readers open " + transcript_ring::name(obs_source_get_name(ctx->source)) +
+						 " with transcript_ring_reader.h (the log names a -2, -3, ... suffix when another "
+						 "source has the same name). Takes effect on the next connection.").c_str());
+	const auto capture = obs_properties_add_bool(props, "session_capture", "Capture audio and results for replay");
+	obs_property_set_long_description(capture, "Writes a .sayocap file to the transcript folder for sayo-replay. "
+						   "About 230 MB per hour. Takes effect on the next connection.");
+	const auto spool = obs_properties_add_bool(props, "audio_spool", "Spool audio while disconnected");
+	obs_property_set_long_description(spool, "Once connected, audio that cannot be streamed is kept on disk and "
+						 "transcribed after reconnecting, into a separate backlog transcript log, "
+						 "even after OBS restarts. Up to about 4 hours.");
+#ifdef ENABLE_FRONTEND_API
+	const auto sidecar = obs_properties_add_bool(props, "caption_sidecar", "Write .srt/.vtt next to recordings");
+	obs_property_set_long_description(sidecar, "Takes effect from the next recording.");
+	const auto native = obs_properties_add_bool(props, "native_captions", "Send closed captions to the stream");
+	obs_property_set_long_description(native, "CEA-608 captions embedded in the streamed video, paced to the caption channel.");
+#endif
+	const auto burn_in = obs_properties_add_bool(props, "burn_in", "Render captions in this source");
+	obs_property_set_long_description(burn_in, "Turn off when only closed captions or caption files are needed, to save the text rendering.");
+	const auto triggers = obs_properties_add_text(props, "keyword_triggers", "Keyword triggers", OBS_TEXT_MULTILINE);
+	obs_property_set_long_description(triggers, "One per line: \"phrase => scene: Scene name\" or \"phrase => hotkey: Hotkey name\". "
+						    "Phrases match whole words, ignoring case and punctuation.");
+	const auto profanity = obs_properties_add_bool(props, "profanity_filter", "Mask listed words");
+	obs_property_set_long_description(profanity, "Letters of listed words and phrases are shown as * on screen, in "
+						       ".srt/.vtt files, shared memory and the transcript_result signal. "
+						       "Transcript logs and session captures keep the original text.");
+	const auto profanity_list = obs_properties_add_path(props, "profanity_list", "Word list", OBS_PATH_FILE,
+							    "Text files (*.txt);;All files (*.*)", nullptr);
+	obs_property_set_long_description(profanity_list, "UTF-8, one word or phrase per line; lines starting with # are skipped.");
+	obs_properties_add_button(props, "profanity_reload", "Reload word list", on_reload_profanity_clicked);
 
 	obs_enum_sources([](void *data, obs_source_t *source) {
 		if (obs_source_get_output_flags(source) & OBS_SOURCE_AUDIO) {
@@ -459,41 +1153,75 @@ static obs_properties_t *asr_get_properties(void *data)
 static void asr_render(void *data,[[maybe_unused]] gs_effect_t *effect)
 {
 	auto *ctx = static_cast<asr_source *>(data);
-	if (ctx->internal_text_source)
+	if (ctx->internal_text_source && ctx->burn_in)
 		obs_source_video_render(ctx->internal_text_source);
 }
 
 static uint32_t asr_get_width(void *data) {
 	auto *ctx = static_cast<asr_source *>(data);
-	return ctx->internal_text_source
+	return ctx->internal_text_source && ctx->burn_in
 		? obs_source_get_width(ctx->internal_text_source)
 		: 0;
 }
 
 static uint32_t asr_get_height(void *data) {
 	auto *ctx = static_cast<asr_source *>(data);
-	return ctx->internal_text_source
+	return ctx->internal_text_source && ctx->burn_in
 		? obs_source_get_height(ctx->internal_text_source)
 		: 0;
 }
 
 void asr_tick_callback(void *data, [[maybe_unused]] float seconds) {
+	TRACE_SPAN("asr_tick_callback");
 	auto *ctx = static_cast<asr_source *>(data);
+	const uint64_t now = os_gettime_ns();
+	const bool burn_in = ctx->burn_in;
+
+	if (ctx->caption_pacer) {
+		if (ctx->native_captions)
+			ctx->caption_pacer->pump(now);
+		else
+			ctx->caption_pacer->clear();
+	}
+
+	std::vector<KeywordTrigger> fired;
+	{
+		std::lock_guard<std::mutex> lock(ctx->trigger_mutex);
+		fired.swap(ctx->fired_triggers);
+	}
+	for (KeywordTrigger &trigger : fired)
+		obs_queue_task(OBS_TASK_UI, run_keyword_trigger, new KeywordTrigger(std::move(trigger)), false);
+
+	// All lines past their expiry go in one update
+	if (burn_in && ctx->subtitles_buffer->expireLines(now) && ctx->internal_text_source)
+		update_internal_text(ctx);
+
 	std::string asr_result;
 	{
 		std::lock_guard<std::mutex> lock(ctx->grpc_mutex);
-		if (!ctx || !ctx->grpc_client || !ctx->grpc_client->IsRunning()) return;
-		{
+		if (ctx->grpc_client && ctx->grpc_client->IsRunning()) {
 			std::lock_guard<std::mutex> lockq(ctx->grpc_client->queue_mutex);
 			if (!ctx->grpc_client->asr_results_queue.empty()) {
 				asr_result = ctx->grpc_client->asr_results_queue.front();
 				ctx->grpc_client->asr_results_queue.pop();
 			}
 		}
+		// Words the masker held back, once no result has come for a while;
+		// under grpc_mutex, which the transcript ring is replaced with
+		if (asr_result.empty()) {
+			std::lock_guard<std::mutex> lockr(ctx->result_mutex);
+			if (ctx->profanity_masker.holding() && now >= ctx->last_result_ns + ProfanityMasker::HOLD_NS) {
+				asr_result = ctx->profanity_masker.flush();
+				if (!asr_result.empty())
+					publish_result(ctx, now, asr_result);
+			}
+		}
 	}
-
-	if (!asr_result.empty() && ctx->internal_text_source) {
-		ctx->subtitles_buffer->addWord(asr_result);
+	if (asr_result.empty()) return;
+	if (ctx->caption_pacer && ctx->native_captions)
+		ctx->caption_pacer->push(asr_result, now);
+	if (burn_in && ctx->internal_text_source) {
+		ctx->subtitles_buffer->addWord(asr_result, now);
 		update_internal_text(ctx);
 	}
 }
@@ -503,6 +1231,22 @@ void asr_get_defaults(obs_data_t *settings) {
 	obs_data_set_default_int(settings, "server_port", asr_defaults::SERVER_PORT);
 	obs_data_set_default_int(settings, "max_lines", asr_defaults::MAX_LINES);
 	obs_data_set_default_int(settings, "max_chars_per_line", asr_defaults::MAX_CHARS_PER_LINE);
+	obs_data_set_default_double(settings, "caption_expiry", asr_defaults::CAPTION_EXPIRY);
+	obs_data_set_default_bool(settings, "transcript_log", asr_defaults::TRANSCRIPT_LOG);
+	obs_data_set_default_bool(settings, "transcript_ring", asr_defaults::TRANSCRIPT_RING);
+	obs_data_set_default_bool(settings, "session_capture", asr_defaults::SESSION_CAPTURE);
+	obs_data_set_default_bool(settings, "audio_spool", asr_defaults::AUDIO_SPOOL);
+	obs_data_set_default_bool(settings, "caption_sidecar", asr_defaults::CAPTION_SIDECAR);
+	obs_data_set_default_bool(settings, "native_captions", asr_defaults::NATIVE_CAPTIONS);
+	obs_data_set_default_bool(settings, "burn_in", asr_defaults::BURN_IN);
+	obs_data_set_default_string(settings, "keyword_triggers", asr_defaults::KEYWORD_TRIGGERS);
+	obs_data_set_default_bool(settings, "profanity_filter", asr_defaults::PROFANITY_FILTER);
+	obs_data_set_default_string(settings, "metrics_dir", asr_defaults::METRICS_DIR);
+	obs_data_set_default_bool(settings, "trace_pipeline", asr_defaults::TRACE_PIPELINE);
+	if (char *dir = obs_module_config_path("transcripts")) {
+		obs_data_set_default_string(settings, "transcript_dir", dir);
+		bfree(dir);
+	}
 }
 
 static struct obs_source_info asr_source_info = {
@@ -0,0 +1,45 @@
+#ifndef PROBES_H
+#define PROBES_H
+
+// USDT probes of the "sayo" provider, for bpftrace or perf on a live OBS
+// (tools/bpftrace/). Each is a nop and an ELF note, so with nothing attached
+// it costs the nop and its arguments; without <sys/sdt.h> (systemtap-sdt-dev)
+// they compile to nothing. Arguments are integers and pointers, the first
+// one the asr_source (0 outside the plugin). There are no timestamp arguments:
+// bpftrace's nsecs reads the same monotonic clock as os_gettime_ns().
+//
+// seq is the chunk's AudioChunk.seq, which pairs the probes of one chunk.
+//
+//   chunk_enqueue(source, seq, bytes, queued)  SendChunk, queued counts this chunk
+//   chunk_dequeue(source, seq, bytes, queued)  the sender thread took it
+//   write_start(source, seq, bytes)
+//   write_end(source, seq, bytes, ok)
+//   result_received(source, last_seq, text_bytes)  before the result handler; last_seq
+//                                           is 0 from servers that do not echo it
+//   subtitle_update(source, text_bytes)     the text source shows new text
+//   vad_transition(source, silent, obs_ns)  audio turned to or from digital silence,
+//                                           at the block's OBS timestamp
+#if defined(__has_include)
+#if __has_include(<sys/sdt.h>)
+#include <sys/sdt.h>
+#define SAYO_HAVE_PROBES 1
+#endif
+#endif
+
+#ifdef SAYO_HAVE_PROBES
+#define SAYO_PROBE2(name, a, b) DTRACE_PROBE2(sayo, name, a, b)
+#define SAYO_PROBE3(name, a, b, c) DTRACE_PROBE3(sayo, name, a, b, c)
+#define SAYO_PROBE4(name, a, b, c, d) DTRACE_PROBE4(sayo, name, a, b, c, d)
+#else
+#define SAYO_PROBE2(name, a, b) \
+	do {                    \
+	} while (0)
+#define SAYO_PROBE3(name, a, b, c) \
+	do {                       \
+	} while (0)
+#define SAYO_PROBE4(name, a, b, c, d) \
+	do {                          \
+	} while (0)
+#endif
+
+#endif
@@ -0,0 +1,145 @@
+#include "profanity_filter.h"
+#include "text_normalize.h"
+#include "utf8.h"
+#include <util/bmem.h>
+#include <util/platform.h>
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+std::shared_ptr<const ProfanityFilter> ProfanityFilter::compile(std::string_view list)
+{
+	std::vector<std::string> patterns;
+	while (!list.empty()) {
+		const size_t newline = list.find('\n');
+		const std::string_view line = list.substr(0, newline);
+		list = newline == std::string_view::npos ? std::string_view() : list.substr(newline + 1);
+		const size_t first = line.find_first_not_of(" \t\r");
+		if (first == std::string_view::npos || line[first] == '#')
+			continue;
+
+		// " word word " so only whole words match
+		std::string pattern = " ";
+		text_normalize::append(line, pattern);
+		if (pattern.size() > 1)
+			patterns.push_back(std::move(pattern));
+	}
+
+	auto filter = std::make_shared<ProfanityFilter>();
+	filter->automaton_ = AhoCorasick(patterns);
+	return filter;
+}
+
+std::shared_ptr<const ProfanityFilter> ProfanityFilter::load(const std::string &path)
+{
+	char *contents = os_quick_read_utf8_file(path.c_str());
+	if (!contents)
+		return nullptr;
+	auto filter = compile(contents);
+	bfree(contents);
+	return filter;
+}
+
+std::string ProfanityFilter::mask(std::string_view text) const
+{
+	if (automaton_.patternCount() == 0)
+		return std::string(text);
+	Ranges ranges;
+	find(text, {}, ranges);
+	if (ranges.empty())
+		return std::string(text);
+	return apply(text, text.size(), ranges);
+}
+
+size_t ProfanityFilter::find(std::string_view text, const std::vector<uint32_t> &boundaries, Ranges &ranges) const
+{
+	std::string normalized = " ";
+	std::vector<uint32_t> offsets{0};
+	uint32_t piece = 0;
+	for (size_t i = 0; i <= boundaries.size(); ++i) {
+		const uint32_t end = i < boundaries.size() ? boundaries[i] : static_cast<uint32_t>(text.size());
+		const size_t first = offsets.size();
+		text_normalize::append(text.substr(piece, end - piece), normalized, &offsets);
+		for (size_t j = first; j < offsets.size(); ++j)
+			offsets[j] += piece;
+		piece = end;
+	}
+
+	// Source byte ranges of the matches. A pattern spans its leading space to its
+	// trailing one, whose offsets are the word's first character and the end of the word.
+	uint32_t state = AhoCorasick::ROOT;
+	for (size_t i = 0; i < normalized.size(); ++i) {
+		state = automaton_.step(state, static_cast<uint8_t>(normalized[i]));
+		automaton_.matches(state, [&](const uint32_t pattern) {
+			const size_t leading = i + 1 - automaton_.patternLength(pattern);
+			ranges.emplace_back(offsets[leading + 1], offsets[i]);
+		});
+	}
+	std::sort(ranges.begin(), ranges.end());
+
+	// The space every pattern starts with is open after any text; a word more is not
+	const size_t open = automaton_.openLength(state);
+	if (open <= 1)
+		return text.size();
+	return offsets[normalized.size() - open + 1];
+}
+
+std::string ProfanityFilter::apply(std::string_view text, const size_t end, const Ranges &ranges)
+{
+	std::string result;
+	result.reserve(end);
+	auto range = ranges.begin();
+	uint32_t masked_until = 0;
+	size_t i = 0;
+	while (i < end) {
+		const size_t start = i;
+		const char32_t cp = utf8::decode(text, i);
+		for (; range != ranges.end() && range->first <= start; ++range)
+			masked_until = std::max(masked_until, range->second);
+		if (start >= masked_until)
+			result.append(text, start, i - start);
+		else if (cp >= 0x300 && cp <= 0x36F)
+			continue; // would sit on the mask
+		else if (text_normalize::isWordChar(cp))
+			result += MASK;
+		else
+			result.append(text, start, i - start);
+	}
+	return result;
+}
+
+std::string ProfanityMasker::feed(const ProfanityFilter *filter, std::string_view text)
+{
+	std::string input = std::move(held_);
+	std::vector<uint32_t> boundaries = std::move(held_boundaries_);
+	if (!input.empty())
+		boundaries.push_back(static_cast<uint32_t>(input.size()));
+	input += text;
+	held_.clear();
+	held_boundaries_.clear();
+
+	ProfanityFilter::Ranges ranges;
+	if (held_masked_ > 0)
+		ranges.emplace_back(0, held_masked_);
+	held_masked_ = 0;
+	if (!filter || filter->automaton().patternCount() == 0)
+		return ranges.empty() ? input : ProfanityFilter::apply(input, input.size(), ranges);
+
+	const size_t hold_from = filter->find(input, boundaries, ranges);
+	// Matches starting in the held words are found again with the next result
+	for (const auto &range : ranges) {
+		if (range.first < hold_from && range.second > hold_from)
+			held_masked_ = std::max(held_masked_, static_cast<uint32_t>(range.second - hold_from));
+	}
+	held_ = input.substr(hold_from);
+	for (const uint32_t boundary : boundaries) {
+		if (boundary > hold_from)
+			held_boundaries_.push_back(static_cast<uint32_t>(boundary - hold_from));
+	}
+	return ProfanityFilter::apply(input, hold_from, ranges);
+}
+
+std::string ProfanityMasker::flush()
+{
+	return feed(nullptr, {});
+}
@@ -0,0 +1,67 @@
+#ifndef PROFANITY_FILTER_H
+#define PROFANITY_FILTER_H
+
+#include "aho_corasick.h"
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// Masks listed words and phrases in results before they are shown. The list
+// is compiled once into an automaton over text_normalize'd words, so case,
+// ё/е and punctuation do not get a word through, and each result is masked
+// in one pass however long the list is. Immutable once built: a reloaded
+// list is a new filter, swapped in while the old one finishes its result.
+class ProfanityFilter {
+public:
+	// One word or phrase per line; blank lines and lines starting with # are skipped.
+	static std::shared_ptr<const ProfanityFilter> compile(std::string_view list);
+	// compile() on the contents of a UTF-8 file; nullptr when it cannot be read.
+	static std::shared_ptr<const ProfanityFilter> load(const std::string &path);
+
+	// text with every letter and digit of each match replaced by MASK.
+	[[nodiscard]] std::string mask(std::string_view text) const;
+
+	[[nodiscard]] size_t wordCount() const { return automaton_.patternCount(); }
+	[[nodiscard]] const AhoCorasick &automaton() const { return automaton_; }
+
+	static constexpr char MASK = '*';
+
+private:
+	friend class ProfanityMasker;
+	using Ranges = std::vector<std::pair<uint32_t, uint32_t>>;
+
+	// Adds the source byte ranges of the matches in text to ranges and sorts
+	// them. A word also ends at each of the ascending boundaries, where one
+	// result ends and the next begins. Returns where a match may still be
+	// starting, text.size() if nowhere.
+	size_t find(std::string_view text, const std::vector<uint32_t> &boundaries, Ranges &ranges) const;
+	// The first end bytes of text with the sorted ranges masked.
+	static std::string apply(std::string_view text, size_t end, const Ranges &ranges);
+
+	AhoCorasick automaton_;
+};
+
+// Masks the successive results of one source, so a phrase split between two
+// results is masked too. Words at the end of a result that a listed phrase
+// could start with are held back until the next result shows whether it
+// does, or until flush(). Used by one thread at a time.
+class ProfanityMasker {
+public:
+	// The held-back words and text, masked, short of what is held back now;
+	// empty when all of it is. Without a filter nothing is held back.
+	std::string feed(const ProfanityFilter *filter, std::string_view text);
+	// Whatever is held back, masked as far as its matches are known.
+	std::string flush();
+	[[nodiscard]] bool holding() const { return !held_.empty(); }
+
+	static constexpr uint64_t HOLD_NS = 1500000000; // without a result, flush() after this long
+
+private:
+	std::string held_;
+	std::vector<uint32_t> held_boundaries_; // where results begin within held_, after its start
+	uint32_t held_masked_ = 0;              // leading bytes of held_ inside a match found already
+};
+
+#endif
@@ -1,16 +1,33 @@
 #include "grpc_client.h"
+#include "metrics_interceptor.h"
 #include "sayo.grpc.pb.h"
+#include "../session_capture.h"
+#include "../audio_spool.h"
+#include "../source_metrics.h"
+#include "../probes.h"
+#include "../trace.h"
 #include <obs-module.h>
 #include <plugin-support.h>
+#include <util/platform.h>
 
 ASRGrpcClient::ASRGrpcClient(const std::string& server, const int port, asr_source* context)
     : ctx_(context)
 {
-    const std::string address = server + ":" + std::to_string(port);
-    channel_ = grpc::CreateChannel(address, grpc::InsecureChannelCredentials());
+    // The channel owns the factory; metrics_interceptor_ lives as long as channel_
+    auto interceptor = std::make_unique<MetricsInterceptorFactory>();
+    metrics_interceptor_ = interceptor.get();
+    std::vector<std::unique_ptr<grpc::experimental::ClientInterceptorFactoryInterface>> interceptors;
+    interceptors.push_back(std::move(interceptor));
+    channel_ = grpc::experimental::CreateCustomChannelWithInterceptors(server + ":" + std::to_string(port),
+        grpc::InsecureChannelCredentials(), grpc::ChannelArguments(), std::move(interceptors));
     stub_ = sayo::SayoService::NewStub(channel_);
 }
 
+ASRGrpcClient::ASRGrpcClient(std::shared_ptr<grpc::Channel> channel, asr_source* context)
+    : channel_(std::move(channel)), stub_(sayo::SayoService::NewStub(channel_)), ctx_(context)
+{
+}
+
 ASRGrpcClient::~ASRGrpcClient() {
     Stop();
 }
@@ -20,6 +37,7 @@ void ASRGrpcClient::Start() {
     running_ = true;
     context_ = std::make_unique<grpc::ClientContext>();
     stream_ = stub_->StreamingASR(context_.get());
+    stream_ok_ = static_cast<bool>(stream_);
 
     sender_thread_ = std::thread(&ASRGrpcClient::SenderLoop, this);
     receiver_thread_ = std::thread(&ASRGrpcClient::ReceiverLoop, this);
@@ -32,49 +50,94 @@ void ASRGrpcClient::Stop() {
     cv_.notify_all();
 
     if (context_) context_->TryCancel();
+    if (catchup_context_) catchup_context_->TryCancel();
     if (stream_) stream_->WritesDone();
 
     if (sender_thread_.joinable()) sender_thread_.join();
     if (receiver_thread_.joinable()) receiver_thread_.join();
+    if (catchup_sender_thread_.joinable()) catchup_sender_thread_.join();
+    if (catchup_receiver_thread_.joinable()) catchup_receiver_thread_.join();
 
     if (stream_) {
         grpc::Status status = stream_->Finish();
         obs_log(LOG_ERROR, "grpc_client: Finished with status: %s", status.error_message().c_str());
     }
+    if (catchup_stream_) {
+        grpc::Status status = catchup_stream_->Finish();
+        obs_log(LOG_INFO, "grpc_client: Catch-up finished with status: %s", status.error_message().c_str());
+    }
 }
 
 
-void ASRGrpcClient::SendChunk(const std::vector<char>& chunk) {
-    if (!stream_ || !running_) return;
+bool ASRGrpcClient::SendChunk(const std::vector<char>& chunk) {
+    if (!stream_ || !running_ || !stream_ok_) return false;
+    if (capture_) capture_->audio(chunk);
 
     {
         std::lock_guard<std::mutex> lock(queue_mutex);
-        audio_queue_.push(chunk);
+        audio_queue_.push({chunk, next_seq_++, os_gettime_ns()});
+        SAYO_PROBE4(chunk_enqueue, ctx_, audio_queue_.back().seq, chunk.size(), audio_queue_.size());
     }
     cv_.notify_one();
+    return true;
+}
+
+size_t ASRGrpcClient::QueuedChunks() {
+    std::lock_guard<std::mutex> lock(queue_mutex);
+    return audio_queue_.size();
+}
+
+size_t ASRGrpcClient::QueuedResults() {
+    std::lock_guard<std::mutex> lock(queue_mutex);
+    return asr_results_queue.size();
 }
 
 void ASRGrpcClient::SenderLoop() {
+    trace::nameThread("SenderLoop");
     while (running_ && stream_) {
-        std::vector<char> chunk;
+        QueuedChunk queued;
         {
             std::unique_lock<std::mutex> lock(queue_mutex);
             cv_.wait(lock, [&] { return !audio_queue_.empty() || !running_; });
             if (!running_) break;
-            chunk = std::move(audio_queue_.front());
+            queued = std::move(audio_queue_.front());
             audio_queue_.pop();
+            SAYO_PROBE4(chunk_dequeue, ctx_, queued.seq, queued.pcm.size(), audio_queue_.size());
         }
+        TRACE_SPAN("SenderLoop write");
+        const std::vector<char>& chunk = queued.pcm;
+        const uint64_t write_start = os_gettime_ns();
         sayo::AudioChunk msg;
         msg.set_pcm(reinterpret_cast<const char*>(chunk.data()), chunk.size());
-        if (!stream_->Write(msg)) {
+        msg.set_seq(queued.seq);
+        msg.set_client_send_ns(write_start);
+        msg.set_capture_ns(queued.queued_ns);
+        {
+            // Before Write, as the result may be read before Write returns
+            std::lock_guard<std::mutex> lock(sent_mutex_);
+            sent_[queued.seq % SENT_HISTORY] = {queued.seq, queued.queued_ns, write_start};
+        }
+        if (metrics_) metrics_->queue_wait.record(write_start - queued.queued_ns);
+        SAYO_PROBE3(write_start, ctx_, queued.seq, chunk.size());
+        const bool written = stream_->Write(msg);
+        SAYO_PROBE4(write_end, ctx_, queued.seq, chunk.size(), written);
+        if (!written) {
             obs_log(LOG_ERROR, "[SenderLoop] Failed to write audio chunk, exiting loop");
+            if (metrics_) ++metrics_->write_failures;
+            stream_ok_ = false;
             break;
         }
+        if (metrics_) {
+            metrics_->write.record(os_gettime_ns() - write_start);
+            ++metrics_->chunks_sent;
+            metrics_->bytes_sent += chunk.size();
+        }
     }
     obs_log(LOG_INFO, "SenderLoop: finished");
 }
 
 void ASRGrpcClient::ReceiverLoop() {
+    trace::nameThread("ReceiverLoop");
     sayo::ASRResult result;
     while (running_ && stream_) {
         if (!stream_) {
@@ -82,22 +145,134 @@ void ASRGrpcClient::ReceiverLoop() {
             break;
         }
 
+        const uint64_t read_start = metrics_ ? os_gettime_ns() : 0;
         if (!stream_->Read(&result)) {
             obs_log(LOG_INFO, "[ReceiverLoop] Failed to read text (server closed stream?)");
+            stream_ok_ = false;
             break;
         }
+        if (metrics_) metrics_->read.record(os_gettime_ns() - read_start);
 
         if (!running_) break;
 
+        TRACE_SPAN("ReceiverLoop result");
+        if (metrics_) RecordResultTimes(result, os_gettime_ns());
         const std::string &text = result.text();
+        SAYO_PROBE3(result_received, ctx_, result.last_seq(), text.size());
         if (!text.empty()) {
-            std::lock_guard<std::mutex> lock(queue_mutex);
-            asr_results_queue.push(text);
+            if (capture_) capture_->result(text);
+            std::string shown = result_handler_ ? result_handler_(text) : text;
+            if (!shown.empty()) {
+                std::lock_guard<std::mutex> lock(queue_mutex);
+                asr_results_queue.push(std::move(shown));
+            }
         }
     }
     obs_log(LOG_INFO, "ReceiverLoop: finished");
 }
 
+void ASRGrpcClient::RecordResultTimes(const sayo::ASRResult& result, const uint64_t received_ns) {
+    // Servers that do not echo seq leave these to result_latency's estimate
+    const uint64_t seq = result.last_seq();
+    if (seq == 0) return;
+    SentChunk sent;
+    {
+        std::lock_guard<std::mutex> lock(sent_mutex_);
+        sent = sent_[seq % SENT_HISTORY];
+    }
+    if (sent.seq != seq || received_ns < sent.written_ns) return; // unknown or overwritten
+
+    metrics_->chunk_to_result.record(received_ns - sent.queued_ns);
+
+    // The server's own figure, so only trusted when it fits in the round trip
+    // this client measured; 0 means the server does not report it
+    const uint64_t round_trip = received_ns - sent.written_ns;
+    const uint64_t server = result.server_processing_ns();
+    if (server == 0 || server > round_trip) return;
+    metrics_->inference.record(server);
+    metrics_->network.record(round_trip - server);
+}
+
+void ASRGrpcClient::SetResultHandler(ResultHandler handler) {
+    result_handler_ = std::move(handler);
+}
+
+void ASRGrpcClient::SetCapture(SessionCaptureWriter* capture) {
+    capture_ = capture;
+}
+
+void ASRGrpcClient::SetMetrics(SourceMetrics* metrics) {
+    metrics_ = metrics;
+    if (metrics_interceptor_) metrics_interceptor_->SetMetrics(metrics);
+}
+
+void ASRGrpcClient::StartCatchUp(AudioSpool* spool, BacklogHandler handler) {
+    if (!running_ || !spool || catchup_stream_) return;
+    catchup_spool_ = spool;
+    backlog_handler_ = std::move(handler);
+    catchup_context_ = std::make_unique<grpc::ClientContext>();
+    catchup_stream_ = stub_->StreamingASR(catchup_context_.get());
+    if (!catchup_stream_) return;
+
+    obs_log(LOG_INFO, "Catching up on %llu bytes of spooled audio",
+            static_cast<unsigned long long>(spool->backlogBytes()));
+    catchup_sender_thread_ = std::thread(&ASRGrpcClient::CatchUpSenderLoop, this);
+    catchup_receiver_thread_ = std::thread(&ASRGrpcClient::CatchUpReceiverLoop, this);
+}
+
+void ASRGrpcClient::CatchUpSenderLoop() {
+    const auto start = std::chrono::steady_clock::now();
+    double sent_seconds = 0;
+    std::vector<char> chunk;
+    uint64_t time_ns;
+    uint64_t seq = 0;
+    while (running_ && catchup_spool_->peek(chunk, time_ns)) {
+        // Faster than real time, but not so fast that the live stream waits on the server
+        std::this_thread::sleep_until(start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double>(sent_seconds / CATCH_UP_SPEED)));
+        if (!running_) break;
+
+        sayo::AudioChunk msg;
+        msg.set_pcm(chunk.data(), chunk.size());
+        msg.set_seq(++seq);
+        msg.set_capture_ns(time_ns);
+        {
+            std::lock_guard<std::mutex> lock(catchup_mutex_);
+            catchup_sent_.push_back({seq, time_ns});
+            if (catchup_sent_.size() > SENT_HISTORY) catchup_sent_.pop_front();
+        }
+        msg.set_client_send_ns(os_gettime_ns());
+        if (!catchup_stream_->Write(msg)) {
+            // The chunk stays spooled for the next catch-up
+            obs_log(LOG_ERROR, "[CatchUpSenderLoop] Failed to write audio chunk, exiting loop");
+            break;
+        }
+        catchup_spool_->pop();
+        sent_seconds += static_cast<double>(chunk.size()) / (sizeof(float) * SAMPLE_RATE);
+    }
+    catchup_stream_->WritesDone();
+    obs_log(LOG_INFO, "CatchUpSenderLoop: finished after %.1f s of audio", sent_seconds);
+}
+
+void ASRGrpcClient::CatchUpReceiverLoop() {
+    sayo::ASRResult result;
+    while (running_ && catchup_stream_->Read(&result)) {
+        if (!result.text().empty() && backlog_handler_)
+            backlog_handler_(result.text(), CatchUpCaptureTime(result.last_seq()));
+    }
+    obs_log(LOG_INFO, "CatchUpReceiverLoop: finished");
+}
+
+uint64_t ASRGrpcClient::CatchUpCaptureTime(const uint64_t last_seq) {
+    std::lock_guard<std::mutex> lock(catchup_mutex_);
+    if (catchup_sent_.empty()) return 0;
+    // Servers that do not echo seq get the newest chunk written
+    if (last_seq == 0) return catchup_sent_.back().capture_ns;
+    // Later results may name the same chunk again, so it stays
+    while (catchup_sent_.size() > 1 && catchup_sent_.front().seq < last_seq) catchup_sent_.pop_front();
+    return catchup_sent_.front().capture_ns;
+}
+
 bool ASRGrpcClient::IsRunning() {
     return running_;
 }
@@ -11,24 +11,54 @@
 #include <grpcpp/grpcpp.h>
 #include <thread>
 #include <atomic>
+#include <deque>
 #include <queue>
 #include <mutex>
 #include <condition_variable>
+#include <array>
+#include <functional>
 #include <string>
 #include <vector>
 
 struct asr_source; // Forward declaration
+class SessionCaptureWriter;
+class MetricsInterceptorFactory;
+class AudioSpool;
+struct SourceMetrics;
 
 class ASRGrpcClient {
 public:
+    // Runs on the receiver thread for every non-empty result; returns the text to queue for the tick,
+    // nothing when empty
+    using ResultHandler = std::function<std::string(const std::string& text)>;
+    // Runs on the catch-up receiver thread; audio_time_ns is when the latest backlog chunk sent was captured
+    using BacklogHandler = std::function<void(const std::string& text, uint64_t audio_time_ns)>;
+
     ASRGrpcClient(const std::string& server, int port, asr_source* context);
+    // Over an existing channel, e.g. grpc::Server::InProcessChannel() in the transport benchmark; without
+    // the metrics interceptor, so SetMetrics() leaves the RPC statistics alone
+    ASRGrpcClient(std::shared_ptr<grpc::Channel> channel, asr_source* context);
     ~ASRGrpcClient();
 
     void Start();
     void Stop();
-    void SendChunk(const std::vector<char>& chunk);
+    // False when the chunk was not queued: not started, or the stream has failed
+    bool SendChunk(const std::vector<char>& chunk);
     bool IsRunning();
+    // Chunks waiting for the sender thread, and results waiting for the next video tick
+    size_t QueuedChunks();
+    size_t QueuedResults();
     [[nodiscard]] bool TestConnection() const;
+    void SetResultHandler(ResultHandler handler); // before Start()
+    void SetCapture(SessionCaptureWriter* capture); // before Start(); records sent chunks and results
+    // Before TestConnection() and Start(); times stream writes and reads, and counts every message of the calls
+    void SetMetrics(SourceMetrics* metrics);
+    // After Start(): drains the spool on a second StreamingASR call next to the live one
+    void StartCatchUp(AudioSpool* spool, BacklogHandler handler);
+
+    static constexpr int SAMPLE_RATE = 16000;     // AudioChunk.pcm, float32 mono
+    static constexpr double CATCH_UP_SPEED = 4.0; // backlog pace, in multiples of real time
+    static constexpr size_t SENT_HISTORY = 1024;  // chunks whose times a result can still refer to
 
     std::queue<std::string> asr_results_queue;
     std::mutex queue_mutex;
@@ -41,15 +71,54 @@ private:
 
 
     std::atomic<bool> running_{false};
+    std::atomic<bool> stream_ok_{false};
     std::thread sender_thread_;
     std::thread receiver_thread_;
     std::condition_variable cv_;
-    std::queue<std::vector<char>> audio_queue_;
+
+    struct QueuedChunk {
+        std::vector<char> pcm;
+        uint64_t seq;
+        uint64_t queued_ns;
+    };
+    std::queue<QueuedChunk> audio_queue_;
+    uint64_t next_seq_ = 1; // under queue_mutex
+
+    // Written chunks by seq % SENT_HISTORY, for the results that echo their seq
+    struct SentChunk {
+        uint64_t seq = 0;
+        uint64_t queued_ns = 0;
+        uint64_t written_ns = 0;
+    };
+    std::array<SentChunk, SENT_HISTORY> sent_{};
+    std::mutex sent_mutex_;
 
     asr_source* ctx_;
+    ResultHandler result_handler_;
+    SessionCaptureWriter* capture_ = nullptr;
+    SourceMetrics* metrics_ = nullptr;
+    MetricsInterceptorFactory* metrics_interceptor_ = nullptr; // owned by channel_
+
+    std::unique_ptr<grpc::ClientContext> catchup_context_;
+    std::unique_ptr<grpc::ClientReaderWriter<sayo::AudioChunk, sayo::ASRResult>> catchup_stream_;
+    std::thread catchup_sender_thread_;
+    std::thread catchup_receiver_thread_;
+    AudioSpool* catchup_spool_ = nullptr;
+    BacklogHandler backlog_handler_;
+    // Capture time of each backlog chunk written, by seq, oldest first
+    struct CatchUpChunk {
+        uint64_t seq;
+        uint64_t capture_ns;
+    };
+    std::deque<CatchUpChunk> catchup_sent_;
+    std::mutex catchup_mutex_;
 
     void SenderLoop();
     void ReceiverLoop();
+    void CatchUpSenderLoop();
+    void CatchUpReceiverLoop();
+    uint64_t CatchUpCaptureTime(uint64_t last_seq);
+    void RecordResultTimes(const sayo::ASRResult& result, uint64_t received_ns);
 };
 
 #endif //GRPC_CLIENT_H
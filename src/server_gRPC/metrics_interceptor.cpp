@@ -0,0 +1,77 @@
+#include "metrics_interceptor.h"
+#include "sayo.pb.h"
+#include "../source_metrics.h"
+#include <grpcpp/support/byte_buffer.h>
+#include <util/platform.h>
+#include <cstring>
+
+namespace {
+
+using grpc::experimental::InterceptionHookPoints;
+using grpc::experimental::InterceptorBatchMethods;
+
+template <class Response>
+size_t ResponseBytes(const void* message) {
+    return static_cast<const Response*>(message)->ByteSizeLong();
+}
+
+// One per call. The sender and the receiver thread of a stream intercept at
+// the same time, so the send and the receive fields each belong to one side.
+class MetricsInterceptor : public grpc::experimental::Interceptor {
+public:
+    MetricsInterceptor(RpcMetrics& metrics, size_t (*response_bytes)(const void*))
+        : metrics_(metrics), response_bytes_(response_bytes)
+    {
+        ++metrics_.calls;
+    }
+
+    void Intercept(InterceptorBatchMethods* methods) override {
+        const uint64_t now = os_gettime_ns();
+        if (methods->QueryInterceptionHookPoint(InterceptionHookPoints::PRE_SEND_MESSAGE)) {
+            // Serialises the message here rather than later in the batch, to time it
+            const grpc::ByteBuffer* buffer = methods->GetSerializedSendMessage();
+            metrics_.serialize.record(os_gettime_ns() - now);
+            ++metrics_.messages_sent;
+            if (buffer) metrics_.bytes_sent += buffer->Length();
+            if (last_send_ns_) metrics_.send_gap.record(now - last_send_ns_);
+            last_send_ns_ = now;
+        }
+        if (methods->QueryInterceptionHookPoint(InterceptionHookPoints::POST_RECV_MESSAGE)) {
+            // nullptr when the stream ended instead
+            if (const void* message = methods->GetRecvMessage()) {
+                ++metrics_.messages_received;
+                metrics_.bytes_received += response_bytes_(message);
+                if (last_receive_ns_) metrics_.receive_gap.record(now - last_receive_ns_);
+                last_receive_ns_ = now;
+            }
+        }
+        if (methods->QueryInterceptionHookPoint(InterceptionHookPoints::POST_RECV_STATUS)) {
+            const grpc::Status* status = methods->GetRecvStatus();
+            if (status && !status->ok()) ++metrics_.failed_calls;
+        }
+        methods->Proceed();
+    }
+
+private:
+    RpcMetrics& metrics_;
+    size_t (*const response_bytes_)(const void*);
+    uint64_t last_send_ns_ = 0;
+    uint64_t last_receive_ns_ = 0;
+};
+
+} // namespace
+
+void MetricsInterceptorFactory::SetMetrics(SourceMetrics* metrics) {
+    metrics_ = metrics;
+}
+
+grpc::experimental::Interceptor* MetricsInterceptorFactory::CreateClientInterceptor(
+    grpc::experimental::ClientRpcInfo* info) {
+    SourceMetrics* metrics = metrics_;
+    if (!metrics || !info->method()) return nullptr;
+    if (!strcmp(info->method(), "/sayo.SayoService/StreamingASR"))
+        return new MetricsInterceptor(metrics->streaming_asr, &ResponseBytes<sayo::ASRResult>);
+    if (!strcmp(info->method(), "/sayo.SayoService/Ping"))
+        return new MetricsInterceptor(metrics->ping, &ResponseBytes<sayo::PingResponse>);
+    return nullptr;
+}
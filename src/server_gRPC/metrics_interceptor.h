@@ -0,0 +1,24 @@
+#ifndef METRICS_INTERCEPTOR_H
+#define METRICS_INTERCEPTOR_H
+#pragma once
+
+#include <grpcpp/support/client_interceptor.h>
+#include <atomic>
+
+struct SourceMetrics;
+
+// Installed on ASRGrpcClient's channel: counts and times every message of
+// StreamingASR and Ping into the RpcMetrics of the source's SourceMetrics.
+// Calls of other methods, and calls while no metrics are set, pass untouched.
+class MetricsInterceptorFactory : public grpc::experimental::ClientInterceptorFactoryInterface {
+public:
+    // Calls started afterwards record into metrics; nullptr stops recording
+    void SetMetrics(SourceMetrics* metrics);
+
+    grpc::experimental::Interceptor* CreateClientInterceptor(grpc::experimental::ClientRpcInfo* info) override;
+
+private:
+    std::atomic<SourceMetrics*> metrics_{nullptr};
+};
+
+#endif //METRICS_INTERCEPTOR_H
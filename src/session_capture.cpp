@@ -0,0 +1,191 @@
+#include "session_capture.h"
+#include "varint.h"
+#include <util/platform.h>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+namespace {
+
+constexpr char MAGIC[8] = {'S', 'A', 'Y', 'O', 'C', 'A', 'P', '1'};
+constexpr uint32_t VERSION = 1;
+constexpr size_t HEADER_SIZE = 32;
+constexpr size_t FILE_BUFFER = 1 << 20;
+constexpr size_t MAX_RECORD = 16 << 20;
+
+uint64_t monotonicNs()
+{
+	return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+void putLe(uint8_t *out, uint64_t value, const size_t bytes)
+{
+	for (size_t i = 0; i < bytes; ++i, value >>= 8)
+		out[i] = static_cast<uint8_t>(value);
+}
+
+uint64_t getLe(const uint8_t *in, const size_t bytes)
+{
+	uint64_t value = 0;
+	for (size_t i = bytes; i-- > 0;)
+		value = value << 8 | in[i];
+	return value;
+}
+
+bool readVarint(FILE *file, uint64_t &value)
+{
+	value = 0;
+	for (unsigned shift = 0; shift < 64; shift += 7) {
+		const int byte = fgetc(file);
+		if (byte == EOF)
+			return false;
+		value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+		if (!(byte & 0x80))
+			return true;
+	}
+	return false;
+}
+
+} // namespace
+
+SessionCaptureWriter::~SessionCaptureWriter()
+{
+	close();
+}
+
+bool SessionCaptureWriter::open(const std::string &path, const uint32_t sample_rate)
+{
+	close();
+	file_ = os_fopen(path.c_str(), "wb");
+	if (!file_)
+		return false;
+	setvbuf(file_, nullptr, _IOFBF, FILE_BUFFER);
+
+	uint8_t header[HEADER_SIZE] = {};
+	std::memcpy(header, MAGIC, sizeof(MAGIC));
+	putLe(header + 8, VERSION, 4);
+	putLe(header + 12, sample_rate, 4);
+	putLe(header + 16, static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::system_clock::now().time_since_epoch()).count()), 8);
+	fwrite(header, 1, sizeof(header), file_);
+
+	start_ns_ = monotonicNs();
+	last_us_ = 0;
+	stop_ = false;
+	thread_ = std::thread(&SessionCaptureWriter::run, this);
+	return true;
+}
+
+void SessionCaptureWriter::close()
+{
+	if (!thread_.joinable())
+		return;
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		stop_ = true;
+	}
+	cv_.notify_one();
+	thread_.join();
+	fclose(file_);
+	file_ = nullptr;
+}
+
+void SessionCaptureWriter::audio(const std::vector<char> &chunk)
+{
+	push(session_capture::RecordType::Audio, chunk.data(), chunk.size());
+}
+
+void SessionCaptureWriter::result(std::string_view text)
+{
+	push(session_capture::RecordType::Result, text.data(), text.size());
+}
+
+void SessionCaptureWriter::push(const session_capture::RecordType type, const char *data, const size_t size)
+{
+	const uint64_t now = monotonicNs();
+	std::lock_guard<std::mutex> lock(mutex_);
+	if (!thread_.joinable() || stop_)
+		return;
+	queue_.push_back(Item{type, now, std::string(data, size)});
+	cv_.notify_one();
+}
+
+void SessionCaptureWriter::run()
+{
+	std::vector<Item> batch;
+	std::unique_lock<std::mutex> lock(mutex_);
+	while (true) {
+		cv_.wait(lock, [this] { return !queue_.empty() || stop_; });
+		batch.swap(queue_);
+		const bool stop = stop_;
+		lock.unlock();
+
+		for (const Item &item : batch) {
+			// Audio and results are queued from different threads and may be a little out of order
+			const uint64_t time_us = std::max((item.time_ns - std::min(item.time_ns, start_ns_)) / 1000, last_us_);
+			uint8_t prefix[1 + 2 * varint::MAX_BYTES];
+			prefix[0] = static_cast<uint8_t>(item.type);
+			uint8_t *end = varint::encode(time_us - last_us_, prefix + 1);
+			end = varint::encode(item.data.size(), end);
+			fwrite(prefix, 1, static_cast<size_t>(end - prefix), file_);
+			fwrite(item.data.data(), 1, item.data.size(), file_);
+			last_us_ = time_us;
+		}
+		batch.clear();
+
+		if (stop)
+			break;
+		lock.lock();
+	}
+	fflush(file_);
+}
+
+SessionCaptureReader::~SessionCaptureReader()
+{
+	if (file_)
+		fclose(file_);
+}
+
+bool SessionCaptureReader::open(const std::string &path)
+{
+	if (file_)
+		fclose(file_);
+	file_ = os_fopen(path.c_str(), "rb");
+	if (!file_)
+		return false;
+	setvbuf(file_, nullptr, _IOFBF, FILE_BUFFER);
+
+	uint8_t header[HEADER_SIZE];
+	if (fread(header, 1, sizeof(header), file_) != sizeof(header) || std::memcmp(header, MAGIC, sizeof(MAGIC)) != 0 ||
+	    getLe(header + 8, 4) != VERSION) {
+		fclose(file_);
+		file_ = nullptr;
+		return false;
+	}
+	sample_rate_ = static_cast<uint32_t>(getLe(header + 12, 4));
+	start_unix_ns_ = getLe(header + 16, 8);
+	time_us_ = 0;
+	return true;
+}
+
+bool SessionCaptureReader::next(session_capture::Record &record)
+{
+	if (!file_)
+		return false;
+	const int type = fgetc(file_);
+	uint64_t delta, length;
+	if (type == EOF || !readVarint(file_, delta) || !readVarint(file_, length) || length > MAX_RECORD)
+		return false;
+	if (type != static_cast<int>(session_capture::RecordType::Audio) &&
+	    type != static_cast<int>(session_capture::RecordType::Result))
+		return false;
+
+	record.type = static_cast<session_capture::RecordType>(type);
+	record.data.resize(length);
+	if (fread(record.data.data(), 1, length, file_) != length)
+		return false;
+	time_us_ += delta;
+	record.time_us = time_us_;
+	return true;
+}
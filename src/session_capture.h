@@ -0,0 +1,91 @@
+#ifndef SESSION_CAPTURE_H
+#define SESSION_CAPTURE_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+// Binary capture of one streaming session: every audio chunk handed to
+// ASRGrpcClient::SendChunk and every result it received, with monotonic
+// timestamps, so a session can be replayed (tools/sayo-replay.cpp).
+//
+// Layout: a 32-byte header (magic "SAYOCAP1", version, sample rate,
+// wall-clock start) followed by records of
+//   type byte, varint time delta in microseconds, varint length, payload.
+// Audio payloads are the exact float32 PCM bytes that were sent; result
+// payloads are the UTF-8 text.
+namespace session_capture {
+
+enum class RecordType : uint8_t { Audio = 1, Result = 2 };
+
+struct Record {
+	RecordType type;
+	uint64_t time_us; // since the capture started
+	std::string data;
+};
+
+} // namespace session_capture
+
+// Writing happens on the capture's own thread in batches, so the audio and
+// gRPC threads only copy the chunk into a queue.
+class SessionCaptureWriter {
+public:
+	SessionCaptureWriter() = default;
+	SessionCaptureWriter(const SessionCaptureWriter &) = delete;
+	SessionCaptureWriter &operator=(const SessionCaptureWriter &) = delete;
+	~SessionCaptureWriter();
+
+	bool open(const std::string &path, uint32_t sample_rate);
+	void close();
+
+	void audio(const std::vector<char> &chunk);
+	void result(std::string_view text);
+
+private:
+	struct Item {
+		session_capture::RecordType type;
+		uint64_t time_ns;
+		std::string data;
+	};
+
+	void push(session_capture::RecordType type, const char *data, size_t size);
+	void run();
+
+	FILE *file_ = nullptr;
+	uint64_t start_ns_ = 0;
+	uint64_t last_us_ = 0; // writer thread only
+
+	std::mutex mutex_;
+	std::condition_variable cv_;
+	std::vector<Item> queue_;
+	bool stop_ = false;
+	std::thread thread_;
+};
+
+class SessionCaptureReader {
+public:
+	SessionCaptureReader() = default;
+	SessionCaptureReader(const SessionCaptureReader &) = delete;
+	SessionCaptureReader &operator=(const SessionCaptureReader &) = delete;
+	~SessionCaptureReader();
+
+	bool open(const std::string &path);
+	// False at the end of the file or on a damaged record.
+	bool next(session_capture::Record &record);
+
+	[[nodiscard]] uint32_t sampleRate() const { return sample_rate_; }
+	[[nodiscard]] uint64_t startUnixNs() const { return start_unix_ns_; }
+
+private:
+	FILE *file_ = nullptr;
+	uint32_t sample_rate_ = 0;
+	uint64_t start_unix_ns_ = 0;
+	uint64_t time_us_ = 0;
+};
+
+#endif
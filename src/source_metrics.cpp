@@ -0,0 +1,306 @@
+#include "source_metrics.h"
+#include <obs-module.h>
+#include <plugin-support.h>
+#include <util/platform.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdarg>
+#include <cstdio>
+#include <initializer_list>
+
+namespace {
+
+std::string escapeLabel(const std::string &value)
+{
+	std::string escaped;
+	escaped.reserve(value.size());
+	for (const char c : value) {
+		if (c == '\\' || c == '"')
+			escaped += '\\';
+		if (c == '\n')
+			escaped += "\\n";
+		else
+			escaped += c;
+	}
+	return escaped;
+}
+
+void appendf(std::string &out, const char *format, ...)
+{
+	char line[512];
+	va_list args;
+	va_start(args, format);
+	const int n = vsnprintf(line, sizeof(line), format, args);
+	va_end(args);
+	if (n > 0)
+		out.append(line, std::min(static_cast<size_t>(n), sizeof(line) - 1));
+}
+
+void appendHeader(std::string &out, const char *name, const char *help, const char *type)
+{
+	appendf(out, "# HELP sayo_%s %s\n# TYPE sayo_%s %s\n", name, help, name, type);
+}
+
+void appendCounter(std::string &out, const char *name, const char *help, const std::string &labels,
+		   const uint64_t value)
+{
+	appendHeader(out, name, help, "counter");
+	appendf(out, "sayo_%s{%s} %llu\n", name, labels.c_str(), static_cast<unsigned long long>(value));
+}
+
+void appendGauge(std::string &out, const char *name, const char *help, const std::string &labels, const double value)
+{
+	appendHeader(out, name, help, "gauge");
+	appendf(out, "sayo_%s{%s} %.6g\n", name, labels.c_str(), value);
+}
+
+void appendSummarySeries(std::string &out, const char *name, const std::string &labels,
+			 const DurationHistogram::Snapshot &snapshot)
+{
+	for (const double q : {0.5, 0.9, 0.99, 0.999})
+		appendf(out, "sayo_%s{%s,quantile=\"%g\"} %.6g\n", name, labels.c_str(), q,
+			snapshot.percentileMs(q) / 1000.0);
+	appendf(out, "sayo_%s_sum{%s} %.6g\n", name, labels.c_str(), static_cast<double>(snapshot.sum_us) / 1e6);
+	appendf(out, "sayo_%s_count{%s} %llu\n", name, labels.c_str(), static_cast<unsigned long long>(snapshot.count));
+}
+
+void appendSummary(std::string &out, const char *name, const char *help, const std::string &labels,
+		   const DurationHistogram::Snapshot &snapshot)
+{
+	appendHeader(out, name, help, "summary");
+	appendSummarySeries(out, name, labels, snapshot);
+}
+
+// Each series once per method, under one header
+struct RpcSeries {
+	const char *method;
+	const RpcMetrics &metrics;
+};
+
+void appendRpcCounter(std::string &out, const char *name, const char *help, const std::string &labels,
+		      const std::initializer_list<RpcSeries> rpcs, std::atomic<uint64_t> RpcMetrics::*counter)
+{
+	appendHeader(out, name, help, "counter");
+	for (const RpcSeries &rpc : rpcs)
+		appendf(out, "sayo_%s{%s,method=\"%s\"} %llu\n", name, labels.c_str(), rpc.method,
+			static_cast<unsigned long long>((rpc.metrics.*counter).load()));
+}
+
+void appendRpcSummary(std::string &out, const char *name, const char *help, const std::string &labels,
+		      const std::initializer_list<RpcSeries> rpcs, DurationHistogram RpcMetrics::*histogram)
+{
+	appendHeader(out, name, help, "summary");
+	for (const RpcSeries &rpc : rpcs)
+		appendSummarySeries(out, name, labels + ",method=\"" + rpc.method + "\"",
+				    (rpc.metrics.*histogram).snapshot());
+}
+
+} // namespace
+
+void DurationHistogram::record(const uint64_t ns)
+{
+	const uint64_t us = ns / 1000;
+	buckets_[Buckets::of(us)].fetch_add(1, std::memory_order_relaxed);
+	sum_us_.fetch_add(us, std::memory_order_relaxed);
+}
+
+DurationHistogram::Snapshot DurationHistogram::snapshot() const
+{
+	Snapshot snapshot;
+	for (size_t i = 0; i < BUCKETS; ++i) {
+		snapshot.buckets[i] = buckets_[i].load(std::memory_order_relaxed);
+		snapshot.count += snapshot.buckets[i];
+	}
+	snapshot.sum_us = sum_us_.load(std::memory_order_relaxed);
+	return snapshot;
+}
+
+double DurationHistogram::Snapshot::percentileMs(const double p) const
+{
+	if (count == 0)
+		return 0.0;
+	return static_cast<double>(Buckets::upperEdge(Buckets::percentile(buckets, count, p))) / 1000.0;
+}
+
+double DurationHistogram::Snapshot::meanMs() const
+{
+	return count ? static_cast<double>(sum_us) / static_cast<double>(count) / 1000.0 : 0.0;
+}
+
+void RateCounter::add(const uint64_t now_ns)
+{
+	const uint64_t second = now_ns / 1000000000;
+	const size_t slot = second % counts_.size();
+	if (seconds_[slot].load(std::memory_order_relaxed) != second) {
+		counts_[slot].store(0, std::memory_order_relaxed);
+		seconds_[slot].store(second, std::memory_order_relaxed);
+	}
+	counts_[slot].fetch_add(1, std::memory_order_relaxed);
+}
+
+double RateCounter::perSecond(const uint64_t now_ns) const
+{
+	// The current second is still filling
+	const uint64_t second = now_ns / 1000000000;
+	uint64_t events = 0;
+	for (size_t slot = 0; slot < counts_.size(); ++slot) {
+		const uint64_t at = seconds_[slot].load(std::memory_order_relaxed);
+		if (at < second && at + WINDOW >= second)
+			events += counts_[slot].load(std::memory_order_relaxed);
+	}
+	return static_cast<double>(events) / static_cast<double>(WINDOW);
+}
+
+std::string RpcMetrics::summary(const char *method) const
+{
+	std::string out;
+	appendf(out, "%s: %llu calls (%llu failed), sent %llu (%.1f MB), received %llu (%.1f MB), "
+		"serialise p99 %.3f ms, gaps p99 %.1f ms sent, %.1f ms received",
+		method, static_cast<unsigned long long>(calls.load()),
+		static_cast<unsigned long long>(failed_calls.load()),
+		static_cast<unsigned long long>(messages_sent.load()), static_cast<double>(bytes_sent.load()) / 1e6,
+		static_cast<unsigned long long>(messages_received.load()),
+		static_cast<double>(bytes_received.load()) / 1e6, serialize.snapshot().percentileMs(0.99),
+		send_gap.snapshot().percentileMs(0.99), receive_gap.snapshot().percentileMs(0.99));
+	return out;
+}
+
+std::string SourceMetrics::summary(const Gauges &gauges, const uint64_t now_ns) const
+{
+	std::string out;
+	const auto line = [&out](const char *name, const DurationHistogram &histogram) {
+		const DurationHistogram::Snapshot s = histogram.snapshot();
+		appendf(out, "%s: p50 %.2f ms, p99 %.2f ms, p99.9 %.2f ms\n", name, s.percentileMs(0.5),
+			s.percentileMs(0.99), s.percentileMs(0.999));
+	};
+	line("Audio callback", callback);
+	line("Resampling", resample);
+	line("Stream write", write);
+	line("Stream read", read);
+	line("Result latency", result_latency);
+	line("Send queue wait", queue_wait);
+	if (chunk_to_result.snapshot().count) {
+		line("Chunk to result", chunk_to_result);
+		line("  network", network);
+		line("  inference", inference);
+	}
+	appendf(out, "Chunks sent: %llu (%.1f MB), spooled: %llu, dropped: %llu, write failures: %llu\n",
+		static_cast<unsigned long long>(chunks_sent.load()), static_cast<double>(bytes_sent.load()) / 1e6,
+		static_cast<unsigned long long>(chunks_spooled.load()),
+		static_cast<unsigned long long>(chunks_dropped.load()),
+		static_cast<unsigned long long>(write_failures.load()));
+	appendf(out, "Queued: %llu bytes to fill a chunk, %llu chunks to send, %llu results to show\n",
+		static_cast<unsigned long long>(gauges.send_buffer_bytes),
+		static_cast<unsigned long long>(gauges.audio_queue),
+		static_cast<unsigned long long>(gauges.results_queue));
+	appendf(out, "Results: %llu, %.2f per second over the last minute\n",
+		static_cast<unsigned long long>(results.load()), result_rate.perSecond(now_ns));
+	out += streaming_asr.summary("StreamingASR") + "\n" + ping.summary("Ping");
+	return out;
+}
+
+std::string SourceMetrics::prometheus(const std::string &source, const Gauges &gauges, const uint64_t now_ns) const
+{
+	const std::string labels = "source=\"" + escapeLabel(source) + "\"";
+	std::string out;
+	appendSummary(out, "audio_callback_seconds", "Time in the audio capture callback per block.", labels,
+		      callback.snapshot());
+	appendSummary(out, "resample_seconds", "Time resampling per block.", labels, resample.snapshot());
+	appendSummary(out, "stream_write_seconds", "Time writing one chunk to the gRPC stream.", labels,
+		      write.snapshot());
+	appendSummary(out, "stream_read_seconds", "Time blocked reading one result from the gRPC stream.", labels,
+		      read.snapshot());
+	appendSummary(out, "result_latency_seconds", "Newest chunk queued to the next result arriving.", labels,
+		      result_latency.snapshot());
+	appendSummary(out, "queue_wait_seconds", "Chunk queued until the sender thread writes it.", labels,
+		      queue_wait.snapshot());
+	appendSummary(out, "chunk_to_result_seconds", "Chunk queued until the result that includes it arrives.",
+		      labels, chunk_to_result.snapshot());
+	appendSummary(out, "network_seconds", "Chunk written until its result is read, less the server's time.",
+		      labels, network.snapshot());
+	appendSummary(out, "inference_seconds", "Server time from receiving a chunk to sending its result.", labels,
+		      inference.snapshot());
+	appendCounter(out, "chunks_sent_total", "Audio chunks written to the stream.", labels, chunks_sent.load());
+	appendCounter(out, "sent_bytes_total", "Audio bytes written to the stream.", labels, bytes_sent.load());
+	appendCounter(out, "chunks_spooled_total", "Audio chunks spooled to disk while not streaming.", labels,
+		      chunks_spooled.load());
+	appendCounter(out, "chunks_dropped_total", "Audio chunks neither streamed nor spooled.", labels,
+		      chunks_dropped.load());
+	appendCounter(out, "stream_write_failures_total", "Failed stream writes.", labels, write_failures.load());
+	appendCounter(out, "results_total", "Results received.", labels, results.load());
+	appendGauge(out, "results_per_second", "Results per second over the last minute.", labels,
+		    result_rate.perSecond(now_ns));
+	appendGauge(out, "send_buffer_bytes", "Audio waiting to fill a chunk.", labels,
+		    static_cast<double>(gauges.send_buffer_bytes));
+	appendGauge(out, "audio_queue_chunks", "Chunks waiting for the sender thread.", labels,
+		    static_cast<double>(gauges.audio_queue));
+	appendGauge(out, "results_queue_results", "Results waiting for the next video tick.", labels,
+		    static_cast<double>(gauges.results_queue));
+	appendGauge(out, "connected", "1 while streaming to the server.", labels, gauges.connected ? 1.0 : 0.0);
+
+	const std::initializer_list<RpcSeries> rpcs = {{"StreamingASR", streaming_asr}, {"Ping", ping}};
+	appendRpcCounter(out, "rpc_calls_total", "Calls started.", labels, rpcs, &RpcMetrics::calls);
+	appendRpcCounter(out, "rpc_failed_calls_total", "Calls that ended with a status other than OK.", labels, rpcs,
+			 &RpcMetrics::failed_calls);
+	appendRpcCounter(out, "rpc_sent_messages_total", "Messages sent.", labels, rpcs, &RpcMetrics::messages_sent);
+	appendRpcCounter(out, "rpc_sent_message_bytes_total", "Serialised bytes of the messages sent.", labels, rpcs,
+			 &RpcMetrics::bytes_sent);
+	appendRpcCounter(out, "rpc_received_messages_total", "Messages received.", labels, rpcs,
+			 &RpcMetrics::messages_received);
+	appendRpcCounter(out, "rpc_received_message_bytes_total", "Serialised bytes of the messages received.", labels,
+			 rpcs, &RpcMetrics::bytes_received);
+	appendRpcSummary(out, "rpc_serialize_seconds", "Time serialising one message sent.", labels, rpcs,
+			 &RpcMetrics::serialize);
+	appendRpcSummary(out, "rpc_send_gap_seconds", "Between messages sent on a call.", labels, rpcs,
+			 &RpcMetrics::send_gap);
+	appendRpcSummary(out, "rpc_receive_gap_seconds", "Between messages received on a call.", labels, rpcs,
+			 &RpcMetrics::receive_gap);
+	return out;
+}
+
+MetricsFileWriter::MetricsFileWriter(std::string path, Report report, const uint64_t interval_ms)
+	: path_(std::move(path)), report_(std::move(report)), interval_ms_(interval_ms),
+	  thread_(&MetricsFileWriter::run, this)
+{
+}
+
+MetricsFileWriter::~MetricsFileWriter()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		stopping_ = true;
+	}
+	cv_.notify_all();
+	thread_.join();
+}
+
+void MetricsFileWriter::run()
+{
+	bool failed = false;
+	std::unique_lock<std::mutex> lock(mutex_);
+	for (;;) {
+		const bool stopping = cv_.wait_for(lock, std::chrono::milliseconds(interval_ms_), [this] { return stopping_; });
+		lock.unlock();
+		const bool written = write();
+		// Once per failure streak, not every interval
+		if (!written && !failed)
+			obs_log(LOG_WARNING, "Failed to write metrics file <%s>", path_.c_str());
+		failed = !written;
+		if (stopping)
+			return;
+		lock.lock();
+	}
+}
+
+bool MetricsFileWriter::write()
+{
+	const std::string text = report_();
+	const std::string temporary = path_ + ".tmp";
+	FILE *file = os_fopen(temporary.c_str(), "wb");
+	if (!file)
+		return false;
+	const bool written = fwrite(text.data(), 1, text.size(), file) == text.size();
+	if (fclose(file) != 0 || !written)
+		return false;
+	return os_rename(temporary.c_str(), path_.c_str()) == 0;
+}
@@ -0,0 +1,149 @@
+#ifndef SOURCE_METRICS_H
+#define SOURCE_METRICS_H
+
+#include "log_linear_buckets.h"
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+
+// Durations in a log-linear histogram of atomic counters: recording is a few
+// relaxed increments, safe from any thread, and percentiles are within about
+// 3% (32 buckets per power of two) from 1 µs to 19 hours.
+class DurationHistogram {
+public:
+	static constexpr int SUB_BITS = 5;
+	static constexpr int MAX_EXPONENT = 36; // µs, exclusive: longer durations count in the last bucket
+	using Buckets = LogLinearBuckets<SUB_BITS, MAX_EXPONENT>;
+	static constexpr size_t BUCKETS = Buckets::COUNT;
+
+	struct Snapshot {
+		Buckets::Counts buckets{};
+		uint64_t count = 0;
+		uint64_t sum_us = 0;
+
+		// p in [0, 1]; the upper edge of the bucket holding that rank.
+		[[nodiscard]] double percentileMs(double p) const;
+		[[nodiscard]] double meanMs() const;
+	};
+
+	void record(uint64_t ns);
+	[[nodiscard]] Snapshot snapshot() const;
+
+private:
+	std::array<std::atomic<uint64_t>, BUCKETS> buckets_{};
+	std::atomic<uint64_t> sum_us_{0};
+};
+
+// Events per second over the last WINDOW whole seconds. One thread adds.
+class RateCounter {
+public:
+	void add(uint64_t now_ns);
+	[[nodiscard]] double perSecond(uint64_t now_ns) const;
+
+	static constexpr uint64_t WINDOW = 60;
+
+private:
+	std::array<std::atomic<uint64_t>, WINDOW + 1> counts_{};
+	std::array<std::atomic<uint64_t>, WINDOW + 1> seconds_{};
+};
+
+// One RPC method as the channel's interceptor sees it, over every call: what
+// went over the wire and what serialising cost. The interceptor cannot see how
+// long Write() or Read() block (gRPC only reports sends and reads as they start
+// or finish, not both), so SourceMetrics::write and read time those.
+struct RpcMetrics {
+	std::atomic<uint64_t> calls{0};
+	std::atomic<uint64_t> failed_calls{0}; // ended with a status other than OK
+	std::atomic<uint64_t> messages_sent{0};
+	std::atomic<uint64_t> bytes_sent{0}; // serialised, before compression and framing
+	std::atomic<uint64_t> messages_received{0};
+	std::atomic<uint64_t> bytes_received{0};
+	DurationHistogram serialize;   // message to bytes, per message sent
+	DurationHistogram send_gap;    // between messages sent on a call
+	DurationHistogram receive_gap; // between messages received on a call
+
+	// One line, prefixed with the method name.
+	[[nodiscard]] std::string summary(const char *method) const;
+};
+
+// What one ASR source has done since it was created, written from the audio,
+// sender and receiver threads without locks and read by the properties panel
+// and the stats file.
+struct SourceMetrics {
+	DurationHistogram callback;       // audio_callback, for blocks it processes
+	DurationHistogram resample;       // libsamplerate, per block
+	DurationHistogram write;          // stream Write, per chunk
+	DurationHistogram read;           // stream Read, per result: mostly waiting for the server
+	DurationHistogram result_latency; // newest chunk queued to the next result arriving
+	DurationHistogram queue_wait;     // chunk queued until the sender thread writes it
+
+	// Only from servers that echo AudioChunk.seq in ASRResult.last_seq: the
+	// time from a chunk being queued to the result that includes it, and its
+	// parts after queue_wait
+	DurationHistogram chunk_to_result;
+	DurationHistogram network;   // chunk written to result read, less the server's time
+	DurationHistogram inference; // ASRResult.server_processing_ns, when it fits in the round trip
+
+	std::atomic<uint64_t> chunks_sent{0};
+	std::atomic<uint64_t> bytes_sent{0};
+	std::atomic<uint64_t> chunks_spooled{0}; // not streamed, kept for catch-up
+	std::atomic<uint64_t> chunks_dropped{0}; // neither streamed nor spooled
+	std::atomic<uint64_t> write_failures{0};
+	std::atomic<uint64_t> results{0};
+	RateCounter result_rate;
+	std::atomic<uint64_t> last_chunk_ns{0}; // os_gettime_ns() the newest chunk was queued
+
+	// From the client's interceptor; Ping is TestConnection
+	RpcMetrics streaming_asr;
+	RpcMetrics ping;
+
+	// Read under the locks that guard them when a report is made, or the last
+	// values read while those are held elsewhere.
+	struct Gauges {
+		uint64_t send_buffer_bytes = 0;
+		uint64_t audio_queue = 0;
+		uint64_t results_queue = 0;
+		bool connected = false;
+	};
+
+	// A few lines for the properties panel.
+	[[nodiscard]] std::string summary(const Gauges &gauges, uint64_t now_ns) const;
+	// Prometheus text exposition format, every series labelled source="<source>".
+	[[nodiscard]] std::string prometheus(const std::string &source, const Gauges &gauges, uint64_t now_ns) const;
+};
+
+// Rewrites a file from a report every interval on its own thread, by writing
+// a temporary file and renaming it over the old one, so that a reader such as
+// node_exporter's textfile collector never sees half a file.
+class MetricsFileWriter {
+public:
+	using Report = std::function<std::string()>;
+
+	MetricsFileWriter(std::string path, Report report, uint64_t interval_ms = INTERVAL_MS);
+	MetricsFileWriter(const MetricsFileWriter &) = delete;
+	MetricsFileWriter &operator=(const MetricsFileWriter &) = delete;
+	~MetricsFileWriter(); // writes a last report
+
+	[[nodiscard]] const std::string &path() const { return path_; }
+
+	static constexpr uint64_t INTERVAL_MS = 10000;
+
+private:
+	void run();
+	bool write();
+
+	const std::string path_;
+	const Report report_;
+	const uint64_t interval_ms_;
+	std::mutex mutex_;
+	std::condition_variable cv_;
+	bool stopping_ = false;
+	std::thread thread_;
+};
+
+#endif
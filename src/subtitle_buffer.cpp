@@ -1,58 +1,262 @@
+
 #include "subtitle_buffer.h"
+#include "line_break.h"
+#include "utf8.h"
+#include <algorithm>
 #include <string>
-#include <deque>
-#include <sstream>
+#include <utility>
 #include <vector>
 
+namespace {
+    size_t roundUpPow2(size_t n) {
+        size_t p = 64;
+        while (p < n) p <<= 1;
+        return p;
+    }
+}
+
+template <typename T>
+void SubtitlesBuffer::Ring<T>::push_back(const T& item) {
+    if (count == items.size()) {
+        // Удваиваем кольцо, сохраняя абсолютные индексы
+        std::vector<T> grown(items.size() * 2);
+        for (size_t i = base; i < end(); ++i) {
+            grown[i & (grown.size() - 1)] = (*this)[i];
+        }
+        items.swap(grown);
+    }
+    ++count;
+    back() = item;
+}
+
 SubtitlesBuffer::SubtitlesBuffer(size_t max_lines, size_t max_chars_per_line)
-    : max_lines(max_lines), max_chars_per_line(max_chars_per_line) {}
+    : max_lines(max_lines), max_chars_per_line(max_chars_per_line) {
+    arena.assign(roundUpPow2(HISTORY_BYTES), '\0');
+    tokens.items.resize(256);
+    lines.items.resize(64);
+    rendered.reserve(arena.size() + lines.items.size());
+}
+
+size_t SubtitlesBuffer::tokenSpanWidth(const size_t first, const size_t last) const {
+    return tokens[last].cum_width - tokens[first].cum_width + tokens[first].width;
+}
+
+size_t SubtitlesBuffer::lineBytes(const Line& line) const {
+    const Token& last = tokens[line.end_token - 1];
+    return last.offset + last.length - tokens[line.first_token].offset;
+}
+
+std::string_view SubtitlesBuffer::tokenText(const Token& token, std::string& scratch) const {
+    const size_t mask = arena.size() - 1;
+    const size_t begin = token.offset & mask;
+    if (begin + token.length <= arena.size()) {
+        return {arena.data() + begin, token.length};
+    }
+    // Токен переходит через конец кольца: склеиваем его во временный буфер
+    const size_t first_part = arena.size() - begin;
+    scratch.assign(arena.data() + begin, first_part);
+    scratch.append(arena.data(), token.length - first_part);
+    return scratch;
+}
+
+size_t SubtitlesBuffer::firstVisibleLine() const {
+    return std::max(lines.end() - std::min(lines.count, std::max<size_t>(max_lines, 1)), live_line);
+}
+
+uint64_t SubtitlesBuffer::commitTime(const Line& line) const {
+    return tokens[line.end_token - 1].time_ns;
+}
+
+void SubtitlesBuffer::growArena(const size_t needed) {
+    // Переносим живые байты в новую арену по тем же абсолютным позициям
+    std::vector<char> grown(roundUpPow2(needed));
+    const size_t old_mask = arena.size() - 1;
+    const size_t new_mask = grown.size() - 1;
+    for (size_t pos = arena_head; pos < arena_tail; ++pos) {
+        grown[pos & new_mask] = arena[pos & old_mask];
+    }
+    arena.swap(grown);
+    rendered.reserve(arena.size() + lines.items.size());
+}
+
+void SubtitlesBuffer::appendToArena(const std::string_view text) {
+    const size_t mask = arena.size() - 1;
+    const size_t start = arena_tail & mask;
+    const size_t first_part = std::min(text.size(), arena.size() - start);
+    std::copy_n(text.data(), first_part, arena.data() + start);
+    std::copy_n(text.data() + first_part, text.size() - first_part, arena.data());
+    arena_tail += text.size();
+}
+
+void SubtitlesBuffer::evictOldestLine() {
+    const Line oldest = lines[lines.base];
+    const Token& last = tokens[oldest.end_token - 1];
+    arena_head = last.offset + last.length;
+    tokens.count -= oldest.end_token - tokens.base;
+    tokens.base = oldest.end_token;
+    lines.pop_front();
+}
+
+void SubtitlesBuffer::appendToken(const std::string_view text, const bool space) {
+    // Освобождаем место за счёт истории, которая уже не видна на экране
+    while (arena_tail - arena_head + text.size() > arena.size()) {
+        if (lines.count > std::max<size_t>(max_lines, 1)) {
+            evictOldestLine();
+        } else {
+            growArena(arena_tail - arena_head + text.size());
+        }
+    }
+
+    appendToArena(text);
+    const bool hard_break = pending_hard_break;
+    pending_hard_break = false;
+    // Ширина считается один раз, при поступлении токена
+    const size_t width = measure ? measure(text) : utf8::length(text);
+    const size_t cum_width = (tokens.count ? tokens.back().cum_width : 0) + width;
+    tokens.push_back(Token{arena_tail - text.size(), text.size(), width, cum_width, space, hard_break, arrival_ns});
+    if (expiry_ns != 0) next_expiry_ns = std::min(next_expiry_ns, arrival_ns + expiry_ns);
+    placeToken(tokens.end() - 1);
+}
 
-void SubtitlesBuffer::addWord(const std::string& word) {
-    // Проверяем, можем ли мы добавить слово в текущую строку
-    if (!lines.empty() && lines.back().size() + word.size() + 1 <= max_chars_per_line) {
-        // Если слово помещается в последнюю строку, добавляем его туда
-        lines.back() += word;
+bool SubtitlesBuffer::fitsOnLastLine(const size_t token) const {
+    if (lines.count == 0 || tokens[token].hard_break) return false;
+    // Пробелы в конце строки не видны, поэтому их ширина не ограничена
+    return tokens[token].space ||
+           tokenSpanWidth(lines.back().first_token, token) <= max_chars_per_line * unit_width;
+}
+
+void SubtitlesBuffer::placeToken(const size_t token) {
+    // Проверяем, можем ли мы добавить токен в текущую строку
+    if (fitsOnLastLine(token)) {
+        lines.back().end_token = token + 1;
+        rendered.pop_back();
     } else {
-        // Если слово не влезает в последнюю строку, создаем новую строку
-        if (lines.size() == max_lines) {
-            // Удаляем самую старую строку, если буфер переполнен
-            lines.pop_front();
+        // Если токен не влезает в последнюю строку, создаем новую строку,
+        // а самая старая видимая строка уходит с экрана в историю
+        if (lines.end() - firstVisibleLine() >= std::max<size_t>(max_lines, 1)) {
+            rendered.erase(0, lineBytes(lines[firstVisibleLine()]) + 1);
         }
-        lines.push_back(word);
+        lines.push_back(Line{token, token + 1});
     }
+    appendLineText(Line{token, token + 1});
+    rendered.push_back('\n');
 }
 
-std::string SubtitlesBuffer::getBufferContent() const {
-    std::string content;
-    for (const auto& line : lines) {
-        content += line + "\n";
+void SubtitlesBuffer::addWord(const std::string_view word, const uint64_t now_ns) {
+    arrival_ns = now_ns;
+    // Разбиваем текст на сегменты по правилам UAX #14: между сегментами можно
+    // переносить строку, хвостовые пробелы становятся отдельным токеном.
+    // Граница между результатами сервера тоже считается местом переноса.
+    line_break::Segmenter segmenter(word);
+    line_break::Segment segment;
+    while (segmenter.next(segment)) {
+        if (!segment.text.empty()) appendToken(segment.text, false);
+        if (!segment.trailing.empty()) appendToken(segment.trailing, true);
+        // Сами символы перевода строки не хранятся: вместо них следующий токен начинает строку
+        if (segment.mandatory) pending_hard_break = true;
     }
-    return content;
 }
 
-void SubtitlesBuffer::changeSize(const size_t new_max_lines, const size_t new_max_chars_per_line) {
+void SubtitlesBuffer::appendLineText(const Line& line) {
+    const size_t mask = arena.size() - 1;
+    const size_t begin = tokens[line.first_token].offset;
+    const size_t end = begin + lineBytes(line);
+    const size_t first_part = std::min(end - begin, arena.size() - (begin & mask));
+    rendered.append(arena.data() + (begin & mask), first_part);
+    rendered.append(arena.data(), end - begin - first_part);
+}
 
-    std::vector<std::string> tokens;
-    for (const auto& line : lines) {
-        size_t i = 0;
-        while (i < line.size()) {
-            if (std::isspace(line[i])) {
-                size_t start = i;
-                while (i < line.size() && std::isspace(line[i])) ++i;
-                tokens.push_back(line.substr(start, i - start)); // пробелы
-            } else {
-                size_t start = i;
-                while (i < line.size() && !std::isspace(line[i])) ++i;
-                tokens.push_back(line.substr(start, i - start)); // слово
-            }
+void SubtitlesBuffer::render() {
+    // Раскладка могла поменяться: ближайший срок пересчитается на следующем тике
+    next_expiry_ns = 0;
+    rendered.clear();
+    for (size_t line = firstVisibleLine(); line < lines.end(); ++line) {
+        appendLineText(lines[line]);
+        rendered.push_back('\n');
+    }
+}
+
+void SubtitlesBuffer::reflow() {
+    // Один проход по метаданным токенов: история всегда начинается с начала строки
+    lines.clear(0);
+    live_line = 0;
+    for (size_t token = tokens.base; token < tokens.end(); ++token) {
+        if (fitsOnLastLine(token)) {
+            lines.back().end_token = token + 1;
+        } else {
+            lines.push_back(Line{token, token + 1});
         }
+        // Токен после истёкших строк всегда начинает строку (hard_break)
+        if (token == live_token) live_line = lines.end() - 1;
+    }
+    if (live_token >= tokens.end()) live_line = lines.end();
+    render();
+}
+
+void SubtitlesBuffer::setWidthFunction(WidthFunction new_measure, const size_t new_unit_width) {
+    measure = std::move(new_measure);
+    unit_width = measure ? std::max<size_t>(new_unit_width, 1) : 1;
+
+    std::string scratch;
+    size_t cum_width = 0;
+    for (size_t token = tokens.base; token < tokens.end(); ++token) {
+        Token& t = tokens[token];
+        const std::string_view text = tokenText(t, scratch);
+        t.width = measure ? measure(text) : utf8::length(text);
+        cum_width += t.width;
+        t.cum_width = cum_width;
     }
+    reflow();
+}
 
-    max_lines = new_max_lines;
-    max_chars_per_line = new_max_chars_per_line;
+void SubtitlesBuffer::setExpiry(const uint64_t new_expiry_ns) {
+    expiry_ns = new_expiry_ns;
+    next_expiry_ns = 0;
+}
 
-    lines.clear();
-    for (const auto& word : tokens) {
-        addWord(word);
+bool SubtitlesBuffer::expireLines(const uint64_t now_ns) {
+    // Обычный тик: одно сравнение с ближайшим сроком
+    if (expiry_ns == 0 || now_ns < next_expiry_ns) return false;
+
+    const size_t first = firstVisibleLine();
+    size_t line = first;
+    while (line < lines.end() && commitTime(lines[line]) + expiry_ns <= now_ns) {
+        rendered.erase(0, lineBytes(lines[line]) + 1);
+        ++line;
     }
-}
\ No newline at end of file
+    next_expiry_ns = line < lines.end() ? commitTime(lines[line]) + expiry_ns : UINT64_MAX;
+    if (line == first) return false;
+
+    // Истёкшие строки скрываются навсегда, новый текст начинается с новой строки
+    live_line = line;
+    if (line < lines.end()) {
+        live_token = lines[line].first_token;
+        tokens[live_token].hard_break = true;
+    } else {
+        live_token = tokens.end();
+        pending_hard_break = true;
+    }
+    return true;
+}
+
+size_t SubtitlesBuffer::visibleLineCount() const {
+    return lines.end() - firstVisibleLine();
+}
+
+uint64_t SubtitlesBuffer::lineAge(const size_t index, const uint64_t now_ns) const {
+    return now_ns - tokens[lines[firstVisibleLine() + index].first_token].time_ns;
+}
+
+const std::string& SubtitlesBuffer::getBufferContent() const {
+    return rendered;
+}
+
+void SubtitlesBuffer::changeSize(const size_t new_max_lines, const size_t new_max_chars_per_line) {
+    max_lines = new_max_lines;
+    if (max_chars_per_line != new_max_chars_per_line) {
+        max_chars_per_line = new_max_chars_per_line;
+        reflow();
+    } else {
+        render();
+    }
+}
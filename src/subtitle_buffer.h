@@ -1,23 +1,120 @@
 #ifndef SUBTITLES_BUFFER_H
 #define SUBTITLES_BUFFER_H
 
+#include <cstdint>
+#include <functional>
 #include <string>
-#include <deque>
-#include <iostream>
+#include <string_view>
+#include <vector>
 
+// Caption text lives in one circular character arena as a sequence of tokens
+// (UAX #14 segments and their trailing spaces) with cumulative widths. Lines are token ranges
+// laid out over that sequence, so changeSize() only re-runs the layout over
+// token metadata. The arena keeps more history than fits on screen, which
+// lets a larger max_lines show earlier text again. The rendered caption
+// string is kept up to date incrementally, so getBufferContent() never builds
+// anything.
+//
+// Widths come from a width function: UTF-8 code points by default, or glyph
+// advances in pixels once a font is selected. Each token is measured once,
+// when it arrives; the line limit is max_chars_per_line * unit_width.
+//
+// Every token carries the time it arrived. A line is committed at the time of
+// its newest token and is hidden once it is older than the expiry. Lines
+// commit in order, so the oldest visible line holds the next deadline and
+// expireLines() is a single comparison until that deadline passes.
 class SubtitlesBuffer {
 public:
+    using WidthFunction = std::function<size_t(std::string_view)>;
+
     SubtitlesBuffer(size_t max_lines, size_t max_chars_per_line);
 
-    void addWord(const std::string& word);
+    void addWord(std::string_view word, uint64_t now_ns = 0);
 
-    [[nodiscard]] std::string getBufferContent() const;
+    [[nodiscard]] const std::string& getBufferContent() const;
     void changeSize(size_t new_max_lines, size_t new_max_chars_per_line);
+    // Remeasures the retained tokens and reflows. An empty function restores
+    // code point counting with unit_width 1.
+    void setWidthFunction(WidthFunction new_measure, size_t new_unit_width);
+
+    // 0 disables expiry.
+    void setExpiry(uint64_t new_expiry_ns);
+    // Hides every visible line committed at least expiry ago; true if any was.
+    bool expireLines(uint64_t now_ns);
+    [[nodiscard]] size_t visibleLineCount() const;
+    // Time since the first word of the visible line `index` (0 = top) appeared.
+    [[nodiscard]] uint64_t lineAge(size_t index, uint64_t now_ns) const;
+
+    static constexpr size_t HISTORY_BYTES = 16 * 1024;
 private:
+    struct Token {
+        size_t offset;    // absolute arena position of the first byte
+        size_t length;
+        size_t width;
+        size_t cum_width; // total width of all tokens up to and including this one
+        bool space;       // whitespace run: may hang past the line limit
+        bool hard_break;  // a line terminator or an expiry preceded this token
+        uint64_t time_ns; // arrival time
+    };
+
+    struct Line {
+        size_t first_token; // absolute token index
+        size_t end_token;   // one past the last token
+    };
+
+    // Fixed-capacity ring addressed by absolute, ever-increasing indices.
+    template <typename T>
+    struct Ring {
+        std::vector<T> items;
+        size_t base = 0;  // absolute index of the oldest item
+        size_t count = 0;
+
+        [[nodiscard]] size_t end() const { return base + count; }
+        T& operator[](size_t abs) { return items[abs & (items.size() - 1)]; }
+        const T& operator[](size_t abs) const { return items[abs & (items.size() - 1)]; }
+        T& back() { return (*this)[end() - 1]; }
+        const T& back() const { return (*this)[end() - 1]; }
+        void push_back(const T& item);
+        void pop_front() { ++base; --count; }
+        void clear(size_t new_base) { base = new_base; count = 0; }
+    };
+
+    void appendToken(std::string_view text, bool space);
+    [[nodiscard]] bool fitsOnLastLine(size_t token) const;
+    void placeToken(size_t token);
+    void evictOldestLine();
+    void appendToArena(std::string_view text);
+    void growArena(size_t needed);
+    [[nodiscard]] size_t tokenSpanWidth(size_t first, size_t last) const;
+    [[nodiscard]] size_t lineBytes(const Line& line) const;
+    [[nodiscard]] std::string_view tokenText(const Token& token, std::string& scratch) const;
+    [[nodiscard]] size_t firstVisibleLine() const;
+    [[nodiscard]] uint64_t commitTime(const Line& line) const;
+    void appendLineText(const Line& line);
+    void reflow();
+    void render();
+
     size_t max_lines;
     size_t max_chars_per_line;
-    std::deque<std::string> lines;
+    size_t unit_width = 1;
+    WidthFunction measure;
+
+    std::vector<char> arena;      // power-of-two capacity, indexed by position & mask
+    size_t arena_head = 0;        // absolute position of the oldest live byte
+    size_t arena_tail = 0;        // absolute position past the newest live byte
+
+    Ring<Token> tokens;
+    Ring<Line> lines;             // layout of every retained token, oldest first
+
+    uint64_t expiry_ns = 0;
+    uint64_t next_expiry_ns = UINT64_MAX; // lower bound of the oldest visible line's deadline
+    uint64_t arrival_ns = 0;              // arrival time of the word being added
+    size_t live_token = 0;                // tokens before it have expired
+    size_t live_line = 0;                 // first line starting at or after live_token
+
+    bool pending_hard_break = false; // a line terminator was seen, the next token starts a line
+
+    std::string rendered;         // the last max_lines lines, each followed by '\n'
 };
 
 #endif
-
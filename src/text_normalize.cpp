@@ -0,0 +1,68 @@
+#include "text_normalize.h"
+#include "utf8.h"
+
+namespace text_normalize {
+
+bool isIdeographic(const char32_t cp)
+{
+	return (cp >= 0x3040 && cp <= 0x30FF) || (cp >= 0x3400 && cp <= 0x4DBF) || (cp >= 0x4E00 && cp <= 0x9FFF) ||
+	       (cp >= 0xF900 && cp <= 0xFAFF) || (cp >= 0x20000 && cp <= 0x3FFFF);
+}
+
+bool isWordChar(const char32_t cp)
+{
+	if (cp < 0x80)
+		return (cp >= '0' && cp <= '9') || (cp >= 'a' && cp <= 'z') || (cp >= 'A' && cp <= 'Z');
+	// Latin-1 punctuation, general and CJK punctuation, fullwidth ASCII punctuation
+	return !(cp < 0xC0 || cp == 0xD7 || cp == 0xF7 || (cp >= 0x2000 && cp <= 0x2BFF) ||
+		 (cp >= 0x3000 && cp <= 0x303F) || (cp >= 0xFF00 && cp <= 0xFF0F) || cp == utf8::REPLACEMENT);
+}
+
+char32_t fold(char32_t cp)
+{
+	cp = utf8::fold(cp);
+	return cp == 0x451 ? 0x435 : cp; // ё is written as е as often as not
+}
+
+void append(std::string_view text, std::string &out, std::vector<uint32_t> *offsets)
+{
+	bool in_word = false;
+	size_t i = 0;
+	while (i < text.size()) {
+		const size_t start = i;
+		const char32_t cp = utf8::decode(text, i);
+		if (cp >= 0x300 && cp <= 0x36F) {
+			// Combining marks go, except the breve that turns и into й
+			if (cp == 0x306 && in_word && out.size() >= 2 && out.compare(out.size() - 2, 2, "\xD0\xB8") == 0)
+				out.back() = '\xB9';
+			continue;
+		}
+		const bool word = isWordChar(cp);
+		if (in_word && (!word || isIdeographic(cp))) {
+			out += ' ';
+			if (offsets)
+				offsets->push_back(static_cast<uint32_t>(start));
+		}
+		in_word = word;
+		if (!word)
+			continue;
+
+		const size_t before = out.size();
+		utf8::append(out, fold(cp));
+		if (offsets)
+			offsets->insert(offsets->end(), out.size() - before, static_cast<uint32_t>(start));
+		if (isIdeographic(cp)) {
+			out += ' ';
+			if (offsets)
+				offsets->push_back(static_cast<uint32_t>(i));
+			in_word = false;
+		}
+	}
+	if (in_word) {
+		out += ' ';
+		if (offsets)
+			offsets->push_back(static_cast<uint32_t>(text.size()));
+	}
+}
+
+} // namespace text_normalize
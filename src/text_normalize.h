@@ -0,0 +1,32 @@
+#ifndef TEXT_NORMALIZE_H
+#define TEXT_NORMALIZE_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Word rules shared by the transcript index and the phrase matchers. Words are
+// runs of letters and digits, case-folded, with ё written as е; every
+// ideograph and kana is a word of its own, since CJK text has no spaces.
+// Combining diacritics are dropped, so a decomposed letter matches its base.
+namespace text_normalize {
+
+bool isIdeographic(char32_t cp);
+bool isWordChar(char32_t cp);
+// The form a word character is indexed and matched in.
+char32_t fold(char32_t cp);
+
+// Appends each word of text to out followed by one space and drops
+// everything else: "Hello, World!" becomes "hello world ". Matching
+// " <phrase> " against a stream that starts with a space therefore only
+// finds whole words, across any number of appends.
+//
+// When offsets is given it gets one entry per byte appended: the offset in
+// text of the character the byte came from, or for a word's trailing space
+// the offset just past the word.
+void append(std::string_view text, std::string &out, std::vector<uint32_t> *offsets = nullptr);
+
+} // namespace text_normalize
+
+#endif
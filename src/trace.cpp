@@ -0,0 +1,199 @@
+#include "trace.h"
+#include <util/platform.h>
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace trace {
+
+std::atomic<bool> recording{false};
+
+namespace {
+
+struct Event {
+	const char *name;
+	uint64_t start_ns;
+	uint64_t end_ns;
+};
+
+// One writer. sequence is twice the events written, plus one while an event
+// is being stored; save() copies the ring and then drops the events that
+// sequence shows were overwritten during the copy.
+struct Ring {
+	std::array<Event, RING_EVENTS> events;
+	std::atomic<uint64_t> sequence{0};
+	std::atomic<const char *> thread_name{nullptr};
+	bool named = false;       // by nameThread
+	uint64_t name_start = 0; // of the span the thread is named after
+	uint32_t tid = 0;
+};
+
+std::mutex rings_mutex;
+std::vector<std::unique_ptr<Ring>> rings; // never shrinks, so a ring outlives its thread
+std::vector<Ring *> free_rings;           // of exited threads, reused by new ones
+uint32_t next_tid = 1;
+int holders = 0;
+
+// Hands the ring back when its thread exits
+struct ThreadRing {
+	Ring *ring = nullptr;
+	const char *name = nullptr; // from nameThread, for a ring not made yet
+	~ThreadRing()
+	{
+		if (!ring)
+			return;
+		std::lock_guard<std::mutex> lock(rings_mutex);
+		free_rings.push_back(ring);
+	}
+};
+
+thread_local ThreadRing thread_ring;
+
+Ring *threadRing()
+{
+	if (thread_ring.ring)
+		return thread_ring.ring;
+	std::lock_guard<std::mutex> lock(rings_mutex);
+	if (!free_rings.empty()) {
+		thread_ring.ring = free_rings.back();
+		free_rings.pop_back();
+		thread_ring.ring->sequence = 0;
+	} else {
+		rings.push_back(std::make_unique<Ring>());
+		thread_ring.ring = rings.back().get();
+	}
+	thread_ring.ring->thread_name = thread_ring.name;
+	thread_ring.ring->named = thread_ring.name != nullptr;
+	thread_ring.ring->tid = next_tid++;
+	return thread_ring.ring;
+}
+
+// What save() writes of one ring
+struct Snapshot {
+	uint32_t tid;
+	const char *thread_name;
+	std::vector<Event> events;
+};
+
+// With rings_mutex held, so the ring is not handed to another thread meanwhile
+bool takeSnapshot(const Ring &ring, Snapshot &snapshot)
+{
+	const uint64_t before = ring.sequence.load(std::memory_order_acquire) / 2;
+	if (before == 0)
+		return false;
+	snapshot.tid = ring.tid;
+	snapshot.thread_name = ring.thread_name.load();
+	const uint64_t first = before - std::min<uint64_t>(before, RING_EVENTS);
+	snapshot.events.reserve(before - first);
+	for (uint64_t i = first; i < before; ++i)
+		snapshot.events.push_back(ring.events[i % RING_EVENTS]);
+	std::atomic_thread_fence(std::memory_order_acquire);
+	// Events stored since, and the one being stored, took the slots of the oldest
+	const uint64_t after = (ring.sequence.load(std::memory_order_relaxed) + 1) / 2;
+	if (after > first + RING_EVENTS) {
+		const uint64_t overwritten = std::min<uint64_t>(after - first - RING_EVENTS, snapshot.events.size());
+		snapshot.events.erase(snapshot.events.begin(), snapshot.events.begin() + overwritten);
+	}
+	return true;
+}
+
+void writeEscaped(FILE *file, const char *text)
+{
+	for (const char *c = text; *c; ++c) {
+		if (*c == '"' || *c == '\\')
+			fputc('\\', file);
+		fputc(*c, file);
+	}
+}
+
+} // namespace
+
+uint64_t Span::now()
+{
+	return os_gettime_ns();
+}
+
+void acquire()
+{
+	std::lock_guard<std::mutex> lock(rings_mutex);
+	if (holders++ == 0)
+		recording = true;
+}
+
+void release()
+{
+	std::lock_guard<std::mutex> lock(rings_mutex);
+	if (holders > 0 && --holders == 0)
+		recording = false;
+}
+
+void nameThread(const char *name)
+{
+	// The ring is made by the first span recorded, if tracing is ever on
+	thread_ring.name = name;
+	if (!thread_ring.ring)
+		return;
+	thread_ring.ring->thread_name = name;
+	thread_ring.ring->named = true;
+}
+
+void record(const char *name, const uint64_t start_ns, const uint64_t end_ns)
+{
+	Ring *ring = threadRing();
+	const uint64_t sequence = ring->sequence.load(std::memory_order_relaxed);
+	const uint64_t n = sequence / 2;
+	// Nested spans end first, so the outermost one so far names the thread
+	if (!ring->named && (n == 0 || start_ns <= ring->name_start)) {
+		ring->thread_name = name;
+		ring->name_start = start_ns;
+	}
+	ring->sequence.store(sequence + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+	ring->events[n % RING_EVENTS] = Event{name, start_ns, end_ns};
+	ring->sequence.store(sequence + 2, std::memory_order_release);
+}
+
+bool save(const std::string &path)
+{
+	std::vector<Snapshot> snapshots;
+	{
+		std::lock_guard<std::mutex> lock(rings_mutex);
+		snapshots.reserve(rings.size());
+		for (const auto &ring : rings) {
+			snapshots.emplace_back();
+			if (!takeSnapshot(*ring, snapshots.back()))
+				snapshots.pop_back();
+		}
+	}
+
+	FILE *file = os_fopen(path.c_str(), "wb");
+	if (!file)
+		return false;
+
+	fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", file);
+	bool first = true;
+	for (const Snapshot &snapshot : snapshots) {
+		fprintf(file, "%s\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"",
+			first ? "" : ",", snapshot.tid);
+		writeEscaped(file, snapshot.thread_name ? snapshot.thread_name : "thread");
+		fputs("\"}}", file);
+		first = false;
+
+		for (const Event &event : snapshot.events) {
+			if (!event.name || event.end_ns < event.start_ns)
+				continue;
+			fputs(",\n{\"name\":\"", file);
+			writeEscaped(file, event.name);
+			fprintf(file, "\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}", snapshot.tid,
+				static_cast<double>(event.start_ns) / 1000.0,
+				static_cast<double>(event.end_ns - event.start_ns) / 1000.0);
+		}
+	}
+	fputs("\n]}\n", file);
+	return fclose(file) == 0;
+}
+
+} // namespace trace
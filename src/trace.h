@@ -0,0 +1,62 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+// Scoped spans of the capture-to-caption pipeline, saved as Chrome
+// trace-event JSON for chrome://tracing or ui.perfetto.dev. Each thread
+// records into its own ring of the last RING_EVENTS spans, so recording
+// takes no lock; while tracing is off a span costs one relaxed load and
+// a branch.
+namespace trace {
+
+extern std::atomic<bool> recording;
+
+// Tracing stays on while any holder wants it; rings fill from then on.
+void acquire();
+void release();
+
+// Names the calling thread in saved traces; otherwise it is named after its
+// outermost span. A thread gets its ring with its first span, so naming one
+// costs nothing while tracing is off.
+void nameThread(const char *name);
+void record(const char *name, uint64_t start_ns, uint64_t end_ns);
+
+// Writes the spans still in every ring; threads may keep recording meanwhile,
+// and the file is written after the rings are copied.
+bool save(const std::string &path);
+
+constexpr size_t RING_EVENTS = 16384;
+
+// name must outlive the trace: a string literal.
+class Span {
+public:
+	explicit Span(const char *name) : name_(recording.load(std::memory_order_relaxed) ? name : nullptr)
+	{
+		if (name_)
+			start_ns_ = now();
+	}
+	~Span()
+	{
+		if (name_)
+			record(name_, start_ns_, now());
+	}
+	Span(const Span &) = delete;
+	Span &operator=(const Span &) = delete;
+
+private:
+	static uint64_t now();
+
+	const char *name_;
+	uint64_t start_ns_ = 0;
+};
+
+} // namespace trace
+
+#define TRACE_CONCAT_(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_(a, b)
+#define TRACE_SPAN(name) trace::Span TRACE_CONCAT(trace_span_, __LINE__)(name)
+
+#endif
@@ -0,0 +1,17 @@
+#include "transcript_history.h"
+#include <algorithm>
+
+void TranscriptHistory::push(TranscriptEntryPtr entry)
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	entries_.push_back(std::move(entry));
+	if (entries_.size() > CAPACITY)
+		entries_.pop_front();
+}
+
+std::vector<TranscriptEntryPtr> TranscriptHistory::recent(const size_t count) const
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	const size_t n = std::min(count, entries_.size());
+	return {entries_.end() - static_cast<std::ptrdiff_t>(n), entries_.end()};
+}
@@ -0,0 +1,38 @@
+#ifndef TRANSCRIPT_HISTORY_H
+#define TRANSCRIPT_HISTORY_H
+
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// One result as handed to other plugins. Entries are immutable and shared:
+// the signal, the history and every subscriber that keeps one hold the same
+// object.
+struct TranscriptEntry {
+	uint64_t seq;     // result number, as in search_transcript hits
+	uint64_t time_ns; // os_gettime_ns() when the result arrived
+	int64_t unix_ms;  // the same moment in wall-clock time
+	bool final;
+	std::string text;
+};
+
+using TranscriptEntryPtr = std::shared_ptr<const TranscriptEntry>;
+
+// The most recent CAPACITY entries.
+class TranscriptHistory {
+public:
+	void push(TranscriptEntryPtr entry);
+	// Up to count newest entries, oldest first.
+	[[nodiscard]] std::vector<TranscriptEntryPtr> recent(size_t count) const;
+
+	static constexpr size_t CAPACITY = 256;
+
+private:
+	std::deque<TranscriptEntryPtr> entries_;
+	mutable std::mutex mutex_;
+};
+
+#endif
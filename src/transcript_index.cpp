@@ -0,0 +1,128 @@
+#include "transcript_index.h"
+#include "text_normalize.h"
+#include "varint.h"
+#include <algorithm>
+
+void TranscriptIndex::terms(std::string_view text, const std::function<void(std::string_view)> &fn)
+{
+	std::string normalized;
+	text_normalize::append(text, normalized);
+	size_t start = 0;
+	for (size_t space = normalized.find(' '); space != std::string::npos; space = normalized.find(' ', start)) {
+		fn(std::string_view(normalized).substr(start, space - start));
+		start = space + 1;
+	}
+}
+
+uint32_t TranscriptIndex::add(const uint64_t time_ns, std::string_view text)
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	const auto seq = static_cast<uint32_t>(results_.size());
+	results_.push_back(Result{time_ns, static_cast<uint32_t>(text_.size()), static_cast<uint32_t>(text.size())});
+	text_.append(text);
+
+	terms(text, [&](std::string_view term) {
+		Postings &postings = terms_[std::string(term)];
+		if (postings.count > 0 && postings.last_seq == seq)
+			return;
+		uint8_t buffer[varint::MAX_BYTES];
+		uint8_t *end = varint::encode(seq - (postings.count > 0 ? postings.last_seq : 0), buffer);
+		postings.bytes.insert(postings.bytes.end(), buffer, end);
+		postings.last_seq = seq;
+		++postings.count;
+	});
+	return seq;
+}
+
+std::vector<uint32_t> TranscriptIndex::decode(const Postings &postings)
+{
+	std::vector<uint32_t> seqs;
+	seqs.reserve(postings.count);
+	const uint8_t *in = postings.bytes.data();
+	const uint8_t *end = in + postings.bytes.size();
+	uint64_t seq = 0;
+	while (in && in < end) {
+		uint64_t delta;
+		in = varint::decode(in, end, delta);
+		if (!in)
+			break;
+		seq += delta;
+		seqs.push_back(static_cast<uint32_t>(seq));
+	}
+	return seqs;
+}
+
+std::vector<TranscriptHit> TranscriptIndex::search(std::string_view query, const size_t limit) const
+{
+	std::vector<std::string> words;
+	terms(query, [&](std::string_view term) { words.emplace_back(term); });
+	std::sort(words.begin(), words.end());
+	words.erase(std::unique(words.begin(), words.end()), words.end());
+
+	std::lock_guard<std::mutex> lock(mutex_);
+	std::vector<const Postings *> lists;
+	for (const std::string &word : words) {
+		const auto it = terms_.find(word);
+		if (it == terms_.end())
+			return {};
+		lists.push_back(&it->second);
+	}
+	if (lists.empty() || limit == 0)
+		return {};
+
+	// Walk the rarest term and probe the others around each of its results
+	std::sort(lists.begin(), lists.end(), [](const Postings *a, const Postings *b) { return a->count < b->count; });
+	std::vector<std::vector<uint32_t>> seqs;
+	seqs.reserve(lists.size());
+	for (const Postings *postings : lists)
+		seqs.push_back(decode(*postings));
+
+	std::vector<TranscriptHit> hits;
+	for (auto anchor = seqs[0].rbegin(); anchor != seqs[0].rend() && hits.size() < limit; ++anchor) {
+		const uint32_t low = *anchor > WINDOW ? *anchor - WINDOW : 0;
+		const bool all = std::all_of(seqs.begin() + 1, seqs.end(), [&](const std::vector<uint32_t> &other) {
+			const auto it = std::lower_bound(other.begin(), other.end(), low);
+			return it != other.end() && *it <= *anchor + WINDOW;
+		});
+		if (!all)
+			continue;
+		const Result &result = results_[*anchor];
+		hits.push_back(TranscriptHit{*anchor, result.time_ns, text_.substr(result.offset, result.length)});
+	}
+	return hits;
+}
+
+void TranscriptIndex::clear()
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	terms_.clear();
+	results_.clear();
+	text_.clear();
+}
+
+size_t TranscriptIndex::resultCount() const
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	return results_.size();
+}
+
+size_t TranscriptIndex::termCount() const
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	return terms_.size();
+}
+
+size_t TranscriptIndex::memoryUsage() const
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	// Hash node: key, value, next pointer and cached hash
+	constexpr size_t NODE = sizeof(std::pair<const std::string, Postings>) + 2 * sizeof(void *);
+	static const size_t inline_capacity = std::string().capacity();
+	size_t bytes = terms_.bucket_count() * sizeof(void *) + terms_.size() * NODE;
+	for (const auto &[term, postings] : terms_) {
+		if (term.capacity() > inline_capacity)
+			bytes += term.capacity() + 1;
+		bytes += postings.bytes.capacity();
+	}
+	return bytes + results_.capacity() * sizeof(Result) + text_.capacity();
+}
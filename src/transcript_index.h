@@ -0,0 +1,63 @@
+#ifndef TRANSCRIPT_INDEX_H
+#define TRANSCRIPT_INDEX_H
+
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+struct TranscriptHit {
+	uint32_t seq;     // result number within the session
+	uint64_t time_ns; // os_gettime_ns() when the result arrived
+	std::string text;
+};
+
+// Incremental inverted index over the results of one session. Each result
+// gets a sequence number and keeps its arrival time and text; each
+// normalised term maps to the results containing it as a posting list of
+// varint sequence deltas, so a term costs one or two bytes per mention on
+// top of its hash-table node. With a large vocabulary the nodes dominate:
+// BM_TranscriptIndexHour reports the bytes an hour of results takes.
+class TranscriptIndex {
+public:
+	// Returns the result's sequence number.
+	uint32_t add(uint64_t time_ns, std::string_view text);
+	// Results where every query term occurs within WINDOW results of the
+	// rarest one, newest first.
+	[[nodiscard]] std::vector<TranscriptHit> search(std::string_view query, size_t limit) const;
+	void clear();
+
+	[[nodiscard]] size_t resultCount() const;
+	[[nodiscard]] size_t termCount() const;
+	// Approximate heap footprint in bytes.
+	[[nodiscard]] size_t memoryUsage() const;
+
+	// Splits text into lower-cased words; ideographs and kana are one term each.
+	static void terms(std::string_view text, const std::function<void(std::string_view)> &fn);
+
+	static constexpr uint32_t WINDOW = 8;
+
+private:
+	struct Postings {
+		std::vector<uint8_t> bytes;
+		uint32_t last_seq = 0;
+		uint32_t count = 0;
+	};
+	struct Result {
+		uint64_t time_ns;
+		uint32_t offset; // into text_
+		uint32_t length;
+	};
+
+	static std::vector<uint32_t> decode(const Postings &postings);
+
+	std::unordered_map<std::string, Postings> terms_;
+	std::vector<Result> results_;
+	std::string text_;
+	mutable std::mutex mutex_;
+};
+
+#endif
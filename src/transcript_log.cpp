@@ -0,0 +1,258 @@
+#include "transcript_log.h"
+#include "varint.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+
+namespace {
+
+constexpr char MAGIC[8] = {'S', 'A', 'Y', 'O', 'T', 'L', 'O', 'G'};
+constexpr uint32_t VERSION = 1;
+constexpr uint32_t EXTENT_MAGIC = 0x54584553; // "SEXT"
+constexpr size_t MAX_RECORD_BYTES = 3 * varint::MAX_BYTES + 1;
+
+// Both headers live in shared mappings; atomics there are lock-free and
+// address-free, so another process can read them.
+struct LogHeader {
+	char magic[8];
+	uint32_t version;
+	uint32_t extent_size;
+	uint64_t start_unix_ns;
+	std::atomic<uint32_t> extent_count; // extents fully initialised
+};
+
+struct ExtentHeader {
+	uint32_t magic;
+	std::atomic<uint32_t> record_end;   // published records end here
+	std::atomic<uint32_t> string_start; // lowest text byte in use
+	std::atomic<uint32_t> sealed;       // the writer moved to the next extent
+	uint64_t base_time_us;              // time the first delta is relative to
+};
+
+constexpr uint32_t RECORDS_BEGIN = 64;
+static_assert(sizeof(LogHeader) <= MappedFile::PAGE);
+static_assert(sizeof(ExtentHeader) <= RECORDS_BEGIN);
+static_assert(std::atomic<uint32_t>::is_always_lock_free);
+
+LogHeader *logHeader(const MappedRegion &region)
+{
+	return reinterpret_cast<LogHeader *>(region.data());
+}
+
+ExtentHeader *extentHeader(const MappedRegion &region)
+{
+	return reinterpret_cast<ExtentHeader *>(region.data());
+}
+
+uint64_t extentOffset(const uint32_t index)
+{
+	return MappedFile::PAGE + static_cast<uint64_t>(index) * TranscriptLog::EXTENT_SIZE;
+}
+
+} // namespace
+
+TranscriptLog::~TranscriptLog()
+{
+	close();
+}
+
+bool TranscriptLog::open(const std::string &path, const uint64_t start_ns)
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	if (!file_.open(path, true) || file_.size() != 0 || !file_.resize(MappedFile::PAGE)) {
+		file_.close();
+		return false;
+	}
+	header_ = file_.map(0, MappedFile::PAGE);
+	if (!header_) {
+		file_.close();
+		return false;
+	}
+
+	LogHeader *header = logHeader(header_);
+	std::memcpy(header->magic, MAGIC, sizeof(MAGIC));
+	header->version = VERSION;
+	header->extent_size = EXTENT_SIZE;
+	header->start_unix_ns = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::system_clock::now().time_since_epoch()).count());
+	header->extent_count.store(0, std::memory_order_release);
+
+	start_ns_ = start_ns;
+	last_time_us_ = 0;
+	extent_count_ = 0;
+	grower_ = std::make_unique<BackgroundWorker>();
+	if (!addExtent()) {
+		grower_.reset();
+		next_extent_ = MappedRegion();
+		header_ = MappedRegion();
+		file_.close();
+		return false;
+	}
+	return true;
+}
+
+void TranscriptLog::close()
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	// Finishes a preparation in flight before the file goes
+	grower_.reset();
+	next_extent_ = MappedRegion();
+	if (extent_)
+		MappedFile::flushAsync(extent_);
+	if (header_)
+		MappedFile::flushAsync(header_);
+	extent_ = MappedRegion();
+	header_ = MappedRegion();
+	file_.close();
+}
+
+void TranscriptLog::prepareExtent(const uint32_t index)
+{
+	grower_->post([this, index] {
+		MappedRegion region;
+		if (file_.resize(extentOffset(index + 1)))
+			region = file_.map(extentOffset(index), EXTENT_SIZE);
+		std::lock_guard<std::mutex> lock(next_mutex_);
+		next_extent_ = std::move(region);
+		next_index_ = index;
+	});
+}
+
+bool TranscriptLog::addExtent()
+{
+	// The file grows one whole extent at a time; the next append is a memcpy
+	if (extent_) {
+		extentHeader(extent_)->sealed.store(1, std::memory_order_release);
+		MappedFile::flushAsync(extent_);
+	}
+	MappedRegion next;
+	{
+		std::lock_guard<std::mutex> lock(next_mutex_);
+		if (next_extent_ && next_index_ == extent_count_)
+			next = std::move(next_extent_);
+	}
+	if (!next) {
+		// The first extent, or the background preparation failed or is late
+		if (!file_.resize(extentOffset(extent_count_ + 1)))
+			return false;
+		next = file_.map(extentOffset(extent_count_), EXTENT_SIZE);
+		if (!next)
+			return false;
+	}
+	extent_ = std::move(next);
+
+	ExtentHeader *extent = extentHeader(extent_);
+	extent->magic = EXTENT_MAGIC;
+	extent->base_time_us = last_time_us_;
+	extent->sealed.store(0, std::memory_order_relaxed);
+	extent->string_start.store(EXTENT_SIZE, std::memory_order_relaxed);
+	extent->record_end.store(RECORDS_BEGIN, std::memory_order_relaxed);
+	record_end_ = RECORDS_BEGIN;
+	string_start_ = EXTENT_SIZE;
+
+	logHeader(header_)->extent_count.store(++extent_count_, std::memory_order_release);
+	prepareExtent(extent_count_);
+	return true;
+}
+
+void TranscriptLog::append(const uint64_t time_ns, std::string_view text, const uint8_t flags)
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	if (!extent_)
+		return;
+
+	// Captions are short; anything longer than half an extent is cut
+	text = text.substr(0, EXTENT_SIZE / 2);
+	if (record_end_ + MAX_RECORD_BYTES + text.size() > string_start_ && !addExtent())
+		return;
+
+	const uint64_t time_us = std::max(time_ns > start_ns_ ? (time_ns - start_ns_) / 1000 : 0, last_time_us_);
+
+	uint8_t *base = extent_.data();
+	string_start_ -= static_cast<uint32_t>(text.size());
+	std::memcpy(base + string_start_, text.data(), text.size());
+
+	uint8_t *out = base + record_end_;
+	out = varint::encode(time_us - last_time_us_, out);
+	out = varint::encode(EXTENT_SIZE - string_start_, out);
+	out = varint::encode(text.size(), out);
+	*out++ = flags;
+	record_end_ = static_cast<uint32_t>(out - base);
+	last_time_us_ = time_us;
+
+	ExtentHeader *extent = extentHeader(extent_);
+	extent->string_start.store(string_start_, std::memory_order_relaxed);
+	extent->record_end.store(record_end_, std::memory_order_release);
+}
+
+bool TranscriptLogReader::open(const std::string &path)
+{
+	if (!file_.open(path, false) || file_.size() < MappedFile::PAGE)
+		return false;
+	header_ = file_.map(0, MappedFile::PAGE);
+	if (!header_ || std::memcmp(logHeader(header_)->magic, MAGIC, sizeof(MAGIC)) != 0 ||
+	    logHeader(header_)->version != VERSION || logHeader(header_)->extent_size != TranscriptLog::EXTENT_SIZE) {
+		header_ = MappedRegion();
+		file_.close();
+		return false;
+	}
+	extent_index_ = 0;
+	record_pos_ = RECORDS_BEGIN;
+	last_time_us_ = 0;
+	return true;
+}
+
+uint64_t TranscriptLogReader::startUnixNs() const
+{
+	return header_ ? logHeader(header_)->start_unix_ns : 0;
+}
+
+size_t TranscriptLogReader::poll(const std::function<void(const TranscriptRecord &)> &fn)
+{
+	if (!header_)
+		return 0;
+
+	size_t count = 0;
+	while (true) {
+		const uint32_t extents = logHeader(header_)->extent_count.load(std::memory_order_acquire);
+		if (!extent_) {
+			if (extent_index_ >= extents)
+				return count;
+			extent_ = file_.map(extentOffset(extent_index_), TranscriptLog::EXTENT_SIZE);
+			if (!extent_ || extentHeader(extent_)->magic != EXTENT_MAGIC)
+				return count;
+			record_pos_ = RECORDS_BEGIN;
+			last_time_us_ = extentHeader(extent_)->base_time_us;
+		}
+
+		const ExtentHeader *extent = extentHeader(extent_);
+		// Read sealed before record_end: once sealed, record_end is final
+		const bool sealed = extent->sealed.load(std::memory_order_acquire) != 0;
+		const uint32_t record_end = extent->record_end.load(std::memory_order_acquire);
+
+		const uint8_t *base = extent_.data();
+		const uint8_t *in = base + record_pos_;
+		const uint8_t *end = base + record_end;
+		while (in < end) {
+			uint64_t delta, offset, length;
+			in = varint::decode(in, end, delta);
+			in = in ? varint::decode(in, end, offset) : nullptr;
+			in = in ? varint::decode(in, end, length) : nullptr;
+			if (!in || in >= end || offset > TranscriptLog::EXTENT_SIZE || length > offset)
+				return count; // corrupt; stop rather than read past the extent
+			const uint8_t flags = *in++;
+
+			last_time_us_ += delta;
+			const auto *text = reinterpret_cast<const char *>(base + TranscriptLog::EXTENT_SIZE - offset);
+			fn(TranscriptRecord{last_time_us_, std::string_view(text, length), flags});
+			++count;
+		}
+		record_pos_ = record_end;
+
+		if (!sealed)
+			return count;
+		extent_ = MappedRegion();
+		++extent_index_;
+	}
+}
@@ -0,0 +1,89 @@
+#ifndef TRANSCRIPT_LOG_H
+#define TRANSCRIPT_LOG_H
+
+#include "background_worker.h"
+#include "mapped_file.h"
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Append-only binary transcript of one ASR session.
+//
+// The file is a header page followed by fixed-size extents. Each extent holds
+// varint records growing up from its header and their UTF-8 text growing down
+// from its end; a record stores the time delta to the previous record, the
+// offset of its text from the extent end, the text length and flags. The
+// writer fills a mapped extent with plain stores and publishes each record
+// with a release store of the extent's record end, so a reader can follow the
+// file while it is being written. The next extent is allocated and mapped on
+// a background thread while the current one fills, so append() only stores.
+struct TranscriptRecord {
+	uint64_t time_us; // since the session start
+	std::string_view text;
+	uint8_t flags;
+};
+
+namespace transcript_flags {
+constexpr uint8_t FINAL = 1 << 0;
+constexpr uint8_t BACKLOG = 1 << 1; // transcribed late from spooled audio
+}
+
+class TranscriptLog {
+public:
+	TranscriptLog() = default;
+	TranscriptLog(const TranscriptLog &) = delete;
+	TranscriptLog &operator=(const TranscriptLog &) = delete;
+	~TranscriptLog();
+
+	// start_ns is the monotonic session start the record times are relative to.
+	bool open(const std::string &path, uint64_t start_ns);
+	void close();
+	[[nodiscard]] bool isOpen() const { return file_.isOpen(); }
+
+	// Drops the record when the file cannot grow, the disk being full; the
+	// next append tries again.
+	void append(uint64_t time_ns, std::string_view text, uint8_t flags = transcript_flags::FINAL);
+
+	static constexpr uint32_t EXTENT_SIZE = 4u << 20;
+
+private:
+	bool addExtent();
+	void prepareExtent(uint32_t index);
+
+	MappedFile file_;
+	MappedRegion header_;
+	MappedRegion extent_;
+	std::unique_ptr<BackgroundWorker> grower_;
+	std::mutex next_mutex_;
+	MappedRegion next_extent_; // extent next_index_, allocated and mapped on grower_
+	uint32_t next_index_ = 0;
+	uint32_t extent_count_ = 0;
+	uint32_t record_end_ = 0;
+	uint32_t string_start_ = 0;
+	uint64_t last_time_us_ = 0;
+	uint64_t start_ns_ = 0;
+	std::mutex mutex_;
+};
+
+class TranscriptLogReader {
+public:
+	bool open(const std::string &path);
+	// Reports every record published since the previous call, in order.
+	size_t poll(const std::function<void(const TranscriptRecord &)> &fn);
+	// Wall-clock time of the session start, nanoseconds since the Unix epoch.
+	[[nodiscard]] uint64_t startUnixNs() const;
+
+private:
+	MappedFile file_;
+	MappedRegion header_;
+	MappedRegion extent_;
+	uint32_t extent_index_ = 0;
+	uint32_t record_pos_ = 0;
+	uint64_t last_time_us_ = 0;
+};
+
+#endif
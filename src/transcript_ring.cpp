@@ -0,0 +1,145 @@
+#include "transcript_ring.h"
+#include <chrono>
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <csignal>
+
+TranscriptRingWriter::~TranscriptRingWriter()
+{
+	close();
+}
+
+#ifndef _WIN32
+
+namespace {
+
+// Names tried after the plain one: "-2" up to "-16"
+constexpr int MAX_SUFFIX = 16;
+
+// True when the object is a ring whose writer process is gone
+bool abandoned(const std::string &shm_name)
+{
+	using namespace transcript_ring;
+	const int fd = shm_open(shm_name.c_str(), O_RDONLY, 0);
+	if (fd < 0)
+		return false;
+	struct stat st {};
+	void *data = MAP_FAILED;
+	if (fstat(fd, &st) == 0 && static_cast<size_t>(st.st_size) >= sizeof(Header))
+		data = mmap(nullptr, sizeof(Header), PROT_READ, MAP_SHARED, fd, 0);
+	::close(fd);
+	if (data == MAP_FAILED)
+		return false;
+	const auto *header = static_cast<const Header *>(data);
+	const bool ours = std::memcmp(header->magic, MAGIC, sizeof(MAGIC)) == 0 && header->version == VERSION;
+	const auto pid = static_cast<pid_t>(header->writer_pid);
+	munmap(data, sizeof(Header));
+	return ours && pid > 0 && kill(pid, 0) != 0 && errno == ESRCH;
+}
+
+// Creates the object exclusively; a crashed writer's ring is replaced
+int createExclusive(const std::string &shm_name)
+{
+	const int fd = shm_open(shm_name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+	if (fd >= 0 || errno != EEXIST)
+		return fd;
+	if (!abandoned(shm_name)) {
+		errno = EEXIST;
+		return -1;
+	}
+	shm_unlink(shm_name.c_str());
+	return shm_open(shm_name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+}
+
+} // namespace
+
+bool TranscriptRingWriter::open(const std::string &shm_name)
+{
+	using namespace transcript_ring;
+	close();
+	// Another live ring under this name: a different source whose name
+	// sanitises the same way ("Mic 1" and "Mic_1")
+	std::string name = shm_name;
+	int fd = createExclusive(name);
+	for (int suffix = 2; fd < 0 && errno == EEXIST && suffix <= MAX_SUFFIX; ++suffix) {
+		name = shm_name + "-" + std::to_string(suffix);
+		fd = createExclusive(name);
+	}
+	if (fd < 0)
+		return false;
+	void *data = MAP_FAILED;
+	if (ftruncate(fd, SIZE) == 0)
+		data = mmap(nullptr, SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	::close(fd);
+	if (data == MAP_FAILED) {
+		shm_unlink(name.c_str());
+		return false;
+	}
+
+	// A new object is zero-filled; readers of a replaced one keep the old
+	// mapping and see no more results
+	header_ = static_cast<Header *>(data);
+	header_->version = VERSION;
+	header_->slot_count = SLOT_COUNT;
+	header_->slot_size = SLOT_SIZE;
+	header_->writer_pid = static_cast<uint32_t>(getpid());
+	header_->start_unix_ns = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::system_clock::now().time_since_epoch()).count());
+	std::memcpy(header_->magic, MAGIC, sizeof(MAGIC));
+	std::atomic_thread_fence(std::memory_order_release);
+
+	name_ = name;
+	next_ = 0;
+	return true;
+}
+
+void TranscriptRingWriter::close()
+{
+	if (!header_)
+		return;
+	munmap(header_, transcript_ring::SIZE);
+	shm_unlink(name_.c_str());
+	header_ = nullptr;
+}
+
+void TranscriptRingWriter::publish(const uint64_t time_ns, std::string_view text, const uint8_t flags)
+{
+	using namespace transcript_ring;
+	if (!header_)
+		return;
+
+	size_t length = std::min(text.size(), MAX_TEXT);
+	while (length < text.size() && length > 0 && (static_cast<unsigned char>(text[length]) & 0xC0) == 0x80)
+		--length;
+
+	Slot &slot = slots(header_)[next_ % SLOT_COUNT];
+	slot.seq.store(2 * next_ + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+	slot.time_ns = time_ns;
+	slot.flags = flags;
+	slot.length = static_cast<uint32_t>(length);
+	std::memcpy(slot.text, text.data(), length);
+	slot.seq.store(2 * next_ + 2, std::memory_order_release);
+
+	header_->head.store(++next_, std::memory_order_release);
+	// Pairs with the waiter count in Reader::wait(); no sleepers, no syscall
+	header_->futex.fetch_add(1, std::memory_order_seq_cst);
+#ifdef __linux__
+	if (header_->waiters.load(std::memory_order_seq_cst) != 0)
+		syscall(SYS_futex, &header_->futex, FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+#endif
+}
+
+#else
+
+bool TranscriptRingWriter::open(const std::string &)
+{
+	return false;
+}
+
+void TranscriptRingWriter::close() {}
+
+void TranscriptRingWriter::publish(uint64_t, std::string_view, uint8_t) {}
+
+#endif
@@ -0,0 +1,37 @@
+#ifndef TRANSCRIPT_RING_H
+#define TRANSCRIPT_RING_H
+
+#include "transcript_log.h"
+#include "transcript_ring_reader.h"
+#include <string>
+#include <string_view>
+
+// Writer side of the shared-memory ring described in transcript_ring_reader.h.
+// publish() is called from one thread only and never blocks: it fills a slot,
+// bumps the head and wakes futex waiters, if there are any.
+class TranscriptRingWriter {
+public:
+	TranscriptRingWriter() = default;
+	TranscriptRingWriter(const TranscriptRingWriter &) = delete;
+	TranscriptRingWriter &operator=(const TranscriptRingWriter &) = delete;
+	~TranscriptRingWriter();
+
+	// Creates the shared-memory object, readable by this user only, and
+	// starts at result 0. A name held by another live ring gets a "-2",
+	// "-3", ... suffix; name() is the one actually created.
+	bool open(const std::string &shm_name);
+	// Unmaps and unlinks the object; mapped readers keep their view.
+	void close();
+	[[nodiscard]] bool isOpen() const { return header_ != nullptr; }
+	[[nodiscard]] const std::string &name() const { return name_; }
+
+	// Text longer than a slot is cut at a character boundary.
+	void publish(uint64_t time_ns, std::string_view text, uint8_t flags = transcript_flags::FINAL);
+
+private:
+	transcript_ring::Header *header_ = nullptr;
+	std::string name_;
+	uint64_t next_ = 0;
+};
+
+#endif
@@ -0,0 +1,199 @@
+#ifndef TRANSCRIPT_RING_READER_H
+#define TRANSCRIPT_RING_READER_H
+
+// Shared-memory transcript ring: layout and a header-only reader.
+//
+// The plugin publishes every result into a POSIX shared-memory object named
+// "/sayo-<source name>" (non-alphanumerics replaced by '_'), readable by its
+// own user only. When two sources map to the same name, the later one gets
+// "-2", "-3", ... appended; the plugin logs the name it used. The object is a
+// header followed by SLOT_COUNT fixed-size slots; result n goes to slot
+// n % SLOT_COUNT. Each slot is a seqlock: its sequence word is 2n+1 while
+// result n is being written and 2n+2 once it is complete. The writer never
+// waits for readers, so a reader that falls more than SLOT_COUNT results
+// behind loses the overwritten ones and is told so.
+//
+// Readers either poll head() or block in wait(), which sleeps on the header's
+// futex word on Linux. A reader writes nothing but the header's waiter count,
+// which spares the writer the wake-up syscall while nobody sleeps. Include
+// this file alone; it needs nothing from OBS or the plugin.
+
+#include <atomic>
+#include <cctype>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <ctime>
+#else
+#include <chrono>
+#include <thread>
+#endif
+#endif
+
+namespace transcript_ring {
+
+constexpr char MAGIC[8] = {'S', 'A', 'Y', 'O', 'R', 'I', 'N', 'G'};
+constexpr uint32_t VERSION = 2;
+constexpr uint32_t SLOT_COUNT = 1024;
+constexpr uint32_t SLOT_SIZE = 256;
+
+struct Header {
+	char magic[8];
+	uint32_t version;
+	uint32_t slot_count;
+	uint32_t slot_size;
+	std::atomic<uint32_t> futex;   // bumped after every publish
+	uint64_t start_unix_ns;        // changes when the writer re-creates the ring
+	std::atomic<uint64_t> head;    // results published so far
+	std::atomic<uint32_t> waiters; // readers sleeping in wait()
+	uint32_t writer_pid;           // lets a new writer replace a crashed one's ring
+	char reserved[16];
+};
+
+struct Slot {
+	std::atomic<uint64_t> seq;
+	uint64_t time_ns; // CLOCK_MONOTONIC
+	uint32_t length;
+	uint8_t flags; // bit 0: final result
+	char text[SLOT_SIZE - 21];
+};
+
+static_assert(sizeof(Header) == 64);
+static_assert(sizeof(Slot) == SLOT_SIZE);
+static_assert(std::atomic<uint64_t>::is_always_lock_free);
+static_assert(std::atomic<uint32_t>::is_always_lock_free);
+
+constexpr size_t SIZE = sizeof(Header) + static_cast<size_t>(SLOT_COUNT) * SLOT_SIZE;
+constexpr size_t MAX_TEXT = sizeof(Slot::text);
+
+inline Slot *slots(Header *header)
+{
+	return reinterpret_cast<Slot *>(header + 1);
+}
+
+inline const Slot *slots(const Header *header)
+{
+	return reinterpret_cast<const Slot *>(header + 1);
+}
+
+inline std::string name(const std::string &source_name)
+{
+	std::string result = "/sayo-";
+	for (const char c : source_name)
+		result += (isalnum(static_cast<unsigned char>(c)) || c == '-' || c == '_') ? c : '_';
+	return result;
+}
+
+struct Entry {
+	uint64_t seq;
+	uint64_t time_ns;
+	uint8_t flags;
+	std::string text;
+};
+
+class Reader {
+public:
+	enum class Status { Ok, Pending, Lost };
+
+	Reader() = default;
+	Reader(const Reader &) = delete;
+	Reader &operator=(const Reader &) = delete;
+	~Reader() { close(); }
+
+#ifndef _WIN32
+	bool open(const std::string &shm_name)
+	{
+		close();
+		// Read-write only for the waiter count in the header
+		const int fd = shm_open(shm_name.c_str(), O_RDWR, 0);
+		if (fd < 0)
+			return false;
+		struct stat st {};
+		void *data = MAP_FAILED;
+		if (fstat(fd, &st) == 0 && static_cast<size_t>(st.st_size) >= SIZE)
+			data = mmap(nullptr, SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+		::close(fd);
+		if (data == MAP_FAILED)
+			return false;
+		header_ = static_cast<Header *>(data);
+		if (std::memcmp(header_->magic, MAGIC, sizeof(MAGIC)) != 0 || header_->version != VERSION ||
+		    header_->slot_count != SLOT_COUNT || header_->slot_size != SLOT_SIZE) {
+			close();
+			return false;
+		}
+		return true;
+	}
+
+	void close()
+	{
+		if (header_)
+			munmap(header_, SIZE);
+		header_ = nullptr;
+	}
+#else
+	bool open(const std::string &) { return false; }
+	void close() {}
+#endif
+
+	[[nodiscard]] bool isOpen() const { return header_ != nullptr; }
+	// Sequence number the next result will get.
+	[[nodiscard]] uint64_t head() const { return header_->head.load(std::memory_order_acquire); }
+	[[nodiscard]] uint64_t startUnixNs() const { return header_->start_unix_ns; }
+
+	// Copies result seq. Pending: not written yet; Lost: already overwritten.
+	Status read(const uint64_t seq, Entry &out) const
+	{
+		const Slot &slot = slots(header_)[seq % SLOT_COUNT];
+		const uint64_t published = 2 * seq + 2;
+		const uint64_t before = slot.seq.load(std::memory_order_acquire);
+		if (before < published)
+			return Status::Pending;
+		if (before != published)
+			return Status::Lost;
+
+		out.seq = seq;
+		out.time_ns = slot.time_ns;
+		out.flags = slot.flags;
+		const uint32_t length = slot.length < MAX_TEXT ? slot.length : static_cast<uint32_t>(MAX_TEXT);
+		out.text.assign(slot.text, length);
+
+		std::atomic_thread_fence(std::memory_order_acquire);
+		return slot.seq.load(std::memory_order_relaxed) == published ? Status::Ok : Status::Lost;
+	}
+
+	// Blocks until result seq is published or timeout_ms passes.
+	bool wait(const uint64_t seq, const int timeout_ms) const
+	{
+#ifdef __linux__
+		// Counted before the word is read: a writer that sees no waiters
+		// has already bumped the word, and FUTEX_WAIT then returns at once
+		header_->waiters.fetch_add(1, std::memory_order_seq_cst);
+		const uint32_t word = header_->futex.load(std::memory_order_seq_cst);
+		if (head() <= seq) {
+			timespec timeout{timeout_ms / 1000, (timeout_ms % 1000) * 1000000L};
+			syscall(SYS_futex, &header_->futex, FUTEX_WAIT, word, &timeout, nullptr, 0);
+		}
+		header_->waiters.fetch_sub(1, std::memory_order_relaxed);
+#elif !defined(_WIN32)
+		if (head() <= seq)
+			std::this_thread::sleep_for(std::chrono::milliseconds(timeout_ms < 10 ? timeout_ms : 10));
+#endif
+		return head() > seq;
+	}
+
+private:
+	Header *header_ = nullptr;
+};
+
+} // namespace transcript_ring
+
+#endif
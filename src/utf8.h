@@ -0,0 +1,109 @@
+#ifndef UTF8_H
+#define UTF8_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace utf8 {
+
+constexpr char32_t REPLACEMENT = 0xFFFD;
+
+// Decodes the code point starting at text[i] and advances i past it.
+// Malformed or truncated sequences yield U+FFFD and consume one byte, so a
+// multibyte character is never split.
+inline char32_t decode(std::string_view text, size_t& i)
+{
+	const auto lead = static_cast<unsigned char>(text[i]);
+	if (lead < 0x80) {
+		++i;
+		return lead;
+	}
+
+	size_t length;
+	char32_t cp;
+	if ((lead & 0xE0) == 0xC0) {
+		length = 2;
+		cp = lead & 0x1F;
+	} else if ((lead & 0xF0) == 0xE0) {
+		length = 3;
+		cp = lead & 0x0F;
+	} else if ((lead & 0xF8) == 0xF0) {
+		length = 4;
+		cp = lead & 0x07;
+	} else {
+		++i;
+		return REPLACEMENT;
+	}
+
+	if (i + length > text.size()) {
+		++i;
+		return REPLACEMENT;
+	}
+	for (size_t k = 1; k < length; ++k) {
+		const auto cont = static_cast<unsigned char>(text[i + k]);
+		if ((cont & 0xC0) != 0x80) {
+			++i;
+			return REPLACEMENT;
+		}
+		cp = (cp << 6) | (cont & 0x3F);
+	}
+	i += length;
+	return cp;
+}
+
+// Number of code points in text; continuation bytes are not counted.
+inline size_t length(std::string_view text)
+{
+	size_t count = 0;
+	for (const char c : text) {
+		if ((static_cast<unsigned char>(c) & 0xC0) != 0x80)
+			++count;
+	}
+	return count;
+}
+
+// Appends the UTF-8 encoding of cp to out.
+inline void append(std::string& out, const char32_t cp)
+{
+	if (cp < 0x80) {
+		out += static_cast<char>(cp);
+	} else if (cp < 0x800) {
+		out += static_cast<char>(0xC0 | (cp >> 6));
+		out += static_cast<char>(0x80 | (cp & 0x3F));
+	} else if (cp < 0x10000) {
+		out += static_cast<char>(0xE0 | (cp >> 12));
+		out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+		out += static_cast<char>(0x80 | (cp & 0x3F));
+	} else {
+		out += static_cast<char>(0xF0 | (cp >> 18));
+		out += static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+		out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+		out += static_cast<char>(0x80 | (cp & 0x3F));
+	}
+}
+
+// Simple one-to-one lower-casing for Latin, Greek and Cyrillic; other code
+// points are returned unchanged.
+inline char32_t fold(const char32_t cp)
+{
+	if (cp < 0x80)
+		return cp >= 'A' && cp <= 'Z' ? cp + 0x20 : cp;
+	if (cp >= 0xC0 && cp <= 0xDE && cp != 0xD7)
+		return cp + 0x20;
+	if ((cp >= 0x100 && cp <= 0x137 && cp != 0x130) || (cp >= 0x14A && cp <= 0x177))
+		return cp | 1;
+	if ((cp >= 0x139 && cp <= 0x148) || (cp >= 0x179 && cp <= 0x17E))
+		return cp & 1 ? cp + 1 : cp;
+	if (cp >= 0x391 && cp <= 0x3AB && cp != 0x3A2)
+		return cp + 0x20;
+	if (cp >= 0x410 && cp <= 0x42F)
+		return cp + 0x20;
+	if (cp >= 0x400 && cp <= 0x40F)
+		return cp + 0x50;
+	return cp;
+}
+
+} // namespace utf8
+
+#endif
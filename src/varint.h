@@ -0,0 +1,48 @@
+#ifndef VARINT_H
+#define VARINT_H
+
+#include <cstddef>
+#include <cstdint>
+
+// LEB128 unsigned varints, as used by protobuf: 7 bits per byte, low first.
+namespace varint {
+
+constexpr size_t MAX_BYTES = 10;
+
+inline size_t size(uint64_t value)
+{
+	size_t n = 1;
+	while (value >= 0x80) {
+		value >>= 7;
+		++n;
+	}
+	return n;
+}
+
+// Writes value at out, which must have room for size(value) bytes.
+inline uint8_t *encode(uint64_t value, uint8_t *out)
+{
+	while (value >= 0x80) {
+		*out++ = static_cast<uint8_t>(value) | 0x80;
+		value >>= 7;
+	}
+	*out++ = static_cast<uint8_t>(value);
+	return out;
+}
+
+// Reads one varint from [in, end). Returns nullptr on truncated input.
+inline const uint8_t *decode(const uint8_t *in, const uint8_t *end, uint64_t &value)
+{
+	value = 0;
+	for (unsigned shift = 0; in < end && shift < 64; shift += 7) {
+		const uint8_t byte = *in++;
+		value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+		if (!(byte & 0x80))
+			return in;
+	}
+	return nullptr;
+}
+
+} // namespace varint
+
+#endif
@@ -0,0 +1,131 @@
+// CaptionPacer against a recording sink on a made-up clock: words coalesce
+// into rows of at most ROW_CHARS, a row goes out only once the channel has
+// carried the previous one, a short row is held for more words and then
+// flushed, and a backlog keeps only the newest MAX_ROWS rows.
+//
+//   sayo-caption-pacer-test
+
+#include "caption_pacer.h"
+#include "check.h"
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr uint64_t MS = 1000000;
+
+struct Sent {
+	std::string text;
+	double duration;
+	uint64_t at_ns;
+};
+
+// Sink that remembers what it was given and when
+struct Recorder {
+	std::vector<Sent> sent;
+	uint64_t now_ns = 0;
+
+	CaptionPacer pacer{[this](const std::string &text, const double duration) {
+		sent.push_back({text, duration, now_ns});
+	}};
+
+	void push(const std::string &text) { pacer.push(text, now_ns); }
+	void pumpUntil(const uint64_t end_ns, const uint64_t step_ns = 33 * MS)
+	{
+		for (; now_ns <= end_ns; now_ns += step_ns)
+			pacer.pump(now_ns);
+	}
+};
+
+uint64_t durationNs(const std::string &text)
+{
+	return static_cast<uint64_t>(static_cast<double>(text.size() + CaptionPacer::CONTROL_BYTES) /
+				     CaptionPacer::BYTES_PER_SECOND * 1e9);
+}
+
+void testCoalescing()
+{
+	Recorder r;
+	r.push("the quick brown");
+	r.push("fox jumps over the lazy dog");
+	CHECK(r.pacer.queued() == 2);
+	r.pumpUntil(0);
+	CHECK(r.sent.size() == 1 && r.sent[0].text == "the quick brown fox jumps over");
+	CHECK(r.sent.size() == 1 && r.sent[0].text.size() <= CaptionPacer::ROW_CHARS);
+}
+
+void testPacing()
+{
+	Recorder r;
+	const std::string first = "one two three four five six seve";
+	const std::string second = "eight nine ten eleven twelve thi";
+	CHECK(first.size() == CaptionPacer::ROW_CHARS && second.size() == CaptionPacer::ROW_CHARS);
+	r.push(first + " " + second);
+	r.pumpUntil(0);
+	CHECK(r.sent.size() == 1);
+
+	// Nothing until the channel has carried the first row
+	const uint64_t free_ns = durationNs(first);
+	r.pacer.pump(free_ns - 1);
+	CHECK(r.sent.size() == 1);
+	r.now_ns = free_ns;
+	r.pacer.pump(free_ns);
+	CHECK(r.sent.size() == 2 && r.sent[1].text == second && r.sent[1].at_ns == free_ns);
+	CHECK(r.sent[0].duration == static_cast<double>(first.size() + CaptionPacer::CONTROL_BYTES) /
+					    CaptionPacer::BYTES_PER_SECOND);
+}
+
+void testFlush()
+{
+	Recorder r;
+	r.push("hello");
+	// A short row waits for more words...
+	r.pumpUntil(CaptionPacer::HOLD_NS - MS, MS);
+	CHECK(r.sent.empty());
+	r.push("world");
+	CHECK(r.pacer.queued() == 1);
+	// ...and goes out once it has waited HOLD_NS since its first word
+	r.pumpUntil(CaptionPacer::HOLD_NS, MS);
+	CHECK(r.sent.size() == 1 && r.sent[0].text == "hello world");
+	CHECK(r.pacer.queued() == 0);
+
+	// A row that cannot grow is not held, only paced
+	const uint64_t pushed_ns = r.now_ns;
+	r.push("thirty-two characters exactly!!!");
+	r.pumpUntil(pushed_ns + CaptionPacer::HOLD_NS / 2, MS);
+	CHECK(r.sent.size() == 2 && r.sent.back().text == "thirty-two characters exactly!!!");
+
+	// clear() drops what is queued
+	r.push("never shown");
+	r.pacer.clear();
+	CHECK(r.pacer.queued() == 0);
+	r.pumpUntil(r.now_ns + 10 * CaptionPacer::HOLD_NS);
+	CHECK(r.sent.size() == 2);
+}
+
+void testBacklogKeepsNewest()
+{
+	Recorder r;
+	std::string text;
+	for (size_t row = 0; row < CaptionPacer::MAX_ROWS + 3; ++row)
+		text += "row" + std::to_string(row) + std::string(CaptionPacer::ROW_CHARS - 4, 'x') + " ";
+	r.push(text);
+	CHECK(r.pacer.queued() == CaptionPacer::MAX_ROWS);
+	r.pumpUntil(60 * CaptionPacer::HOLD_NS);
+	CHECK(r.sent.size() == CaptionPacer::MAX_ROWS);
+	CHECK(!r.sent.empty() && r.sent.front().text.rfind("row3", 0) == 0);
+	CHECK(!r.sent.empty() && r.sent.back().text.rfind("row6", 0) == 0);
+}
+
+} // namespace
+
+int main()
+{
+	testCoalescing();
+	testPacing();
+	testFlush();
+	testBacklogKeepsNewest();
+	return check::result();
+}
@@ -0,0 +1,32 @@
+#ifndef TESTS_CHECK_H
+#define TESTS_CHECK_H
+
+// What the unit tests in tests/ share: a CHECK that counts failed conditions
+// and goes on, and the exit code main() returns once they have all run.
+
+#include <cstdio>
+
+namespace check {
+
+inline int failures = 0;
+
+// Exit code of the test: 1 when any CHECK failed
+inline int result()
+{
+	if (failures)
+		fprintf(stderr, "%d checks failed\n", failures);
+	return failures ? 1 : 0;
+}
+
+} // namespace check
+
+#define CHECK(condition)                                                             \
+	do {                                                                         \
+		if (!(condition)) {                                                  \
+			fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, \
+				#condition);                                         \
+			++check::failures;                                           \
+		}                                                                    \
+	} while (0)
+
+#endif
@@ -0,0 +1,95 @@
+// ProfanityFilter and ProfanityMasker on results as the server splits them:
+// a listed phrase split over two or three results is masked, results are
+// joined as they came with no space added, where one result ended still ends
+// a word, a match found before the held words went out stays masked, and
+// flush() or a missing filter lets held words go.
+//
+//   sayo-profanity-filter-test
+
+#include "profanity_filter.h"
+#include "check.h"
+#include <memory>
+#include <string>
+
+namespace {
+
+const std::shared_ptr<const ProfanityFilter> filter = ProfanityFilter::compile("# test list\n"
+									       "what the heck\n"
+									       "bad word\n"
+									       "b c d\n"
+									       "c\n");
+
+void testMask()
+{
+	CHECK(filter->wordCount() == 4);
+	CHECK(filter->mask("What the HECK, bad word!") == "**** *** ****, *** ****!");
+	CHECK(filter->mask("what the hecklers") == "what the hecklers");
+}
+
+void testSplitInTwo()
+{
+	ProfanityMasker masker;
+	CHECK(masker.feed(filter.get(), "so what the") == "so ");
+	CHECK(masker.holding());
+	CHECK(masker.feed(filter.get(), " heck, really") == "**** *** ****, really");
+	CHECK(!masker.holding());
+}
+
+// Results that carry no spaces at their ends: the boundaries between them
+// still end words, and the text is shown as it came
+void testSplitInThree()
+{
+	ProfanityMasker masker;
+	CHECK(masker.feed(filter.get(), "what").empty());
+	CHECK(masker.feed(filter.get(), "the").empty());
+	CHECK(masker.holding());
+	CHECK(masker.feed(filter.get(), "heck") == "***********");
+	CHECK(!masker.holding());
+}
+
+void testBoundariesKept()
+{
+	ProfanityMasker masker;
+	CHECK(masker.feed(filter.get(), "a bad") == "a ");
+	CHECK(masker.feed(filter.get(), "thing") == "badthing");
+	CHECK(masker.feed(filter.get(), " then bad") == " then ");
+	CHECK(masker.feed(filter.get(), " words") == "bad words");
+}
+
+// "c" matched while "b c" was held; it stays masked when "b c d" does not come
+void testCarriedMask()
+{
+	ProfanityMasker masker;
+	CHECK(masker.feed(filter.get(), "x b c") == "x ");
+	CHECK(masker.feed(filter.get(), "e") == "b *e");
+	CHECK(masker.feed(filter.get(), "x b c") == "x ");
+	CHECK(masker.feed(filter.get(), " d y") == "* * * y");
+}
+
+void testFlush()
+{
+	ProfanityMasker masker;
+	CHECK(masker.feed(filter.get(), "and what the") == "and ");
+	CHECK(masker.holding());
+	CHECK(masker.flush() == "what the");
+	CHECK(!masker.holding());
+	CHECK(masker.flush().empty());
+
+	// Turning the filter off lets held words out with the next result
+	CHECK(masker.feed(filter.get(), "bad").empty());
+	CHECK(masker.feed(nullptr, " later") == "bad later");
+	CHECK(!masker.holding());
+}
+
+} // namespace
+
+int main()
+{
+	testMask();
+	testSplitInTwo();
+	testSplitInThree();
+	testBoundariesKept();
+	testCarriedMask();
+	testFlush();
+	return check::result();
+}
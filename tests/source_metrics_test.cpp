@@ -0,0 +1,71 @@
+// DurationHistogram at the edges of its range: zero, the last exact
+// microsecond, the first one past it and the longest duration there is all
+// land in a bucket of the array, and the percentiles stay finite.
+//
+//   sayo-source-metrics-test
+
+#include "source_metrics.h"
+#include "check.h"
+#include <obs-module.h>
+#include <plugin-support.h>
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <limits>
+
+extern "C" {
+const char *PLUGIN_NAME = "sayo-source-metrics-test";
+const char *PLUGIN_VERSION = "";
+
+void obs_log(int log_level, const char *format, ...)
+{
+	if (log_level > LOG_WARNING)
+		return;
+	va_list args;
+	va_start(args, format);
+	vfprintf(stderr, format, args);
+	va_end(args);
+	fputc('\n', stderr);
+}
+}
+
+namespace {
+
+constexpr uint64_t LAST_EXACT_US = (uint64_t{1} << DurationHistogram::MAX_EXPONENT) - 1;
+
+void testEdges()
+{
+	DurationHistogram histogram;
+	histogram.record(0);
+	histogram.record(LAST_EXACT_US * 1000);
+	histogram.record((LAST_EXACT_US + 1) * 1000);
+	histogram.record(std::numeric_limits<uint64_t>::max());
+
+	const DurationHistogram::Snapshot snapshot = histogram.snapshot();
+	CHECK(snapshot.count == 4);
+	CHECK(snapshot.buckets[0] == 1);
+	CHECK(snapshot.buckets[DurationHistogram::BUCKETS - 1] == 3);
+	CHECK(snapshot.percentileMs(0.25) == 0.0);
+	CHECK(snapshot.percentileMs(1.0) == static_cast<double>(LAST_EXACT_US) / 1000.0);
+}
+
+void testSmallValuesAreExact()
+{
+	DurationHistogram histogram;
+	for (uint64_t us = 0; us < (1u << DurationHistogram::SUB_BITS); ++us)
+		histogram.record(us * 1000);
+
+	const DurationHistogram::Snapshot snapshot = histogram.snapshot();
+	for (size_t i = 0; i < (1u << DurationHistogram::SUB_BITS); ++i)
+		CHECK(snapshot.buckets[i] == 1);
+	CHECK(snapshot.percentileMs(1.0) == ((1u << DurationHistogram::SUB_BITS) - 1) / 1000.0);
+}
+
+} // namespace
+
+int main()
+{
+	testEdges();
+	testSmallValuesAreExact();
+	return check::result();
+}
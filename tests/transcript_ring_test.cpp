@@ -0,0 +1,228 @@
+// TranscriptRingWriter and transcript_ring::Reader in two processes, as the
+// plugin and a caption client run them: a forked child writes, the parent
+// reads. The first phase wraps the ring several times before reading, so
+// overwritten results come back Lost and the newest SLOT_COUNT come back
+// whole. The second phase reads the oldest slots while the child overwrites
+// them as fast as it can; every read that is not Lost must be the result it
+// asked for, never a mix of two. The third has the reader asleep in wait()
+// when the next result comes, which must wake it. Last, in one process: a
+// second writer under a taken name gets a suffix, and a ring whose writer
+// died is replaced under its own name.
+//
+//   sayo-transcript-ring-test
+
+#include "transcript_ring.h"
+#include "check.h"
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <chrono>
+#include <cinttypes>
+#include <csignal>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+namespace {
+
+using transcript_ring::Entry;
+using transcript_ring::Reader;
+using transcript_ring::SLOT_COUNT;
+
+constexpr uint64_t WRAPPED = 3 * SLOT_COUNT + 10;
+constexpr uint64_t RACED = 400 * SLOT_COUNT;
+
+// Long enough to span several cache lines of the slot, and different in every one
+std::string textOf(const uint64_t seq)
+{
+	std::string text = "result " + std::to_string(seq) + " ";
+	text.append(transcript_ring::MAX_TEXT - text.size(), static_cast<char>('a' + seq % 26));
+	return text;
+}
+
+uint64_t timeOf(const uint64_t seq)
+{
+	return seq * 7 + 1;
+}
+
+bool matches(const Entry &entry, const uint64_t seq)
+{
+	return entry.seq == seq && entry.time_ns == timeOf(seq) && entry.flags == (seq & 1) &&
+	       entry.text == textOf(seq);
+}
+
+// Blocks until the other process writes a byte; false when it is gone
+bool await(const int fd)
+{
+	char byte;
+	return read(fd, &byte, 1) == 1;
+}
+
+void notify(const int fd)
+{
+	const char byte = 0;
+	if (write(fd, &byte, 1) != 1)
+		_exit(3);
+}
+
+// The child: publishes WRAPPED results, lets the parent look, then RACED more
+[[noreturn]] void runWriter(const std::string &name, const int to_parent, const int from_parent)
+{
+	TranscriptRingWriter writer;
+	if (!writer.open(name))
+		_exit(2);
+	uint64_t seq = 0;
+	for (; seq < WRAPPED; ++seq)
+		writer.publish(timeOf(seq), textOf(seq), static_cast<uint8_t>(seq & 1));
+	notify(to_parent);
+	if (!await(from_parent))
+		_exit(3);
+	for (; seq < WRAPPED + RACED; ++seq)
+		writer.publish(timeOf(seq), textOf(seq), static_cast<uint8_t>(seq & 1));
+	notify(to_parent);
+	// One more once the parent is asleep in wait()
+	if (!await(from_parent))
+		_exit(3);
+	usleep(100000);
+	writer.publish(timeOf(seq), textOf(seq), static_cast<uint8_t>(seq & 1));
+	// Unlinking the object is left to the parent, after it is done reading
+	await(from_parent);
+	writer.close();
+	_exit(0);
+}
+
+void testWrapAround(const Reader &reader)
+{
+	CHECK(reader.head() == WRAPPED);
+	Entry entry;
+	const uint64_t oldest = WRAPPED - SLOT_COUNT;
+	CHECK(reader.read(0, entry) == Reader::Status::Lost);
+	CHECK(reader.read(oldest - 1, entry) == Reader::Status::Lost);
+	CHECK(reader.read(WRAPPED, entry) == Reader::Status::Pending);
+	for (uint64_t seq = oldest; seq < WRAPPED; ++seq) {
+		const bool ok = reader.read(seq, entry) == Reader::Status::Ok;
+		CHECK(ok && matches(entry, seq));
+		if (!ok)
+			break;
+	}
+}
+
+// Reads just behind the writer's lap, where slots change under the reader
+void testRacingReads(const Reader &reader, const int from_child)
+{
+	uint64_t whole = 0;
+	uint64_t lost = 0;
+	uint64_t torn = 0;
+	Entry entry;
+	for (;;) {
+		const uint64_t head = reader.head();
+		const bool done = head == WRAPPED + RACED;
+		const uint64_t seq = head > SLOT_COUNT ? head - SLOT_COUNT : 0;
+		switch (reader.read(seq, entry)) {
+		case Reader::Status::Ok:
+			++whole;
+			if (!matches(entry, seq))
+				++torn;
+			break;
+		case Reader::Status::Lost:
+			++lost;
+			break;
+		case Reader::Status::Pending:
+			break;
+		}
+		if (done)
+			break;
+	}
+	CHECK(torn == 0);
+	CHECK(whole > 0);
+	printf("racing reads: %" PRIu64 " whole, %" PRIu64 " lost, %" PRIu64 " torn\n", whole, lost, torn);
+	CHECK(await(from_child));
+}
+
+void testWakeUp(const Reader &reader)
+{
+	const auto start = std::chrono::steady_clock::now();
+	CHECK(reader.wait(WRAPPED + RACED, 5000));
+	CHECK(std::chrono::steady_clock::now() - start < std::chrono::seconds(2));
+}
+
+mode_t modeOf(const std::string &name)
+{
+	struct stat st {};
+	const int fd = shm_open(name.c_str(), O_RDONLY, 0);
+	if (fd < 0)
+		return 0;
+	fstat(fd, &st);
+	close(fd);
+	return st.st_mode & 0777;
+}
+
+void testNames(const std::string &name)
+{
+	TranscriptRingWriter first;
+	TranscriptRingWriter second;
+	CHECK(first.open(name) && first.name() == name);
+	CHECK(second.open(name) && second.name() == name + "-2");
+	CHECK(modeOf(name) == 0600);
+	second.close();
+	first.close();
+
+	// A writer that exits without closing leaves its object behind
+	const pid_t child = fork();
+	if (child == 0) {
+		TranscriptRingWriter crashed;
+		_exit(crashed.open(name) ? 0 : 2);
+	}
+	int status = 0;
+	waitpid(child, &status, 0);
+	CHECK(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+	TranscriptRingWriter next;
+	CHECK(next.open(name) && next.name() == name);
+}
+
+} // namespace
+
+int main()
+{
+	const std::string name = "/sayo-ring-test-" + std::to_string(getpid());
+	int to_parent[2];
+	int to_child[2];
+	if (pipe(to_parent) != 0 || pipe(to_child) != 0) {
+		perror("pipe");
+		return 1;
+	}
+
+	const pid_t child = fork();
+	if (child < 0) {
+		perror("fork");
+		return 1;
+	}
+	if (child == 0) {
+		close(to_parent[0]);
+		close(to_child[1]);
+		runWriter(name, to_parent[1], to_child[0]);
+	}
+	close(to_parent[1]);
+	close(to_child[0]);
+
+	Reader reader;
+	if (!await(to_parent[0]) || !reader.open(name)) {
+		fprintf(stderr, "the writer did not create %s\n", name.c_str());
+		kill(child, SIGKILL);
+		waitpid(child, nullptr, 0);
+		return 1;
+	}
+	testWrapAround(reader);
+	notify(to_child[1]);
+	testRacingReads(reader, to_parent[0]);
+	notify(to_child[1]);
+	testWakeUp(reader);
+	notify(to_child[1]);
+
+	int status = 0;
+	waitpid(child, &status, 0);
+	CHECK(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+
+	testNames(name + "-names");
+	return check::result();
+}
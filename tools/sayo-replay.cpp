@@ -0,0 +1,334 @@
+// Replays a .sayocap session capture against a Sayo server through the
+// plugin's own ASRGrpcClient, at the captured pace or as fast as possible,
+// and compares when results arrive with when they arrived in the capture.
+// It also prints what the client's interceptor saw of each RPC: messages,
+// bytes and how long serialising, Write() and Read() took.
+//
+// With --offline no server is involved: the captured results go through the
+// plugin's caption path (profanity masking, SubtitlesBuffer and CaptionPacer)
+// on a clock that ticks at --fps from the capture's timestamps, exactly as
+// the plugin's video tick takes them, one result a tick. Every change of the
+// burned-in caption and every native caption row is printed with its time,
+// followed by a digest of the whole timeline, so two runs over one capture
+// print the same thing and a caption regression shows as a different digest.
+//
+//   sayo-replay <file.sayocap> [--server host:port] [--max-speed] [--csv out.csv]
+//   sayo-replay <file.sayocap> --offline [--lines n] [--chars n] [--expiry s] [--fps n]
+//                              [--profanity list.txt] [--csv out.csv]
+
+#include "../src/caption_pacer.h"
+#include "../src/profanity_filter.h"
+#include "../src/server_gRPC/grpc_client.h"
+#include "../src/session_capture.h"
+#include "../src/source_metrics.h"
+#include "../src/subtitle_buffer.h"
+#include <plugin-support.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+extern "C" {
+const char *PLUGIN_NAME = "sayo-replay";
+const char *PLUGIN_VERSION = "";
+
+void obs_log(int, const char *format, ...)
+{
+	va_list args;
+	va_start(args, format);
+	vfprintf(stderr, format, args);
+	va_end(args);
+	fputc('\n', stderr);
+}
+}
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Arrival {
+	double seconds; // since the first chunk
+	std::string text;
+};
+
+int usage()
+{
+	fprintf(stderr, "usage: sayo-replay <file.sayocap> [--server host:port] [--max-speed] [--csv out.csv]\n"
+			"       sayo-replay <file.sayocap> --offline [--lines n] [--chars n] [--expiry s] [--fps n]\n"
+			"                                  [--profanity list.txt] [--csv out.csv]\n");
+	return 2;
+}
+
+// Caption settings of --offline, the plugin's defaults unless given
+struct OfflineOptions {
+	size_t lines = 2;
+	size_t chars = 60;
+	double expiry = 0.0;
+	int fps = 30;
+	std::string profanity;
+};
+
+struct CaptionEvent {
+	uint64_t time_ns; // since the capture started
+	bool native;      // a CEA-608 row rather than the burned-in caption
+	std::string text;
+};
+
+uint64_t fnv1a(uint64_t hash, const std::string &text)
+{
+	for (const char c : text)
+		hash = (hash ^ static_cast<uint8_t>(c)) * 0x100000001b3ull;
+	return hash;
+}
+
+// What asr_tick_callback does with the results, frame by frame on a made-up clock
+int runOffline(SessionCaptureReader &reader, const OfflineOptions &options, const char *csv_path)
+{
+	std::shared_ptr<const ProfanityFilter> filter;
+	if (!options.profanity.empty()) {
+		filter = ProfanityFilter::load(options.profanity);
+		if (!filter) {
+			fprintf(stderr, "cannot read word list %s\n", options.profanity.c_str());
+			return 1;
+		}
+	}
+
+	std::deque<session_capture::Record> results;
+	session_capture::Record record;
+	while (reader.next(record)) {
+		if (record.type == session_capture::RecordType::Result)
+			results.push_back(std::move(record));
+	}
+
+	std::vector<CaptionEvent> events;
+	uint64_t now = 0;
+	SubtitlesBuffer subtitles(options.lines, options.chars);
+	subtitles.setExpiry(static_cast<uint64_t>(options.expiry * 1e9));
+	CaptionPacer pacer([&](const std::string &text, double) { events.push_back({now, true, text}); });
+	ProfanityMasker masker;
+	std::deque<std::string> queue; // as ASRGrpcClient::asr_results_queue
+	uint64_t last_result_ns = 0;
+	std::string shown;
+	const auto show = [&] {
+		if (subtitles.getBufferContent() == shown)
+			return;
+		shown = subtitles.getBufferContent();
+		events.push_back({now, false, shown});
+	};
+
+	const uint64_t frame_ns = 1000000000ull / static_cast<uint64_t>(std::max(options.fps, 1));
+	for (;; now += frame_ns) {
+		// Masked on arrival, as on_asr_result does on the receiver thread
+		while (!results.empty() && results.front().time_us * 1000 <= now) {
+			last_result_ns = results.front().time_us * 1000;
+			std::string masked = masker.feed(filter.get(), results.front().data);
+			if (!masked.empty())
+				queue.push_back(std::move(masked));
+			results.pop_front();
+		}
+		if (results.empty() && queue.empty() && !masker.holding() && pacer.queued() == 0)
+			break;
+
+		pacer.pump(now);
+		if (subtitles.expireLines(now))
+			show();
+		std::string result;
+		if (!queue.empty()) {
+			result = std::move(queue.front());
+			queue.pop_front();
+		} else if (masker.holding() && now >= last_result_ns + ProfanityMasker::HOLD_NS) {
+			result = masker.flush();
+		}
+		if (result.empty())
+			continue;
+		pacer.push(result, now);
+		subtitles.addWord(result, now);
+		show();
+	}
+
+	uint64_t digest = 0xcbf29ce484222325ull;
+	size_t changes = 0;
+	for (const CaptionEvent &event : events) {
+		std::string text = event.text;
+		for (size_t newline = text.find('\n'); newline != std::string::npos; newline = text.find('\n', newline))
+			text.replace(newline, 1, " / ");
+		printf("%10.3f  %s  %s\n", static_cast<double>(event.time_ns) / 1e9, event.native ? "608" : "   ",
+		       text.c_str());
+		digest = fnv1a(fnv1a(digest, std::to_string(event.time_ns) + (event.native ? " 608 " : " ")), event.text);
+		changes += !event.native;
+	}
+	printf("captions   %zu changes, %zu native rows, until %.3f s\n", changes, events.size() - changes,
+	       static_cast<double>(now) / 1e9);
+	printf("digest     %016llx\n", static_cast<unsigned long long>(digest));
+
+	if (csv_path) {
+		FILE *csv = fopen(csv_path, "w");
+		if (!csv) {
+			fprintf(stderr, "cannot write %s\n", csv_path);
+			return 1;
+		}
+		fprintf(csv, "time_s,native,text\n");
+		for (const CaptionEvent &event : events) {
+			std::string text = event.text;
+			for (size_t quote = text.find('"'); quote != std::string::npos; quote = text.find('"', quote + 2))
+				text.insert(quote, 1, '"');
+			fprintf(csv, "%.3f,%d,\"%s\"\n", static_cast<double>(event.time_ns) / 1e9, event.native,
+				text.c_str());
+		}
+		fclose(csv);
+	}
+	return 0;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+	if (argc < 2)
+		return usage();
+	std::string path = argv[1];
+	std::string host = "localhost";
+	int port = 50051;
+	bool max_speed = false;
+	bool offline = false;
+	OfflineOptions offline_options;
+	const char *csv_path = nullptr;
+	for (int i = 2; i < argc; ++i) {
+		if (!strcmp(argv[i], "--server") && i + 1 < argc) {
+			const std::string server = argv[++i];
+			const size_t colon = server.rfind(':');
+			host = server.substr(0, colon);
+			if (colon != std::string::npos)
+				port = std::stoi(server.substr(colon + 1));
+		} else if (!strcmp(argv[i], "--max-speed")) {
+			max_speed = true;
+		} else if (!strcmp(argv[i], "--csv") && i + 1 < argc) {
+			csv_path = argv[++i];
+		} else if (!strcmp(argv[i], "--offline")) {
+			offline = true;
+		} else if (!strcmp(argv[i], "--lines") && i + 1 < argc) {
+			offline_options.lines = std::stoul(argv[++i]);
+		} else if (!strcmp(argv[i], "--chars") && i + 1 < argc) {
+			offline_options.chars = std::stoul(argv[++i]);
+		} else if (!strcmp(argv[i], "--expiry") && i + 1 < argc) {
+			offline_options.expiry = std::stod(argv[++i]);
+		} else if (!strcmp(argv[i], "--fps") && i + 1 < argc) {
+			offline_options.fps = std::stoi(argv[++i]);
+		} else if (!strcmp(argv[i], "--profanity") && i + 1 < argc) {
+			offline_options.profanity = argv[++i];
+		} else {
+			return usage();
+		}
+	}
+
+	SessionCaptureReader reader;
+	if (!reader.open(path)) {
+		fprintf(stderr, "cannot read capture %s\n", path.c_str());
+		return 1;
+	}
+	if (offline)
+		return runOffline(reader, offline_options, csv_path);
+
+	SourceMetrics metrics;
+	ASRGrpcClient client(host, port, nullptr);
+	client.SetMetrics(&metrics);
+	if (!client.TestConnection())
+		return 1;
+
+	std::mutex mutex;
+	std::vector<Arrival> replayed;
+	Clock::time_point start;
+	Clock::time_point last_result;
+	client.SetResultHandler([&](const std::string &text) {
+		std::lock_guard<std::mutex> lock(mutex);
+		last_result = Clock::now();
+		replayed.push_back({std::chrono::duration<double>(last_result - start).count(), text});
+		return text;
+	});
+	client.Start();
+
+	std::vector<Arrival> captured;
+	session_capture::Record record;
+	std::vector<char> chunk;
+	size_t chunks = 0;
+	double audio_seconds = 0;
+	double first_audio = -1;
+	start = Clock::now();
+	while (reader.next(record)) {
+		const double t = record.time_us / 1e6;
+		if (record.type == session_capture::RecordType::Result) {
+			captured.push_back({t - std::max(first_audio, 0.0), record.data});
+			continue;
+		}
+		if (first_audio < 0)
+			first_audio = t;
+		if (!max_speed)
+			std::this_thread::sleep_until(start + std::chrono::duration_cast<Clock::duration>(
+							      std::chrono::duration<double>(t - first_audio)));
+		chunk.assign(record.data.begin(), record.data.end());
+		client.SendChunk(chunk);
+		++chunks;
+		audio_seconds += static_cast<double>(chunk.size()) / sizeof(float) / reader.sampleRate();
+	}
+	const double send_seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+	// Results for the last chunks trail the audio; stop after two quiet seconds
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		last_result = std::max(last_result, Clock::now());
+		while (Clock::now() - last_result < std::chrono::seconds(2)) {
+			lock.unlock();
+			std::this_thread::sleep_for(std::chrono::milliseconds(100));
+			lock.lock();
+		}
+	}
+	client.Stop();
+
+	std::lock_guard<std::mutex> lock(mutex);
+	printf("audio      %.1f s in %zu chunks, sent in %.1f s (%.1fx real time)\n", audio_seconds, chunks,
+	       send_seconds, send_seconds > 0 ? audio_seconds / send_seconds : 0.0);
+	printf("results    captured %zu, replayed %zu\n", captured.size(), replayed.size());
+	printf("transport  %s\n", metrics.streaming_asr.summary("StreamingASR").c_str());
+	printf("           Write() p50 %.2f ms, p99 %.2f ms; Read() p50 %.1f ms, p99 %.1f ms\n",
+	       metrics.write.snapshot().percentileMs(0.5), metrics.write.snapshot().percentileMs(0.99),
+	       metrics.read.snapshot().percentileMs(0.5), metrics.read.snapshot().percentileMs(0.99));
+
+	// Pair results in order; with identical text the server behaved the same
+	const size_t pairs = std::min(captured.size(), replayed.size());
+	std::vector<double> shifts;
+	size_t same_text = 0;
+	for (size_t i = 0; i < pairs; ++i) {
+		shifts.push_back(replayed[i].seconds - captured[i].seconds);
+		same_text += replayed[i].text == captured[i].text;
+	}
+	if (pairs > 0) {
+		printf("text       %zu of %zu paired results identical\n", same_text, pairs);
+		if (!max_speed) {
+			std::vector<double> sorted = shifts;
+			std::sort(sorted.begin(), sorted.end());
+			printf("arrival    replay - capture: p50 %+.0f ms, p90 %+.0f ms, max %+.0f ms\n",
+			       sorted[pairs / 2] * 1e3, sorted[pairs * 9 / 10] * 1e3, sorted.back() * 1e3);
+		}
+	}
+
+	if (csv_path) {
+		FILE *csv = fopen(csv_path, "w");
+		if (!csv) {
+			fprintf(stderr, "cannot write %s\n", csv_path);
+			return 1;
+		}
+		fprintf(csv, "index,captured_s,replayed_s,same_text\n");
+		for (size_t i = 0; i < pairs; ++i)
+			fprintf(csv, "%zu,%.3f,%.3f,%d\n", i, captured[i].seconds, replayed[i].seconds,
+				replayed[i].text == captured[i].text);
+		fclose(csv);
+	}
+	return 0;
+}